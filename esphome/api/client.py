@@ -11,8 +11,9 @@ from google.protobuf import message  # noqa
 
 from esphome import const
 import esphome.api.api_pb2 as pb
-from esphome.const import CONF_PASSWORD, CONF_PORT
-from esphome.core import EsphomeError
+from esphome.api.log_format import LogFormatTable, TABLE_FILENAME
+from esphome.const import CONF_COMPACT_LOGS, CONF_PASSWORD, CONF_PORT
+from esphome.core import CORE, EsphomeError
 from esphome.helpers import resolve_ip_address, indent, color
 from esphome.util import safe_print
 
@@ -61,6 +62,7 @@ MESSAGE_TYPE_TO_PROTO = {
     35: pb.ServiceCallResponse,
     36: pb.GetTimeRequest,
     37: pb.GetTimeResponse,
+    51: pb.SubscribeLogsCompactResponse,
 }
 
 
@@ -322,16 +324,24 @@ class APIClient(threading.Thread):
         if not self._authenticated:
             raise APIConnectionError("Must login first!")
 
-    def subscribe_logs(self, on_log, log_level=7, dump_config=False):
+    def subscribe_logs(self, on_log, log_level=7, dump_config=False, format_table=None):
+        """Subscribe to the log messages of the device.
+
+        If format_table (a LogFormatTable) is given, the device is asked to send messages in compact form,
+        on_log then receives both SubscribeLogsResponse and SubscribeLogsCompactResponse messages.
+        """
         self._check_authenticated()
 
         def on_msg(msg):
-            if isinstance(msg, pb.SubscribeLogsResponse):
+            if isinstance(msg, (pb.SubscribeLogsResponse, pb.SubscribeLogsCompactResponse)):
                 on_log(msg)
 
         self._message_handlers.append(on_msg)
         req = pb.SubscribeLogsRequest(dump_config=dump_config)
         req.level = log_level
+        if format_table is not None:
+            req.compact = True
+            req.format_table_hash = format_table.table_hash
         self._send_message(req)
 
     def _recv(self, amount):
@@ -414,12 +424,40 @@ class APIClient(threading.Thread):
             self._send_message(resp)
 
 
+# Indexed by the device log level (ESPHOME_LOG_LEVEL_*), see logger.cpp
+LOG_LEVEL_COLORS = [
+    '',  # NONE
+    '\033[1;31m',  # ERROR
+    '\033[0;33m',  # WARNING
+    '\033[0;32m',  # INFO
+    '\033[0;35m',  # CONFIG
+    '\033[0;36m',  # DEBUG
+    '\033[0;37m',  # VERBOSE
+    '\033[0;38m',  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ['', 'E', 'W', 'I', 'C', 'D', 'V', 'VV']
+
+
+def format_compact_log(msg, format_table):
+    """Format a SubscribeLogsCompactResponse like the device formats its log messages."""
+    level = msg.level if msg.level < len(LOG_LEVEL_LETTERS) else 0
+    return '{}[{}][{}:{:03}]: {}\033[0m'.format(
+        LOG_LEVEL_COLORS[level], LOG_LEVEL_LETTERS[level], msg.tag, msg.line,
+        format_table.decode(msg.format_id, msg.args))
+
+
 def run_logs(config, address):
     conf = config['api']
     port = conf[CONF_PORT]
     password = conf[CONF_PASSWORD]
     _LOGGER.info("Starting log output from %s using esphome API", address)
 
+    format_table = None
+    if conf.get(CONF_COMPACT_LOGS, False):
+        format_table = LogFormatTable.load(CORE.relative_build_path(TABLE_FILENAME))
+        if format_table is None:
+            _LOGGER.warning("No log format table found, compile the firmware first to receive compact logs")
+
     cli = APIClient(address, port, password)
     stopping = False
     retry_timer = []
@@ -461,15 +499,19 @@ def run_logs(config, address):
 
     def on_log(msg):
         time_ = datetime.now().time().strftime('[%H:%M:%S]')
-        text = msg.message
         if msg.send_failed:
-            text = color('white', '(Message skipped because it was too big to fit in '
-                                  'TCP buffer - This is only cosmetic)')
-        safe_print(time_ + text)
+            safe_print(time_ + color('white', '(Message skipped because it was too big to fit in '
+                                              'TCP buffer - This is only cosmetic)'))
+        if isinstance(msg, pb.SubscribeLogsCompactResponse):
+            text = format_compact_log(msg, format_table)
+        else:
+            text = msg.message
+        if text:
+            safe_print(time_ + text)
 
     def on_login():
         try:
-            cli.subscribe_logs(on_log, dump_config=not has_connects)
+            cli.subscribe_logs(on_log, dump_config=not has_connects, format_table=format_table)
             has_connects.append(True)
         except APIConnectionError:
             cli.disconnect()
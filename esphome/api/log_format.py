@@ -0,0 +1,230 @@
+"""Compact API log transport.
+
+With `api: compact_logs: true` the format strings of all ESP_LOGx() call sites are collected at build time
+into a table. Log messages whose format string is in the table are then sent to API log subscribers as the
+index into that table and the printf arguments as packed by the asynchronous logger, this module turns them
+back into text.
+"""
+import json
+import logging
+import re
+import struct
+
+from esphome.helpers import write_file_if_changed
+
+_LOGGER = logging.getLogger(__name__)
+
+# Written to the build directory
+TABLE_FILENAME = 'log_formats.json'
+
+# ESP_LOGx(tag, "format" "literals", ...) where the format consists only of string literals
+LOG_CALL_RE = re.compile(
+    r'\bESP_LOG(?:E|W|I|D|CONFIG|V|VV)\s*\(\s*[^,()]+?\s*,\s*'
+    r'((?:"(?:[^"\\\n]|\\.)*"\s*(?:\\\n\s*)?)+)(?=[,)])'
+)
+STRING_LITERAL_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+ESCAPE_RE = re.compile(r'\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)')
+SIMPLE_ESCAPES = {
+    'n': '\n', 't': '\t', 'r': '\r', 'a': '\a', 'b': '\b', 'f': '\f', 'v': '\v',
+    '\\': '\\', '"': '"', "'": "'", '?': '?',
+}
+
+
+def _unescape_c(literal):
+    def repl(match):
+        esc = match.group(1)
+        if esc[0] == 'x':
+            return chr(int(esc[1:], 16) & 0xFF)
+        if esc[0] in '01234567':
+            return chr(int(esc, 8) & 0xFF)
+        return SIMPLE_ESCAPES.get(esc, esc)
+
+    return ESCAPE_RE.sub(repl, literal)
+
+
+def extract_log_formats(text):
+    """Find the format strings of all ESP_LOGx() calls in the C++ source text.
+
+    The text must be the source bytes decoded as latin1 so that each character is a byte, the formats
+    are returned the same way.
+    """
+    formats = set()
+    for match in LOG_CALL_RE.finditer(text):
+        literals = STRING_LITERAL_RE.findall(match.group(1))
+        formats.add(''.join(_unescape_c(lit) for lit in literals))
+    return formats
+
+
+def fnv1_hash(data):
+    """32-bit FNV-1 hash, the same as LogFormatTable::hash() computes on the device."""
+    hash_ = 2166136261
+    for byte in data:
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= byte
+    return hash_
+
+
+def _encode(format_):
+    return format_.encode('latin1')
+
+
+class LogFormatTable:
+    """The formats ordered by their hash, the index of a format is its ID on the wire."""
+
+    def __init__(self, formats):
+        by_hash = {}
+        collisions = set()
+        for format_ in sorted(formats):
+            hash_ = fnv1_hash(_encode(format_))
+            if hash_ in by_hash:
+                collisions.add(hash_)
+            by_hash[hash_] = format_
+        # The device only knows the hashes, leave colliding formats out so that they are sent as text
+        for hash_ in collisions:
+            _LOGGER.debug("Log format hash collision 0x%08X, sending these formats as text", hash_)
+            del by_hash[hash_]
+        self.hashes = sorted(by_hash)
+        self.formats = [by_hash[h] for h in self.hashes]
+        self.table_hash = fnv1_hash(b'\0'.join(_encode(f) for f in self.formats))
+
+    def save(self, path):
+        write_file_if_changed(path, json.dumps({
+            'table_hash': self.table_hash,
+            'formats': self.formats,
+        }, indent=2))
+
+    @staticmethod
+    def load(path):
+        try:
+            with open(path, encoding='utf-8') as f:
+                data = json.load(f)
+        except (OSError, ValueError) as err:
+            _LOGGER.debug("Could not load log format table %s: %s", path, err)
+            return None
+        table = LogFormatTable(data['formats'])
+        if table.table_hash != data['table_hash']:
+            _LOGGER.warning("Log format table %s is corrupt, ignoring it", path)
+            return None
+        return table
+
+    def decode(self, format_id, args):
+        if format_id >= len(self.formats):
+            return f'<unknown log format {format_id}>'
+        format_ = self.formats[format_id].encode('latin1').decode('utf-8', 'backslashreplace')
+        return format_packed(format_, args)
+
+
+# Sizes of the packed arguments on the (32-bit) devices, see AsyncLogBuffer::pack_args_()
+INT_SIZE = 4
+LONG_SIZE = 4
+LONG_LONG_SIZE = 8
+POINTER_SIZE = 4
+
+CONVERSION_RE = re.compile(
+    r'%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?'
+    r'(?P<length>hh|h|ll|l|z|t|j|L)?(?P<conv>[diuoxXcfFeEgGaAspn%])'
+)
+
+
+class _ArgReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def integer(self, size, signed):
+        if self.pos + size > len(self.data):
+            raise IndexError
+        value = int.from_bytes(self.data[self.pos:self.pos + size], 'little', signed=signed)
+        self.pos += size
+        return value
+
+    def double(self):
+        value, = struct.unpack_from('<d', self.data, self.pos)
+        self.pos += 8
+        return value
+
+    def string(self):
+        end = self.data.find(b'\0', self.pos)
+        if end == -1:
+            raise IndexError
+        value = self.data[self.pos:end].decode('utf-8', 'backslashreplace')
+        self.pos = end + 1
+        return value
+
+
+def format_packed(format_, args):
+    """Format the packed printf arguments like the device would have formatted them."""
+    reader = _ArgReader(args)
+    out = []
+    pos = 0
+    try:
+        while True:
+            start = format_.find('%', pos)
+            if start == -1:
+                out.append(format_[pos:])
+                break
+            out.append(format_[pos:start])
+            match = CONVERSION_RE.match(format_, start)
+            if match is None or _is_unsupported(match):
+                # not packed by the device either, output everything after it verbatim
+                out.append(format_[start:])
+                break
+            pos = match.end()
+            out.append(_format_conversion(match, reader))
+    except (IndexError, struct.error):
+        out.append('<truncated>')
+    return ''.join(out)
+
+
+def _is_unsupported(match):
+    length = match.group('length')
+    if length == 'L':
+        return True
+    return length in ('l', 'll', 'z', 't', 'j') and match.group('conv') in 'sc'
+
+
+def _format_conversion(match, reader):
+    conv = match.group('conv')
+    if conv == '%':
+        return '%'
+    flags = match.group('flags')
+    width = match.group('width') or ''
+    precision = match.group('precision')
+    length = match.group('length') or ''
+    if width == '*':
+        width = reader.integer(INT_SIZE, True)
+        if width < 0:
+            flags += '-'
+            width = -width
+        width = str(width)
+    if precision == '*':
+        precision = reader.integer(INT_SIZE, True)
+        precision = None if precision < 0 else str(precision)
+    spec = '%' + flags + width + ('' if precision is None else '.' + precision)
+
+    if conv in 'diuoxXc':
+        size = {'': INT_SIZE, 'hh': INT_SIZE, 'h': INT_SIZE, 'l': LONG_SIZE, 'z': LONG_SIZE, 't': LONG_SIZE,
+                'll': LONG_LONG_SIZE, 'j': LONG_LONG_SIZE}[length]
+        signed = conv in 'di'
+        value = reader.integer(size, signed)
+        bits = {'hh': 8, 'h': 16}.get(length)
+        if bits is not None:
+            value &= (1 << bits) - 1
+            if signed and value >= 1 << (bits - 1):
+                value -= 1 << bits
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'u':
+            conv = 'd'
+        return (spec + conv) % value
+    if conv in 'fFeEgGaA':
+        value = reader.double()
+        if conv in 'aA':
+            return value.hex()
+        return (spec + conv) % value
+    if conv == 's':
+        return (spec + 's') % reader.string()
+    if conv == 'p':
+        return '0x{:x}'.format(reader.integer(POINTER_SIZE, False))
+    # %n writes nothing and its argument is not packed
+    return ''
@@ -1,10 +1,14 @@
+import os
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
+from esphome.api.log_format import LogFormatTable, TABLE_FILENAME, extract_log_formats
 from esphome.automation import Condition
-from esphome.const import CONF_DATA, CONF_DATA_TEMPLATE, CONF_ID, CONF_PASSWORD, CONF_PORT, \
-    CONF_REBOOT_TIMEOUT, CONF_SERVICE, CONF_VARIABLES, CONF_SERVICES, CONF_TRIGGER_ID, CONF_EVENT
-from esphome.core import coroutine_with_priority
+from esphome.const import CONF_BATCH_DELAY, CONF_COMPACT_LOGS, CONF_DATA, CONF_DATA_TEMPLATE, CONF_ID, \
+    CONF_PASSWORD, CONF_PORT, CONF_REBOOT_TIMEOUT, CONF_RX_BUFFER_SIZE, CONF_SERVICE, CONF_VARIABLES, \
+    CONF_SERVICES, CONF_TRIGGER_ID, CONF_EVENT, CONF_ESPHOME, CONF_INCLUDES, SOURCE_FILE_EXTENSIONS
+from esphome.core import CORE, ID, HexInt, coroutine_with_priority
 
 DEPENDENCIES = ['network']
 AUTO_LOAD = ['async_tcp']
@@ -28,11 +32,29 @@ SERVICE_ARG_NATIVE_TYPES = {
     'string[]': cg.std_vector.template(cg.std_string),
 }
 
+
+def validate_compact_logs(value):
+    value = cv.boolean(value)
+    if value:
+        logger_conf = CORE.raw_config.get('logger') or {}
+        try:
+            async_logger = cv.boolean(logger_conf.get('async', False))
+        except cv.Invalid:
+            async_logger = False
+        if not async_logger:
+            raise cv.Invalid("Compact logs are formatted from the asynchronous logger's records, "
+                             "please set 'async: true' in the logger configuration.")
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(APIServer),
     cv.Optional(CONF_PORT, default=6053): cv.port,
     cv.Optional(CONF_PASSWORD, default=''): cv.string_strict,
     cv.Optional(CONF_REBOOT_TIMEOUT, default='15min'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_RX_BUFFER_SIZE, default=2048): cv.All(cv.validate_bytes, cv.int_range(min=64)),
+    cv.Optional(CONF_BATCH_DELAY, default='0ms'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_COMPACT_LOGS, default=False): validate_compact_logs,
     cv.Optional(CONF_SERVICES): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
         cv.Required(CONF_SERVICE): cv.valid_name,
@@ -51,6 +73,8 @@ def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_rx_buffer_size(config[CONF_RX_BUFFER_SIZE]))
+    cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -67,10 +91,44 @@ def to_code(config):
         cg.add(var.register_user_service(trigger))
         yield automation.build_automation(trigger, func_args, conf)
 
+    if config[CONF_COMPACT_LOGS]:
+        cg.add_define('USE_API_COMPACT_LOGS')
+        CORE.add_job(add_log_format_table, var)
+
     cg.add_define('USE_API')
     cg.add_global(api_ns.using)
 
 
+def _read_source(path):
+    # latin1 so that every character is one byte of the source, see extract_log_formats()
+    with open(path, 'rb') as f:
+        return f.read().decode('latin1')
+
+
+@coroutine_with_priority(-1000.0)
+def add_log_format_table(var):
+    # Run at the very end so that the code of all lambdas has been generated
+    from esphome.config import iter_components
+
+    formats = set()
+    for _, component, _ in iter_components(CORE.config):
+        for path in component.source_files.values():
+            if os.path.splitext(path)[1] in SOURCE_FILE_EXTENSIONS:
+                formats |= extract_log_formats(_read_source(path))
+    for include in CORE.config[CONF_ESPHOME].get(CONF_INCLUDES, []):
+        path = CORE.relative_config_path(include)
+        if os.path.splitext(path)[1] in SOURCE_FILE_EXTENSIONS:
+            formats |= extract_log_formats(_read_source(path))
+    generated = CORE.cpp_global_section + CORE.cpp_main_section
+    formats |= extract_log_formats(generated.encode('utf-8').decode('latin1'))
+
+    table = LogFormatTable(formats)
+    table.save(CORE.relative_build_path(TABLE_FILENAME))
+    table_id = ID('api_log_format_table', is_declaration=True, type=cg.uint32)
+    arr = cg.progmem_array(table_id, [HexInt(x) for x in table.hashes])
+    cg.add(var.set_log_format_table(arr, len(table.hashes), HexInt(table.table_hash)))
+
+
 KEY_VALUE_SCHEMA = cv.Schema({cv.string: cv.templatable(cv.string_strict)})
 
 HOMEASSISTANT_SERVICE_ACTION_SCHEMA = cv.Schema({
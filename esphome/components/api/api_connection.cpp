@@ -15,6 +15,11 @@ namespace api {
 
 static const char *TAG = "api.connection";
 
+/// recv_buffer_ grows up to this size (or rx_buffer_size if that is larger) for messages that do not fit.
+static const size_t API_MAX_RX_BUFFER_SIZE = 16384;
+/// Send a ping after this many ms without traffic, disconnect if there is no response within 2.5 times as long.
+static const uint32_t API_KEEPALIVE = 60000;
+
 APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
     : client_(client), parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
   this->client_->onError([](void *s, AsyncClient *c, int8_t error) { ((APIConnection *) s)->on_error_(error); }, this);
@@ -26,57 +31,125 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
                         this);
 
   this->send_buffer_.reserve(64);
-  this->recv_buffer_.reserve(32);
+  this->recv_buffer_.init(parent->get_rx_buffer_size());
+#ifdef ARDUINO_ARCH_ESP32
+  this->recv_lock_ = xSemaphoreCreateMutex();
+#endif
   this->client_info_ = this->client_->remoteIP().toString().c_str();
   this->last_traffic_ = millis();
 }
-APIConnection::~APIConnection() { delete this->client_; }
-void APIConnection::on_error_(int8_t error) { this->remove_ = true; }
-void APIConnection::on_disconnect_() { this->remove_ = true; }
-void APIConnection::on_timeout_(uint32_t time) { this->on_fatal_error(); }
+APIConnection::~APIConnection() {
+  delete this->client_;
+#ifdef ARDUINO_ARCH_ESP32
+  vSemaphoreDelete(this->recv_lock_);
+#endif
+}
+void APIConnection::on_error_(int8_t error) {
+  this->remove_ = true;
+  this->parent_->enable_loop();
+}
+void APIConnection::on_disconnect_() {
+  this->remove_ = true;
+  this->parent_->enable_loop();
+}
+void APIConnection::on_timeout_(uint32_t time) {
+  this->on_fatal_error();
+  this->parent_->enable_loop();
+}
 void APIConnection::on_data_(uint8_t *buf, size_t len) {
   if (len == 0 || buf == nullptr)
     return;
-  this->recv_buffer_.insert(this->recv_buffer_.end(), buf, buf + len);
+  // Called from the TCP stack. Data must stay in order, so once something is in the backlog everything goes there
+  this->lock_recv_();
+  if (!this->recv_backlog_.empty() || !this->recv_buffer_.write(buf, len)) {
+    this->recv_backlog_.insert(this->recv_backlog_.end(), buf, buf + len);
+    // Keep the receive window closed until loop() has room for the data
+    this->client_->ackLater();
+  }
+  this->unlock_recv_();
+  this->parent_->enable_loop();
+}
+void APIConnection::drain_recv_backlog_() {
+  this->lock_recv_();
+  const size_t len = std::min(this->recv_backlog_.size(), this->recv_buffer_.space());
+  if (len != 0) {
+    this->recv_buffer_.write(this->recv_backlog_.data(), len);
+    this->recv_backlog_.erase(this->recv_backlog_.begin(), this->recv_backlog_.begin() + len);
+    this->client_->ack(len);
+  }
+  this->unlock_recv_();
+}
+void APIConnection::lock_recv_() {
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreTake(this->recv_lock_, portMAX_DELAY);
+#endif
+}
+void APIConnection::unlock_recv_() {
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreGive(this->recv_lock_);
+#endif
 }
 void APIConnection::parse_recv_buffer_() {
-  if (this->recv_buffer_.empty() || this->remove_)
+  if (this->remove_)
     return;
 
-  while (!this->recv_buffer_.empty()) {
-    if (this->recv_buffer_[0] != 0x00) {
+  while (true) {
+    this->drain_recv_backlog_();
+    const uint32_t size = this->recv_buffer_.available();
+    if (size == 0)
+      return;
+    // preamble + message size varint + message type varint
+    uint8_t header[11];
+    const uint32_t header_size = this->recv_buffer_.peek(0, header, sizeof(header));
+    if (header[0] != 0x00) {
       ESP_LOGW(TAG, "Invalid preamble from %s", this->client_info_.c_str());
       this->on_fatal_error();
       return;
     }
     uint32_t i = 1;
-    const uint32_t size = this->recv_buffer_.size();
     uint32_t consumed;
-    auto msg_size_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
+    auto msg_size_varint = ProtoVarInt::parse(&header[i], header_size - i, &consumed);
     if (!msg_size_varint.has_value())
       // not enough data there yet
       return;
     i += consumed;
     uint32_t msg_size = msg_size_varint->as_uint32();
 
-    auto msg_type_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
+    auto msg_type_varint = ProtoVarInt::parse(&header[i], header_size - i, &consumed);
     if (!msg_type_varint.has_value())
       // not enough data there yet
       return;
     i += consumed;
     uint32_t msg_type = msg_type_varint->as_uint32();
 
+    if (msg_size > this->recv_buffer_.capacity() - i) {
+      const size_t max_size = std::max(API_MAX_RX_BUFFER_SIZE, this->parent_->get_rx_buffer_size());
+      if (msg_size > max_size - i) {
+        ESP_LOGW(TAG, "Message of %u bytes from %s is too large", msg_size, this->client_info_.c_str());
+        this->on_fatal_error();
+        return;
+      }
+      ESP_LOGD(TAG, "Growing receive buffer of %s for a message of %u bytes", this->client_info_.c_str(), msg_size);
+      this->lock_recv_();
+      this->recv_buffer_.grow(i + msg_size);
+      this->unlock_recv_();
+      continue;
+    }
     if (size - i < msg_size)
       // message body not fully received
       return;
 
-    uint8_t *msg = &this->recv_buffer_[i];
+    // Decode in place, only messages that wrap around the end of the ring buffer need to be copied
+    uint8_t *msg = this->recv_buffer_.contiguous(i, msg_size);
+    if (msg == nullptr) {
+      this->recv_wrap_buffer_.resize(msg_size);
+      this->recv_buffer_.peek(i, this->recv_wrap_buffer_.data(), msg_size);
+      msg = this->recv_wrap_buffer_.data();
+    }
     this->read_message(msg_size, msg_type, msg);
     if (this->remove_)
       return;
-    // pop front
-    uint32_t total = i + msg_size;
-    this->recv_buffer_.erase(this->recv_buffer_.begin(), this->recv_buffer_.begin() + total);
+    this->recv_buffer_.consume(i + msg_size);
     this->last_traffic_ = millis();
   }
 }
@@ -111,14 +184,19 @@ void APIConnection::loop() {
   this->list_entities_iterator_.advance();
   this->initial_state_iterator_.advance();
 
-  const uint32_t keepalive = 60000;
+  if (!this->batched_states_.empty() && millis() - this->batch_start_ >= this->parent_->get_batch_delay())
+    this->flush_batch_();
+#ifdef USE_COMPONENT_PROFILER
+  this->advance_component_timings_();
+#endif
+
   if (this->sent_ping_) {
     // Disconnect if not responded within 2.5*keepalive
-    if (millis() - this->last_traffic_ > (keepalive * 5) / 2) {
+    if (millis() - this->last_traffic_ > (API_KEEPALIVE * 5) / 2) {
       ESP_LOGW(TAG, "'%s' didn't respond to ping request in time. Disconnecting...", this->client_info_.c_str());
       this->disconnect_client();
     }
-  } else if (millis() - this->last_traffic_ > keepalive) {
+  } else if (millis() - this->last_traffic_ > API_KEEPALIVE) {
     this->sent_ping_ = true;
     this->send_ping_request(PingRequest());
   }
@@ -150,6 +228,28 @@ void APIConnection::loop() {
 #endif
 }
 
+bool APIConnection::is_idle() const {
+  if (this->remove_ || this->next_close_ || !this->batched_states_.empty())
+    return false;
+  if (this->list_entities_iterator_.is_running() || this->initial_state_iterator_.is_running())
+    return false;
+  // loop() parses every complete message, the rest of a partial one is signalled by on_data_()
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return false;
+#endif
+#ifdef USE_COMPONENT_PROFILER
+  if (this->component_timings_index_ >= 0)
+    return false;
+#endif
+  return true;
+}
+uint32_t APIConnection::next_keepalive_in(uint32_t now) const {
+  const uint32_t timeout = this->sent_ping_ ? (API_KEEPALIVE * 5) / 2 : API_KEEPALIVE;
+  const uint32_t elapsed = now - this->last_traffic_;
+  return elapsed < timeout ? timeout - elapsed : 0;
+}
+
 std::string get_default_unique_id(const std::string &component_type, Nameable *nameable) {
   return App.get_name() + component_type + nameable->get_object_id();
 }
@@ -158,7 +258,6 @@ std::string get_default_unique_id(const std::string &component_type, Nameable *n
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
-
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
@@ -181,6 +280,8 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::COVER, cover))
+    return true;
 
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
@@ -239,6 +340,8 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::FanState *fan) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::FAN, fan))
+    return true;
 
   auto traits = fan->get_traits();
   FanStateResponse resp{};
@@ -286,6 +389,8 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::LIGHT, light))
+    return true;
 
   auto traits = light->get_traits();
   auto values = light->remote_values;
@@ -363,6 +468,8 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::SENSOR, sensor))
+    return true;
 
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
@@ -390,7 +497,6 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
-
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
@@ -422,6 +528,8 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::TEXT_SENSOR, text_sensor))
+    return true;
 
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
@@ -446,6 +554,8 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
+  if (this->batch_state_(BatchedStateType::CLIMATE, climate))
+    return true;
 
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
@@ -531,6 +641,7 @@ void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage>
   if (this->image_reader_.available())
     return;
   this->image_reader_.set_image(image);
+  this->parent_->enable_loop();
 }
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   ListEntitiesCameraResponse msg;
@@ -551,6 +662,55 @@ void APIConnection::camera_image(const CameraImageRequest &msg) {
 }
 #endif
 
+#ifdef USE_COMPONENT_PROFILER
+static void fill_component_timing_stats(ComponentTimingStats &stats, const TimingHistogram &histogram) {
+  stats.count = histogram.get_count();
+  stats.min_us = histogram.get_min();
+  stats.mean_us = histogram.get_mean();
+  stats.max_us = histogram.get_max();
+  stats.p99_us = histogram.get_percentile(99.0f);
+  stats.buckets.reserve(TimingHistogram::BUCKET_COUNT);
+  for (uint8_t i = 0; i < TimingHistogram::BUCKET_COUNT; i++)
+    stats.buckets.push_back(histogram.get_bucket(i));
+}
+void APIConnection::component_timings(const ComponentTimingsRequest &msg) {
+  this->component_timings_index_ = 0;
+  this->component_timings_reset_ = msg.reset;
+}
+void APIConnection::advance_component_timings_() {
+  // Send one component per loop() iteration so that a large config doesn't block the loop or overflow the TCP buffer
+  if (this->component_timings_index_ < 0)
+    return;
+
+  const auto &components = App.get_components();
+  ComponentTimingResponse resp;
+  if (uint32_t(this->component_timings_index_) < components.size()) {
+    Component *component = components[this->component_timings_index_];
+    resp.source = component->get_component_source();
+    fill_component_timing_stats(resp.loop, component->get_loop_timing());
+    fill_component_timing_stats(resp.scheduler, component->get_scheduler_timing());
+    if (!this->send_component_timing_response(resp))
+      // try again in the next loop() iteration
+      return;
+    if (this->component_timings_reset_) {
+      component->get_loop_timing().reset();
+      component->get_scheduler_timing().reset();
+    }
+    this->component_timings_index_++;
+    return;
+  }
+
+  resp.source = "app";
+  fill_component_timing_stats(resp.loop, App.get_loop_timing());
+  resp.done = true;
+  if (!this->send_component_timing_response(resp))
+    return;
+  if (this->component_timings_reset_)
+    App.get_loop_timing().reset();
+  this->component_timings_index_ = -1;
+}
+#endif
+
 #ifdef USE_HOMEASSISTANT_TIME
 void APIConnection::on_get_time_response(const GetTimeResponse &value) {
   if (homeassistant::global_homeassistant_time != nullptr)
@@ -558,10 +718,27 @@ void APIConnection::on_get_time_response(const GetTimeResponse &value) {
 }
 #endif
 
+void APIConnection::subscribe_logs(const SubscribeLogsRequest &msg) {
+  this->log_subscription_ = msg.level;
+#ifdef USE_API_COMPACT_LOGS
+  this->log_compact_ = msg.compact && msg.format_table_hash == this->parent_->get_log_format_table().get_table_hash();
+  if (msg.compact && !this->log_compact_)
+    ESP_LOGW(TAG, "%s: Log format table doesn't match, sending logs as text", this->client_info_.c_str());
+#endif
+  if (msg.dump_config)
+    App.schedule_dump_config();
+}
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
-
+#ifdef USE_API_COMPACT_LOGS
+  // sent by send_log_record()
+  if (this->log_compact_)
+    return false;
+#endif
+  return this->send_log_text_(level, line);
+}
+bool APIConnection::send_log_text_(int level, const char *line) {
   // Send raw so that we don't copy too much
   auto buffer = this->create_buffer();
   // LogLevel level = 1;
@@ -570,17 +747,41 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
   // buffer.encode_string(2, tag, strlen(tag));
   // string message = 3;
   buffer.encode_string(3, line, strlen(line));
+  // bool send_failed = 4;
+  buffer.encode_bool(4, this->log_send_failed_);
   // SubscribeLogsResponse - 29
-  bool success = this->send_buffer(buffer, 29);
-  if (!success) {
-    buffer = this->create_buffer();
-    // bool send_failed = 4;
-    buffer.encode_bool(4, true);
-    return this->send_buffer(buffer, 29);
-  } else {
-    return true;
+  this->log_send_failed_ = !this->send_buffer(buffer, 29);
+  return !this->log_send_failed_;
+}
+#ifdef USE_API_COMPACT_LOGS
+bool APIConnection::send_log_record(const logger::AsyncLogRecord &record, const char *line) {
+  if (!this->log_compact_ || this->log_subscription_ < record.level)
+    return false;
+
+  int32_t format_id = this->parent_->get_log_format_table().lookup(record.format, record.format_in_flash);
+  if (format_id < 0) {
+    // not known at build time, send the formatted text
+    return this->send_log_text_(record.level, line);
   }
+
+  auto buffer = this->create_buffer();
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, record.level);
+  // uint32 format_id = 2;
+  buffer.encode_uint32(2, format_id, true);
+  // string tag = 3;
+  buffer.encode_string(3, record.tag, strlen(record.tag));
+  // uint32 line = 4;
+  buffer.encode_uint32(4, record.line);
+  // bytes args = 5;
+  buffer.encode_bytes(5, record.args(), record.args_size);
+  // bool send_failed = 6;
+  buffer.encode_bool(6, this->log_send_failed_);
+  // SubscribeLogsCompactResponse - 51
+  this->log_send_failed_ = !this->send_buffer(buffer, 51);
+  return !this->log_send_failed_;
 }
+#endif
 
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info + " (" + this->client_->remoteIP().toString().c_str();
@@ -657,16 +858,19 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   if (this->remove_)
     return false;
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(buffer.get_buffer()->size()).encode(header);
-  ProtoVarInt(message_type).encode(header);
-
-  size_t needed_space = buffer.get_buffer()->size() + header.size();
+  // Frame the message behind any messages of the batch that is currently being flushed
+  const size_t begin = this->frame_buffer_.size();
+  const std::vector<uint8_t> *body = buffer.get_buffer();
+  this->frame_buffer_.push_back(0x00);
+  ProtoVarInt(body->size()).encode(this->frame_buffer_);
+  ProtoVarInt(message_type).encode(this->frame_buffer_);
+  this->frame_buffer_.insert(this->frame_buffer_.end(), body->begin(), body->end());
 
-  if (needed_space > this->client_->space()) {
+  if (this->frame_buffer_.size() > this->client_->space()) {
     delay(0);
-    if (needed_space > this->client_->space()) {
+    if (this->frame_buffer_.size() > this->client_->space()) {
+      // Drop the frame before logging, the log message might be sent to this client too
+      this->frame_buffer_.resize(begin);
       // SubscribeLogsResponse
       if (message_type != 29) {
         ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
@@ -676,10 +880,78 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  this->client_->add(reinterpret_cast<char *>(header.data()), header.size());
-  this->client_->add(reinterpret_cast<char *>(buffer.get_buffer()->data()), buffer.get_buffer()->size());
-  bool ret = this->client_->send();
-  return ret;
+  if (this->flushing_batch_)
+    // sent by flush_batch_()
+    return true;
+  return this->send_frames_();
+}
+bool APIConnection::send_frames_() {
+  this->client_->add(reinterpret_cast<char *>(this->frame_buffer_.data()), this->frame_buffer_.size());
+  this->frame_buffer_.clear();
+  return this->client_->send();
+}
+bool APIConnection::batch_state_(BatchedStateType type, Nameable *entity) {
+  if (this->flushing_batch_ || this->parent_->get_batch_delay() == 0)
+    return false;
+
+  for (auto &state : this->batched_states_) {
+    // Superseded by this update, the current state is read when the batch is sent
+    if (state.entity == entity)
+      return true;
+  }
+  if (this->batched_states_.empty()) {
+    this->batch_start_ = millis();
+    this->parent_->enable_loop();
+  }
+  this->batched_states_.push_back(BatchedState{type, entity});
+  return true;
+}
+void APIConnection::flush_batch_() {
+  this->flushing_batch_ = true;
+  size_t sent = 0;
+  while (sent < this->batched_states_.size() && this->send_batched_state_(this->batched_states_[sent]))
+    sent++;
+  this->flushing_batch_ = false;
+
+  if (!this->frame_buffer_.empty())
+    this->send_frames_();
+  // Whatever didn't fit in the TCP buffer is retried in the next loop() iteration
+  this->batched_states_.erase(this->batched_states_.begin(), this->batched_states_.begin() + sent);
+}
+bool APIConnection::send_batched_state_(const BatchedState &state) {
+  switch (state.type) {
+#ifdef USE_COVER
+    case BatchedStateType::COVER:
+      return this->send_cover_state(static_cast<cover::Cover *>(state.entity));
+#endif
+#ifdef USE_FAN
+    case BatchedStateType::FAN:
+      return this->send_fan_state(static_cast<fan::FanState *>(state.entity));
+#endif
+#ifdef USE_LIGHT
+    case BatchedStateType::LIGHT:
+      return this->send_light_state(static_cast<light::LightState *>(state.entity));
+#endif
+#ifdef USE_SENSOR
+    case BatchedStateType::SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(state.entity);
+      return this->send_sensor_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case BatchedStateType::TEXT_SENSOR: {
+      auto *obj = static_cast<text_sensor::TextSensor *>(state.entity);
+      return this->send_text_sensor_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_CLIMATE
+    case BatchedStateType::CLIMATE:
+      return this->send_climate_state(static_cast<climate::Climate *>(state.entity));
+#endif
+    default:
+      // entity type not compiled in, drop it
+      return true;
+  }
 }
 void APIConnection::on_unauthenticated_access() {
   ESP_LOGD(TAG, "'%s' tried to access without authentication.", this->client_info_.c_str());
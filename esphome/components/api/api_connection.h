@@ -5,6 +5,11 @@
 #include "api_pb2.h"
 #include "api_pb2_service.h"
 #include "api_server.h"
+#include "ring_buffer.h"
+
+#ifdef USE_API_COMPACT_LOGS
+#include "esphome/components/logger/async_log.h"
+#endif
 
 namespace esphome {
 namespace api {
@@ -16,6 +21,10 @@ class APIConnection : public APIServerConnection {
 
   void disconnect_client();
   void loop();
+  /// Whether loop() has nothing to do until data is received, a state is batched or the keepalive is due.
+  bool is_idle() const;
+  /// Time in ms until loop() has to check the keepalive of this connection.
+  uint32_t next_keepalive_in(uint32_t now) const;
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -62,8 +71,15 @@ class APIConnection : public APIServerConnection {
   bool send_climate_state(climate::Climate *climate);
   bool send_climate_info(climate::Climate *climate);
   void climate_command(const ClimateCommandRequest &msg) override;
+#endif
+#ifdef USE_COMPONENT_PROFILER
+  void component_timings(const ComponentTimingsRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+#ifdef USE_API_COMPACT_LOGS
+  /// Send an asynchronously processed log message, compact if the client requested it and the format is known.
+  bool send_log_record(const logger::AsyncLogRecord &record, const char *line);
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -103,11 +119,7 @@ class APIConnection : public APIServerConnection {
     this->state_subscription_ = true;
     this->initial_state_iterator_.begin();
   }
-  void subscribe_logs(const SubscribeLogsRequest &msg) override {
-    this->log_subscription_ = msg.level;
-    if (msg.dump_config)
-      App.schedule_dump_config();
-  }
+  void subscribe_logs(const SubscribeLogsRequest &msg) override;
   void subscribe_homeassistant_services(const SubscribeHomeassistantServicesRequest &msg) override {
     this->service_call_subscription_ = true;
   }
@@ -138,6 +150,38 @@ class APIConnection : public APIServerConnection {
   void on_timeout_(uint32_t time);
   void on_data_(uint8_t *buf, size_t len);
   void parse_recv_buffer_();
+  /// Move data from recv_backlog_ into recv_buffer_ as far as it fits and acknowledge it to the TCP stack.
+  void drain_recv_backlog_();
+  void lock_recv_();
+  void unlock_recv_();
+  bool send_log_text_(int level, const char *line);
+#ifdef USE_COMPONENT_PROFILER
+  void advance_component_timings_();
+#endif
+
+  /** Entity types whose state updates are batched.
+   *
+   * Only the latest state of an entity is sent per batch. Binary sensors and switches are never batched, a short
+   * ON/OFF pulse (e.g. a button press) would otherwise not be reported at all.
+   */
+  enum class BatchedStateType : uint8_t {
+    COVER,
+    FAN,
+    LIGHT,
+    SENSOR,
+    TEXT_SENSOR,
+    CLIMATE,
+  };
+  struct BatchedState {
+    BatchedStateType type;
+    Nameable *entity;
+  };
+  /// Queue a state update for the next batch, returns false if it should be sent immediately.
+  bool batch_state_(BatchedStateType type, Nameable *entity);
+  /// Send the current state of all queued entities, as many as fit in the TCP buffer.
+  void flush_batch_();
+  bool send_batched_state_(const BatchedState &state);
+  bool send_frames_();
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -148,7 +192,24 @@ class APIConnection : public APIServerConnection {
   bool remove_{false};
 
   std::vector<uint8_t> send_buffer_;
-  std::vector<uint8_t> recv_buffer_;
+  /// Framed messages that are written to the client with a single add()/send().
+  std::vector<uint8_t> frame_buffer_;
+  std::vector<BatchedState> batched_states_;
+  uint32_t batch_start_{0};
+  bool flushing_batch_{false};
+  RingBuffer recv_buffer_;
+  /// Linear copy of a received message that wraps around the end of recv_buffer_.
+  std::vector<uint8_t> recv_wrap_buffer_;
+  /** Data received while recv_buffer_ was full (or while older data was still waiting here).
+   *
+   * It is not acknowledged to the TCP stack until it was moved to recv_buffer_, so the receive window closes and
+   * the client stops sending instead of the connection being dropped. That also bounds its size to the window.
+   */
+  std::vector<uint8_t> recv_backlog_;
+#ifdef ARDUINO_ARCH_ESP32
+  /// on_data_() runs in the AsyncTCP task, guards recv_backlog_ and resizing recv_buffer_.
+  SemaphoreHandle_t recv_lock_;
+#endif
 
   std::string client_info_;
 #ifdef USE_ESP32_CAMERA
@@ -157,6 +218,11 @@ class APIConnection : public APIServerConnection {
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+  /// A log message could not be sent, flag it in the next one.
+  bool log_send_failed_{false};
+#ifdef USE_API_COMPACT_LOGS
+  bool log_compact_{false};
+#endif
   uint32_t last_traffic_;
   bool sent_ping_{false};
   bool service_call_subscription_{false};
@@ -166,6 +232,11 @@ class APIConnection : public APIServerConnection {
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
   ListEntitiesIterator list_entities_iterator_;
+#ifdef USE_COMPONENT_PROFILER
+  /// Index of the next component to send timings for, -1 if no timings have been requested.
+  int32_t component_timings_index_{-1};
+  bool component_timings_reset_{false};
+#endif
 };
 
 }  // namespace api
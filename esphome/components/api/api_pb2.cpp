@@ -189,6 +189,9 @@ bool HelloRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value)
   }
 }
 void HelloRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->client_info); }
+void HelloRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->client_info);
+}
 void HelloRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("HelloRequest {\n");
@@ -226,6 +229,11 @@ void HelloResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->api_version_minor);
   buffer.encode_string(3, this->server_info);
 }
+void HelloResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32_field(total_size, 2, this->api_version_minor);
+  ProtoSize::add_string_field(total_size, 3, this->server_info);
+}
 void HelloResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("HelloResponse {\n");
@@ -255,6 +263,9 @@ bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value
   }
 }
 void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->password);
+}
 void ConnectRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ConnectRequest {\n");
@@ -274,6 +285,9 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   }
 }
 void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->invalid_password);
+}
 void ConnectResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ConnectResponse {\n");
@@ -283,14 +297,19 @@ void ConnectResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::calculate_size(uint32_t &total_size) const {}
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::calculate_size(uint32_t &total_size) const {}
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
 bool DeviceInfoResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
@@ -341,6 +360,15 @@ void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(6, this->model);
   buffer.encode_bool(7, this->has_deep_sleep);
 }
+void DeviceInfoResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->uses_password);
+  ProtoSize::add_string_field(total_size, 2, this->name);
+  ProtoSize::add_string_field(total_size, 3, this->mac_address);
+  ProtoSize::add_string_field(total_size, 4, this->esphome_version);
+  ProtoSize::add_string_field(total_size, 5, this->compilation_time);
+  ProtoSize::add_string_field(total_size, 6, this->model);
+  ProtoSize::add_bool_field(total_size, 7, this->has_deep_sleep);
+}
 void DeviceInfoResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("DeviceInfoResponse {\n");
@@ -374,10 +402,13 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {}
 void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
@@ -429,6 +460,14 @@ void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(5, this->device_class);
   buffer.encode_bool(6, this->is_status_binary_sensor);
 }
+void ListEntitiesBinarySensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->device_class);
+  ProtoSize::add_bool_field(total_size, 6, this->is_status_binary_sensor);
+}
 void ListEntitiesBinarySensorResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesBinarySensorResponse {\n");
@@ -487,6 +526,11 @@ void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void BinarySensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 void BinarySensorStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("BinarySensorStateResponse {\n");
@@ -564,6 +608,16 @@ void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(7, this->supports_tilt);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesCoverResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_position);
+  ProtoSize::add_bool_field(total_size, 7, this->supports_tilt);
+  ProtoSize::add_string_field(total_size, 8, this->device_class);
+}
 void ListEntitiesCoverResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesCoverResponse {\n");
@@ -640,6 +694,13 @@ void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(4, this->tilt);
   buffer.encode_enum<enums::CoverOperation>(5, this->current_operation);
 }
+void CoverStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LegacyCoverState>(total_size, 2, this->legacy_state);
+  ProtoSize::add_float_field(total_size, 3, this->position);
+  ProtoSize::add_float_field(total_size, 4, this->tilt);
+  ProtoSize::add_enum_field<enums::CoverOperation>(total_size, 5, this->current_operation);
+}
 void CoverStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("CoverStateResponse {\n");
@@ -721,6 +782,16 @@ void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(7, this->tilt);
   buffer.encode_bool(8, this->stop);
 }
+void CoverCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_legacy_command);
+  ProtoSize::add_enum_field<enums::LegacyCoverCommand>(total_size, 3, this->legacy_command);
+  ProtoSize::add_bool_field(total_size, 4, this->has_position);
+  ProtoSize::add_float_field(total_size, 5, this->position);
+  ProtoSize::add_bool_field(total_size, 6, this->has_tilt);
+  ProtoSize::add_float_field(total_size, 7, this->tilt);
+  ProtoSize::add_bool_field(total_size, 8, this->stop);
+}
 void CoverCommandRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("CoverCommandRequest {\n");
@@ -815,6 +886,15 @@ void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->supports_speed);
   buffer.encode_bool(7, this->supports_direction);
 }
+void ListEntitiesFanResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->supports_oscillation);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_speed);
+  ProtoSize::add_bool_field(total_size, 7, this->supports_direction);
+}
 void ListEntitiesFanResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesFanResponse {\n");
@@ -887,6 +967,13 @@ void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::FanSpeed>(4, this->speed);
   buffer.encode_enum<enums::FanDirection>(5, this->direction);
 }
+void FanStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->oscillating);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 4, this->speed);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 5, this->direction);
+}
 void FanStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("FanStateResponse {\n");
@@ -971,6 +1058,17 @@ void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(8, this->has_direction);
   buffer.encode_enum<enums::FanDirection>(9, this->direction);
 }
+void FanCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_state);
+  ProtoSize::add_bool_field(total_size, 3, this->state);
+  ProtoSize::add_bool_field(total_size, 4, this->has_speed);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 5, this->speed);
+  ProtoSize::add_bool_field(total_size, 6, this->has_oscillating);
+  ProtoSize::add_bool_field(total_size, 7, this->oscillating);
+  ProtoSize::add_bool_field(total_size, 8, this->has_direction);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 9, this->direction);
+}
 void FanCommandRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("FanCommandRequest {\n");
@@ -1089,6 +1187,21 @@ void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(11, it, true);
   }
 }
+void ListEntitiesLightResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->supports_brightness);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_rgb);
+  ProtoSize::add_bool_field(total_size, 7, this->supports_white_value);
+  ProtoSize::add_bool_field(total_size, 8, this->supports_color_temperature);
+  ProtoSize::add_float_field(total_size, 9, this->min_mireds);
+  ProtoSize::add_float_field(total_size, 10, this->max_mireds);
+  for (auto &it : this->effects) {
+    ProtoSize::add_string_field(total_size, 11, it, true);
+  }
+}
 void ListEntitiesLightResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesLightResponse {\n");
@@ -1207,6 +1320,17 @@ void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(8, this->color_temperature);
   buffer.encode_string(9, this->effect);
 }
+void LightStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_float_field(total_size, 3, this->brightness);
+  ProtoSize::add_float_field(total_size, 4, this->red);
+  ProtoSize::add_float_field(total_size, 5, this->green);
+  ProtoSize::add_float_field(total_size, 6, this->blue);
+  ProtoSize::add_float_field(total_size, 7, this->white);
+  ProtoSize::add_float_field(total_size, 8, this->color_temperature);
+  ProtoSize::add_string_field(total_size, 9, this->effect);
+}
 void LightStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("LightStateResponse {\n");
@@ -1369,6 +1493,27 @@ void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(18, this->has_effect);
   buffer.encode_string(19, this->effect);
 }
+void LightCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_state);
+  ProtoSize::add_bool_field(total_size, 3, this->state);
+  ProtoSize::add_bool_field(total_size, 4, this->has_brightness);
+  ProtoSize::add_float_field(total_size, 5, this->brightness);
+  ProtoSize::add_bool_field(total_size, 6, this->has_rgb);
+  ProtoSize::add_float_field(total_size, 7, this->red);
+  ProtoSize::add_float_field(total_size, 8, this->green);
+  ProtoSize::add_float_field(total_size, 9, this->blue);
+  ProtoSize::add_bool_field(total_size, 10, this->has_white);
+  ProtoSize::add_float_field(total_size, 11, this->white);
+  ProtoSize::add_bool_field(total_size, 12, this->has_color_temperature);
+  ProtoSize::add_float_field(total_size, 13, this->color_temperature);
+  ProtoSize::add_bool_field(total_size, 14, this->has_transition_length);
+  ProtoSize::add_uint32_field(total_size, 15, this->transition_length);
+  ProtoSize::add_bool_field(total_size, 16, this->has_flash_length);
+  ProtoSize::add_uint32_field(total_size, 17, this->flash_length);
+  ProtoSize::add_bool_field(total_size, 18, this->has_effect);
+  ProtoSize::add_string_field(total_size, 19, this->effect);
+}
 void LightCommandRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("LightCommandRequest {\n");
@@ -1518,6 +1663,16 @@ void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_int32(7, this->accuracy_decimals);
   buffer.encode_bool(8, this->force_update);
 }
+void ListEntitiesSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_string_field(total_size, 6, this->unit_of_measurement);
+  ProtoSize::add_int32_field(total_size, 7, this->accuracy_decimals);
+  ProtoSize::add_bool_field(total_size, 8, this->force_update);
+}
 void ListEntitiesSensorResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesSensorResponse {\n");
@@ -1585,6 +1740,11 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 void SensorStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("SensorStateResponse {\n");
@@ -1653,6 +1813,14 @@ void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(5, this->icon);
   buffer.encode_bool(6, this->assumed_state);
 }
+void ListEntitiesSwitchResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->assumed_state);
+}
 void ListEntitiesSwitchResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesSwitchResponse {\n");
@@ -1706,6 +1874,10 @@ void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+}
 void SwitchStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("SwitchStateResponse {\n");
@@ -1743,6 +1915,10 @@ void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+}
 void SwitchCommandRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("SwitchCommandRequest {\n");
@@ -1795,6 +1971,13 @@ void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(4, this->unique_id);
   buffer.encode_string(5, this->icon);
 }
+void ListEntitiesTextSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+}
 void ListEntitiesTextSensorResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesTextSensorResponse {\n");
@@ -1855,6 +2038,11 @@ void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 void TextSensorStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("TextSensorStateResponse {\n");
@@ -1882,6 +2070,20 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->dump_config = value.as_bool();
       return true;
     }
+    case 3: {
+      this->compact = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeLogsRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 4: {
+      this->format_table_hash = value.as_fixed32();
+      return true;
+    }
     default:
       return false;
   }
@@ -1889,6 +2091,14 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
+  buffer.encode_bool(3, this->compact);
+  buffer.encode_fixed32(4, this->format_table_hash);
+}
+void SubscribeLogsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_bool_field(total_size, 2, this->dump_config);
+  ProtoSize::add_bool_field(total_size, 3, this->compact);
+  ProtoSize::add_fixed32_field(total_size, 4, this->format_table_hash);
 }
 void SubscribeLogsRequest::dump_to(std::string &out) const {
   char buffer[64];
@@ -1900,6 +2110,15 @@ void SubscribeLogsRequest::dump_to(std::string &out) const {
   out.append("  dump_config: ");
   out.append(YESNO(this->dump_config));
   out.append("\n");
+
+  out.append("  compact: ");
+  out.append(YESNO(this->compact));
+  out.append("\n");
+
+  out.append("  format_table_hash: ");
+  sprintf(buffer, "%u", this->format_table_hash);
+  out.append(buffer);
+  out.append("\n");
   out.append("}");
 }
 bool SubscribeLogsResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
@@ -1936,6 +2155,12 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
 }
+void SubscribeLogsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_string_field(total_size, 2, this->tag);
+  ProtoSize::add_string_field(total_size, 3, this->message);
+  ProtoSize::add_bool_field(total_size, 4, this->send_failed);
+}
 void SubscribeLogsResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("SubscribeLogsResponse {\n");
@@ -1956,7 +2181,90 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
   out.append("\n");
   out.append("}");
 }
+bool SubscribeLogsCompactResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->level = value.as_enum<enums::LogLevel>();
+      return true;
+    }
+    case 2: {
+      this->format_id = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->line = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->send_failed = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeLogsCompactResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 3: {
+      this->tag = value.as_string();
+      return true;
+    }
+    case 5: {
+      this->args = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeLogsCompactResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_enum<enums::LogLevel>(1, this->level);
+  buffer.encode_uint32(2, this->format_id);
+  buffer.encode_string(3, this->tag);
+  buffer.encode_uint32(4, this->line);
+  buffer.encode_string(5, this->args);
+  buffer.encode_bool(6, this->send_failed);
+}
+void SubscribeLogsCompactResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_uint32_field(total_size, 2, this->format_id);
+  ProtoSize::add_string_field(total_size, 3, this->tag);
+  ProtoSize::add_uint32_field(total_size, 4, this->line);
+  ProtoSize::add_string_field(total_size, 5, this->args);
+  ProtoSize::add_bool_field(total_size, 6, this->send_failed);
+}
+void SubscribeLogsCompactResponse::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("SubscribeLogsCompactResponse {\n");
+  out.append("  level: ");
+  out.append(proto_enum_to_string<enums::LogLevel>(this->level));
+  out.append("\n");
+
+  out.append("  format_id: ");
+  sprintf(buffer, "%u", this->format_id);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  tag: ");
+  out.append("'").append(this->tag).append("'");
+  out.append("\n");
+
+  out.append("  line: ");
+  sprintf(buffer, "%u", this->line);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  args: ");
+  out.append("'").append(this->args).append("'");
+  out.append("\n");
+
+  out.append("  send_failed: ");
+  out.append(YESNO(this->send_failed));
+  out.append("\n");
+  out.append("}");
+}
 void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeassistantServicesRequest {}");
 }
@@ -1978,6 +2286,10 @@ void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
+void HomeassistantServiceMap::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->value);
+}
 void HomeassistantServiceMap::dump_to(std::string &out) const {
   char buffer[64];
   out.append("HomeassistantServiceMap {\n");
@@ -2035,6 +2347,19 @@ void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_bool(5, this->is_event);
 }
+void HomeassistantServiceResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->service);
+  for (auto &it : this->data) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 2, it, true);
+  }
+  for (auto &it : this->data_template) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 3, it, true);
+  }
+  for (auto &it : this->variables) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 4, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 5, this->is_event);
+}
 void HomeassistantServiceResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("HomeassistantServiceResponse {\n");
@@ -2066,6 +2391,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeAssistantStatesRequest {}");
 }
@@ -2082,6 +2408,9 @@ bool SubscribeHomeAssistantStateResponse::decode_length(uint32_t field_id, Proto
 void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->entity_id);
 }
+void SubscribeHomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+}
 void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("SubscribeHomeAssistantStateResponse {\n");
@@ -2108,6 +2437,10 @@ void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->state);
 }
+void HomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+}
 void HomeAssistantStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("HomeAssistantStateResponse {\n");
@@ -2121,6 +2454,7 @@ void HomeAssistantStateResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
 bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   switch (field_id) {
@@ -2133,6 +2467,9 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->epoch_seconds);
+}
 void GetTimeResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("GetTimeResponse {\n");
@@ -2166,6 +2503,10 @@ void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
+void ListEntitiesServicesArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_enum_field<enums::ServiceArgType>(total_size, 2, this->type);
+}
 void ListEntitiesServicesArgument::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesServicesArgument {\n");
@@ -2209,6 +2550,13 @@ void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ListEntitiesServicesArgument>(3, it, true);
   }
 }
+void ListEntitiesServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message_field<ListEntitiesServicesArgument>(total_size, 3, it, true);
+  }
+}
 void ListEntitiesServicesResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesServicesResponse {\n");
@@ -2301,6 +2649,25 @@ void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ExecuteServiceArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->bool_);
+  ProtoSize::add_int32_field(total_size, 2, this->legacy_int);
+  ProtoSize::add_float_field(total_size, 3, this->float_);
+  ProtoSize::add_string_field(total_size, 4, this->string_);
+  ProtoSize::add_sint32_field(total_size, 5, this->int_);
+  for (auto it : this->bool_array) {
+    ProtoSize::add_bool_field(total_size, 6, it, true);
+  }
+  for (auto &it : this->int_array) {
+    ProtoSize::add_sint32_field(total_size, 7, it, true);
+  }
+  for (auto &it : this->float_array) {
+    ProtoSize::add_float_field(total_size, 8, it, true);
+  }
+  for (auto &it : this->string_array) {
+    ProtoSize::add_string_field(total_size, 9, it, true);
+  }
+}
 void ExecuteServiceArgument::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ExecuteServiceArgument {\n");
@@ -2380,6 +2747,12 @@ void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
   }
 }
+void ExecuteServiceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message_field<ExecuteServiceArgument>(total_size, 2, it, true);
+  }
+}
 void ExecuteServiceRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ExecuteServiceRequest {\n");
@@ -2429,6 +2802,12 @@ void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->name);
   buffer.encode_string(4, this->unique_id);
 }
+void ListEntitiesCameraResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+}
 void ListEntitiesCameraResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesCameraResponse {\n");
@@ -2485,6 +2864,11 @@ void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
 }
+void CameraImageResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->data);
+  ProtoSize::add_bool_field(total_size, 3, this->done);
+}
 void CameraImageResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("CameraImageResponse {\n");
@@ -2520,6 +2904,10 @@ void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
+void CameraImageRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->single);
+  ProtoSize::add_bool_field(total_size, 2, this->stream);
+}
 void CameraImageRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("CameraImageRequest {\n");
@@ -2628,6 +3016,28 @@ void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_enum<enums::ClimateSwingMode>(14, it, true);
   }
 }
+void ListEntitiesClimateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->supports_current_temperature);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_two_point_target_temperature);
+  for (auto &it : this->supported_modes) {
+    ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 7, it, true);
+  }
+  ProtoSize::add_float_field(total_size, 8, this->visual_min_temperature);
+  ProtoSize::add_float_field(total_size, 9, this->visual_max_temperature);
+  ProtoSize::add_float_field(total_size, 10, this->visual_temperature_step);
+  ProtoSize::add_bool_field(total_size, 11, this->supports_away);
+  ProtoSize::add_bool_field(total_size, 12, this->supports_action);
+  for (auto &it : this->supported_fan_modes) {
+    ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 13, it, true);
+  }
+  for (auto &it : this->supported_swing_modes) {
+    ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 14, it, true);
+  }
+}
 void ListEntitiesClimateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ListEntitiesClimateResponse {\n");
@@ -2762,6 +3172,18 @@ void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::ClimateFanMode>(9, this->fan_mode);
   buffer.encode_enum<enums::ClimateSwingMode>(10, this->swing_mode);
 }
+void ClimateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 2, this->mode);
+  ProtoSize::add_float_field(total_size, 3, this->current_temperature);
+  ProtoSize::add_float_field(total_size, 4, this->target_temperature);
+  ProtoSize::add_float_field(total_size, 5, this->target_temperature_low);
+  ProtoSize::add_float_field(total_size, 6, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 7, this->away);
+  ProtoSize::add_enum_field<enums::ClimateAction>(total_size, 8, this->action);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 9, this->fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 10, this->swing_mode);
+}
 void ClimateStateResponse::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ClimateStateResponse {\n");
@@ -2900,6 +3322,23 @@ void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(14, this->has_swing_mode);
   buffer.encode_enum<enums::ClimateSwingMode>(15, this->swing_mode);
 }
+void ClimateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_mode);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 3, this->mode);
+  ProtoSize::add_bool_field(total_size, 4, this->has_target_temperature);
+  ProtoSize::add_float_field(total_size, 5, this->target_temperature);
+  ProtoSize::add_bool_field(total_size, 6, this->has_target_temperature_low);
+  ProtoSize::add_float_field(total_size, 7, this->target_temperature_low);
+  ProtoSize::add_bool_field(total_size, 8, this->has_target_temperature_high);
+  ProtoSize::add_float_field(total_size, 9, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 10, this->has_away);
+  ProtoSize::add_bool_field(total_size, 11, this->away);
+  ProtoSize::add_bool_field(total_size, 12, this->has_fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 13, this->fan_mode);
+  ProtoSize::add_bool_field(total_size, 14, this->has_swing_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 15, this->swing_mode);
+}
 void ClimateCommandRequest::dump_to(std::string &out) const {
   char buffer[64];
   out.append("ClimateCommandRequest {\n");
@@ -2968,6 +3407,180 @@ void ClimateCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
   out.append("}");
 }
+bool ComponentTimingsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->reset = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentTimingsRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->reset); }
+void ComponentTimingsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->reset);
+}
+void ComponentTimingsRequest::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("ComponentTimingsRequest {\n");
+  out.append("  reset: ");
+  out.append(YESNO(this->reset));
+  out.append("\n");
+  out.append("}");
+}
+bool ComponentTimingStats::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->count = value.as_uint32();
+      return true;
+    }
+    case 2: {
+      this->min_us = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->max_us = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->p99_us = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->buckets.push_back(value.as_uint32());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentTimingStats::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 3: {
+      this->mean_us = value.as_float();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentTimingStats::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint32(1, this->count);
+  buffer.encode_uint32(2, this->min_us);
+  buffer.encode_float(3, this->mean_us);
+  buffer.encode_uint32(4, this->max_us);
+  buffer.encode_uint32(5, this->p99_us);
+  for (auto &it : this->buckets) {
+    buffer.encode_uint32(6, it, true);
+  }
+}
+void ComponentTimingStats::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->count);
+  ProtoSize::add_uint32_field(total_size, 2, this->min_us);
+  ProtoSize::add_float_field(total_size, 3, this->mean_us);
+  ProtoSize::add_uint32_field(total_size, 4, this->max_us);
+  ProtoSize::add_uint32_field(total_size, 5, this->p99_us);
+  for (auto &it : this->buckets) {
+    ProtoSize::add_uint32_field(total_size, 6, it, true);
+  }
+}
+void ComponentTimingStats::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("ComponentTimingStats {\n");
+  out.append("  count: ");
+  sprintf(buffer, "%u", this->count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  min_us: ");
+  sprintf(buffer, "%u", this->min_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  mean_us: ");
+  sprintf(buffer, "%g", this->mean_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  max_us: ");
+  sprintf(buffer, "%u", this->max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  p99_us: ");
+  sprintf(buffer, "%u", this->p99_us);
+  out.append(buffer);
+  out.append("\n");
+
+  for (const auto &it : this->buckets) {
+    out.append("  buckets: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+  out.append("}");
+}
+bool ComponentTimingResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 4: {
+      this->done = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentTimingResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->source = value.as_string();
+      return true;
+    }
+    case 2: {
+      this->loop = value.as_message<ComponentTimingStats>();
+      return true;
+    }
+    case 3: {
+      this->scheduler = value.as_message<ComponentTimingStats>();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentTimingResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->source);
+  buffer.encode_message<ComponentTimingStats>(2, this->loop);
+  buffer.encode_message<ComponentTimingStats>(3, this->scheduler);
+  buffer.encode_bool(4, this->done);
+}
+void ComponentTimingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->source);
+  ProtoSize::add_message_field<ComponentTimingStats>(total_size, 2, this->loop);
+  ProtoSize::add_message_field<ComponentTimingStats>(total_size, 3, this->scheduler);
+  ProtoSize::add_bool_field(total_size, 4, this->done);
+}
+void ComponentTimingResponse::dump_to(std::string &out) const {
+  char buffer[64];
+  out.append("ComponentTimingResponse {\n");
+  out.append("  source: ");
+  out.append("'").append(this->source).append("'");
+  out.append("\n");
+
+  out.append("  loop: ");
+  this->loop.dump_to(out);
+  out.append("\n");
+
+  out.append("  scheduler: ");
+  this->scheduler.dump_to(out);
+  out.append("\n");
+
+  out.append("  done: ");
+  out.append(YESNO(this->done));
+  out.append("\n");
+  out.append("}");
+}
 
 }  // namespace api
 }  // namespace esphome
@@ -135,6 +135,11 @@ bool APIServerConnectionBase::send_text_sensor_state_response(const TextSensorSt
 bool APIServerConnectionBase::send_subscribe_logs_response(const SubscribeLogsResponse &msg) {
   return this->send_message_<SubscribeLogsResponse>(msg, 29);
 }
+#ifdef USE_API_COMPACT_LOGS
+bool APIServerConnectionBase::send_subscribe_logs_compact_response(const SubscribeLogsCompactResponse &msg) {
+  return this->send_message_<SubscribeLogsCompactResponse>(msg, 51);
+}
+#endif
 bool APIServerConnectionBase::send_homeassistant_service_response(const HomeassistantServiceResponse &msg) {
   ESP_LOGVV(TAG, "send_homeassistant_service_response: %s", msg.dump().c_str());
   return this->send_message_<HomeassistantServiceResponse>(msg, 35);
@@ -184,6 +189,14 @@ bool APIServerConnectionBase::send_climate_state_response(const ClimateStateResp
 #endif
 #ifdef USE_CLIMATE
 #endif
+#ifdef USE_COMPONENT_PROFILER
+#endif
+#ifdef USE_COMPONENT_PROFILER
+bool APIServerConnectionBase::send_component_timing_response(const ComponentTimingResponse &msg) {
+  ESP_LOGVV(TAG, "send_component_timing_response: %s", msg.dump().c_str());
+  return this->send_message_<ComponentTimingResponse>(msg, 50);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -349,6 +362,15 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       msg.decode(msg_data, msg_size);
       ESP_LOGVV(TAG, "on_climate_command_request: %s", msg.dump().c_str());
       this->on_climate_command_request(msg);
+#endif
+      break;
+    }
+    case 49: {
+#ifdef USE_COMPONENT_PROFILER
+      ComponentTimingsRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_component_timings_request: %s", msg.dump().c_str());
+      this->on_component_timings_request(msg);
 #endif
       break;
     }
@@ -547,6 +569,19 @@ void APIServerConnection::on_climate_command_request(const ClimateCommandRequest
   this->climate_command(msg);
 }
 #endif
+#ifdef USE_COMPONENT_PROFILER
+void APIServerConnection::on_component_timings_request(const ComponentTimingsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->component_timings(msg);
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
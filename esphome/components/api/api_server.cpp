@@ -33,6 +33,7 @@ void APIServer::setup() {
         // ESP_LOGD(TAG, "New client connected from %s", client->remoteIP().toString().c_str());
         auto *a_this = (APIServer *) s;
         a_this->clients_.push_back(new APIConnection(client, a_this));
+        a_this->enable_loop();
       },
       this);
 #ifdef USE_LOGGER
@@ -43,6 +44,15 @@ void APIServer::setup() {
           c->send_log_message(level, tag, message);
       }
     });
+#ifdef USE_API_COMPACT_LOGS
+    logger::global_logger->add_on_async_log_callback(
+        [this](const logger::AsyncLogRecord &record, const char *message) {
+          for (auto *c : this->clients_) {
+            if (!c->remove_)
+              c->send_log_record(record, message);
+          }
+        });
+#endif
   }
 #endif
 
@@ -77,8 +87,8 @@ void APIServer::loop() {
     client->loop();
   }
 
+  const uint32_t now = millis();
   if (this->reboot_timeout_ != 0) {
-    const uint32_t now = millis();
     if (!this->is_connected()) {
       if (now - this->last_connected_ > this->reboot_timeout_) {
         ESP_LOGE(TAG, "No client connected to API. Rebooting...");
@@ -90,10 +100,48 @@ void APIServer::loop() {
       this->status_clear_warning();
     }
   }
+
+  if (this->is_idle_()) {
+    // Nothing to do until a client connects, sends data or a state is batched (which all enable the loop again),
+    // or until the reboot timeout or a keepalive is due
+    this->disable_loop();
+    optional<uint32_t> wake_in;
+    if (this->clients_.empty()) {
+      if (this->reboot_timeout_ != 0) {
+        uint32_t elapsed = now - this->last_connected_;
+        wake_in = elapsed < this->reboot_timeout_ ? this->reboot_timeout_ - elapsed : 0;
+      }
+    } else {
+      wake_in = this->clients_[0]->next_keepalive_in(now);
+      for (auto *client : this->clients_)
+        wake_in = std::min(*wake_in, client->next_keepalive_in(now));
+    }
+    if (wake_in.has_value()) {
+      this->set_timeout(fnv1_hash_static("wake"), *wake_in + 1, [this]() { this->enable_loop(); });
+    } else {
+      this->cancel_timeout(fnv1_hash_static("wake"));
+    }
+    // a client may have connected or sent data in the meantime
+    if (!this->is_idle_())
+      this->enable_loop();
+  }
+}
+bool APIServer::is_idle_() const {
+  for (auto *client : this->clients_) {
+    if (!client->is_idle())
+      return false;
+  }
+  return true;
 }
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  RX Buffer Size: %u", this->rx_buffer_size_);
+  ESP_LOGCONFIG(TAG, "  Batch Delay: %ums", this->batch_delay_);
+#ifdef USE_API_COMPACT_LOGS
+  ESP_LOGCONFIG(TAG, "  Compact Logs: %u formats (table %08X)", this->log_format_table_.size(),
+                this->log_format_table_.get_table_hash());
+#endif
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
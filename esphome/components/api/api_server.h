@@ -11,6 +11,7 @@
 #include "subscribe_state.h"
 #include "homeassistant_service.h"
 #include "user_services.h"
+#include "log_format_table.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <AsyncTCP.h>
@@ -36,6 +37,22 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Set the size of the receive buffer of each client connection in bytes.
+  void set_rx_buffer_size(size_t rx_buffer_size) { this->rx_buffer_size_ = rx_buffer_size; }
+  size_t get_rx_buffer_size() const { return this->rx_buffer_size_; }
+  /** Set how long state updates are collected before they are sent to the clients in one TCP packet.
+   *
+   * Within this window only the latest state of each entity is sent. 0 sends every state update immediately.
+   */
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
+#ifdef USE_API_COMPACT_LOGS
+  /// Set the log format table generated at build time, see LogFormatTable.
+  void set_log_format_table(const uint32_t *hashes, uint16_t count, uint32_t table_hash) {
+    this->log_format_table_.set_table(hashes, count, table_hash);
+  }
+  LogFormatTable &get_log_format_table() { return this->log_format_table_; }
+#endif
   void handle_disconnect(APIConnection *conn);
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
@@ -79,9 +96,17 @@ class APIServer : public Component, public Controller {
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
  protected:
+  /// Whether no client has anything for loop() to do, see APIConnection::is_idle().
+  bool is_idle_() const;
+
   AsyncServer server_{0};
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  size_t rx_buffer_size_{2048};
+  uint32_t batch_delay_{0};
+#ifdef USE_API_COMPACT_LOGS
+  LogFormatTable log_format_table_;
+#endif
   uint32_t last_connected_{0};
   std::vector<APIConnection *> clients_;
   std::string password_;
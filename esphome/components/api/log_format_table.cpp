@@ -0,0 +1,61 @@
+#include "log_format_table.h"
+
+#ifdef USE_API_COMPACT_LOGS
+
+#include "esphome/core/esphal.h"
+
+namespace esphome {
+namespace api {
+
+void LogFormatTable::set_table(const uint32_t *hashes, uint16_t count, uint32_t table_hash) {
+  this->hashes_ = hashes;
+  this->count_ = count;
+  this->table_hash_ = table_hash;
+  for (auto &entry : this->cache_)
+    entry.format = nullptr;
+}
+
+int32_t LogFormatTable::lookup(const char *format, bool format_in_flash) {
+  CacheEntry &entry = this->cache_[(reinterpret_cast<uintptr_t>(format) >> 2) % CACHE_SIZE];
+  if (entry.format == format)
+    return entry.id;
+
+  const uint32_t hash = LogFormatTable::hash(format, format_in_flash);
+  int32_t id = -1;
+  uint16_t lo = 0, hi = this->count_;
+  while (lo < hi) {
+    uint16_t mid = lo + (hi - lo) / 2;
+    uint32_t value = pgm_read_dword(this->hashes_ + mid);
+    if (value == hash) {
+      id = mid;
+      break;
+    }
+    if (value < hash)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  entry.format = format;
+  entry.id = id;
+  return id;
+}
+
+uint32_t LogFormatTable::hash(const char *format, bool format_in_flash) {
+  // FNV-1 like fnv1_hash(), but bytewise and for strings in flash too
+  uint32_t hash = 2166136261UL;
+  while (true) {
+    uint8_t c = format_in_flash ? pgm_read_byte(format) : *format;
+    if (c == '\0')
+      break;
+    hash *= 16777619UL;
+    hash ^= c;
+    format++;
+  }
+  return hash;
+}
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_COMPACT_LOGS
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_API_COMPACT_LOGS
+
+#include <cstdint>
+
+namespace esphome {
+namespace api {
+
+/** The format strings of all log call sites, collected at build time (see esphome/api/log_format.py).
+ *
+ * Only the sorted FNV-1 hashes of the format strings are stored on the device, the index of a hash in the table is
+ * the ID sent in SubscribeLogsCompactResponse. Clients decode it with the format table written to the build
+ * directory.
+ */
+class LogFormatTable {
+ public:
+  /// Set the table, hashes must be sorted ascending and may be stored in PROGMEM.
+  void set_table(const uint32_t *hashes, uint16_t count, uint32_t table_hash);
+  /// Hash over all format strings, identifies the table a client needs for decoding.
+  uint32_t get_table_hash() const { return this->table_hash_; }
+  uint16_t size() const { return this->count_; }
+
+  /// The ID of the given format string or -1 if it isn't in the table.
+  int32_t lookup(const char *format, bool format_in_flash);
+
+  static uint32_t hash(const char *format, bool format_in_flash);
+
+ protected:
+  static const uint8_t CACHE_SIZE = 16;
+  /// Direct-mapped cache from format string pointer to ID, most log messages come from few call sites.
+  struct CacheEntry {
+    const char *format;
+    int32_t id;
+  };
+
+  const uint32_t *hashes_{nullptr};
+  uint16_t count_{0};
+  uint32_t table_hash_{0};
+  CacheEntry cache_[CACHE_SIZE]{};
+};
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_COMPACT_LOGS
@@ -6,7 +6,7 @@
 namespace esphome {
 namespace api {
 
-/// Representation of a VarInt - in ProtoBuf should be 64bit but we only use 32bit
+/// Representation of a 64-bit protobuf VarInt.
 class ProtoVarInt {
  public:
   ProtoVarInt() : value_(0) {}
@@ -24,7 +24,9 @@ class ProtoVarInt {
 
     for (uint32_t i = 0; i < len; i++) {
       uint8_t val = buffer[i];
-      result |= uint64_t(val & 0x7F) << uint64_t(bitpos);
+      // malformed varints can be longer than 64 bits, ignore the excess bits
+      if (bitpos < 64)
+        result |= uint64_t(val & 0x7F) << uint64_t(bitpos);
       bitpos += 7;
       if ((val & 0x80) == 0) {
         if (consumed != nullptr)
@@ -63,6 +65,16 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
   }
   void encode(std::vector<uint8_t> &out) {
+    if (this->value_ > 0xFFFFFFFFULL) {
+      // 64-bit values (e.g. negative int32/int64 fields) are rare, keep the common path on 32-bit arithmetic
+      uint64_t val = this->value_;
+      while (val >= 0x80) {
+        out.push_back((val & 0x7F) | 0x80);
+        val >>= 7;
+      }
+      out.push_back(val);
+      return;
+    }
     uint32_t val = this->value_;
     if (val <= 0x7F) {
       out.push_back(val);
@@ -151,11 +163,10 @@ class ProtoWriteBuffer {
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
     auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -188,6 +199,20 @@ class ProtoWriteBuffer {
     this->write((value >> 16) & 0xFF);
     this->write((value >> 24) & 0xFF);
   }
+  void encode_fixed64(uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+
+    this->encode_field_raw(field_id, 1);
+    for (uint8_t shift = 0; shift < 64; shift += 8)
+      this->write((value >> shift) & 0xFF);
+  }
+  void encode_sfixed32(uint32_t field_id, int32_t value, bool force = false) {
+    this->encode_fixed32(field_id, static_cast<uint32_t>(value), force);
+  }
+  void encode_sfixed64(uint32_t field_id, int64_t value, bool force = false) {
+    this->encode_fixed64(field_id, static_cast<uint64_t>(value), force);
+  }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
   }
@@ -200,7 +225,18 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
+  }
+  void encode_double(uint32_t field_id, double value, bool force = false) {
+    if (value == 0.0 && !force)
+      return;
+
+    union {
+      double value;
+      uint64_t raw;
+    } val{};
+    val.value = value;
+    this->encode_fixed64(field_id, val.raw, force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -216,22 +252,26 @@ class ProtoWriteBuffer {
   void encode_sint32(uint32_t field_id, int32_t value, bool force = false) {
     uint32_t uvalue;
     if (value < 0)
-      uvalue = ~(value << 1);
+      uvalue = ~(static_cast<uint32_t>(value) << 1);
     else
       uvalue = value << 1;
     this->encode_uint32(field_id, uvalue, force);
   }
+  void encode_sint64(uint32_t field_id, int64_t value, bool force = false) {
+    uint64_t uvalue;
+    if (value < 0)
+      uvalue = ~(static_cast<uint64_t>(value) << 1);
+    else
+      uvalue = static_cast<uint64_t>(value) << 1;
+    this->encode_uint64(field_id, uvalue, force);
+  }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // write the length prefix up front instead of shifting the nested message after encoding it
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -239,9 +279,118 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Calculates the encoded size of protobuf fields.
+ *
+ * Each add_*_field() method adds exactly the number of bytes the matching ProtoWriteBuffer::encode_*() method writes.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < (1UL << 7))
+      return 1;
+    if (value < (1UL << 14))
+      return 2;
+    if (value < (1UL << 21))
+      return 3;
+    if (value < (1UL << 28))
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    uint32_t size = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64_field(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    uint32_t uvalue;
+    if (value < 0)
+      uvalue = ~(static_cast<uint32_t>(value) << 1);
+    else
+      uvalue = value << 1;
+    add_uint32_field(total_size, field_id, uvalue, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    uint64_t uvalue;
+    if (value < 0)
+      uvalue = ~(static_cast<uint64_t>(value) << 1);
+    else
+      uvalue = static_cast<uint64_t>(value) << 1;
+    add_uint64_field(total_size, field_id, uvalue, force);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 1) + 8;
+  }
+  static void add_double_field(uint32_t &total_size, uint32_t field_id, double value, bool force = false) {
+    if (value == 0.0 && !force)
+      return;
+    total_size += field(field_id, 1) + 8;
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const std::string &value,
+                               bool force = false) {
+    if (value.empty() && !force)
+      return;
+    total_size += field(field_id, 2) + varint(uint32_t(value.size())) + value.size();
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() writes to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
   std::string dump() const;
   virtual void dump_to(std::string &out) const = 0;
@@ -268,7 +417,11 @@ class ProtoService {
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
     auto buffer = this->create_buffer();
+    // reserve once, encoding then never reallocates
+    buffer.get_buffer()->reserve(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -0,0 +1,84 @@
+#include "ring_buffer.h"
+#include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace api {
+
+void RingBuffer::init(size_t capacity) {
+  delete[] this->buffer_;
+  this->size_ = capacity + 1;
+  this->buffer_ = new uint8_t[this->size_];
+  this->head_ = 0;
+  this->tail_ = 0;
+}
+void RingBuffer::grow(size_t capacity) {
+  if (capacity <= this->capacity())
+    return;
+  const size_t available = this->available();
+  auto *buffer = new uint8_t[capacity + 1];
+  this->peek(0, buffer, available);
+  delete[] this->buffer_;
+  this->buffer_ = buffer;
+  this->size_ = capacity + 1;
+  this->tail_ = 0;
+  this->head_ = available;
+}
+size_t RingBuffer::available() const {
+  const size_t head = this->head_;
+  const size_t tail = this->tail_;
+  if (head >= tail)
+    return head - tail;
+  return this->size_ - tail + head;
+}
+bool HOT RingBuffer::write(const uint8_t *data, size_t len) {
+  if (len > this->space())
+    return false;
+
+  size_t head = this->head_;
+  const size_t first = std::min(len, this->size_ - head);
+  memcpy(this->buffer_ + head, data, first);
+  memcpy(this->buffer_, data + first, len - first);
+  head += len;
+  if (head >= this->size_)
+    head -= this->size_;
+  // Publish the data only after it has been copied (volatile accesses are serialized)
+  this->head_ = head;
+  return true;
+}
+size_t RingBuffer::peek(size_t offset, uint8_t *dst, size_t len) const {
+  const size_t available = this->available();
+  if (offset >= available)
+    return 0;
+  len = std::min(len, available - offset);
+
+  size_t pos = this->tail_ + offset;
+  if (pos >= this->size_)
+    pos -= this->size_;
+  const size_t first = std::min(len, this->size_ - pos);
+  memcpy(dst, this->buffer_ + pos, first);
+  memcpy(dst + first, this->buffer_, len - first);
+  return len;
+}
+uint8_t *RingBuffer::contiguous(size_t offset, size_t len) {
+  if (offset + len > this->available())
+    return nullptr;
+
+  size_t pos = this->tail_ + offset;
+  if (pos >= this->size_)
+    pos -= this->size_;
+  if (len > this->size_ - pos)
+    return nullptr;
+  return this->buffer_ + pos;
+}
+void RingBuffer::consume(size_t len) {
+  len = std::min(len, this->available());
+  size_t tail = this->tail_ + len;
+  if (tail >= this->size_)
+    tail -= this->size_;
+  this->tail_ = tail;
+}
+
+}  // namespace api
+}  // namespace esphome
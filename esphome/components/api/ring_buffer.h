@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace api {
+
+/** A fixed-capacity single-producer/single-consumer byte ring buffer.
+ *
+ * The producer (the TCP receive callback, which runs in the AsyncTCP task on the ESP32) only calls write() and only
+ * modifies head_, the consumer (the main loop) calls everything else and only modifies tail_. Readable data can be
+ * accessed in place with contiguous() as long as it does not wrap around the end of the storage.
+ */
+class RingBuffer {
+ public:
+  RingBuffer() = default;
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+  ~RingBuffer() { delete[] this->buffer_; }
+
+  /// Allocate the storage, must be called once before any other method.
+  void init(size_t capacity);
+  /// Enlarge the storage to hold at least capacity bytes, keeping the readable data. Must not run concurrently
+  /// with write().
+  void grow(size_t capacity);
+
+  /// The maximum number of bytes this buffer can hold.
+  size_t capacity() const { return this->size_ == 0 ? 0 : this->size_ - 1; }
+  /// The number of bytes that can be read.
+  size_t available() const;
+  /// The number of bytes that can be written.
+  size_t space() const { return this->capacity() - this->available(); }
+
+  /// Append len bytes. Either all bytes are written or, if there is not enough space, none.
+  bool write(const uint8_t *data, size_t len);
+  /// Copy up to len readable bytes starting at offset into dst without consuming them. Returns the number copied.
+  size_t peek(size_t offset, uint8_t *dst, size_t len) const;
+  /** Get a pointer to len readable bytes starting at offset.
+   *
+   * @return The pointer, or nullptr if the range is not readable or wraps around the end of the storage.
+   */
+  uint8_t *contiguous(size_t offset, size_t len);
+  /// Discard len readable bytes from the front.
+  void consume(size_t len);
+
+ protected:
+  uint8_t *buffer_{nullptr};
+  /// Storage size, one slot is always kept empty to distinguish a full buffer from an empty one.
+  size_t size_{0};
+  volatile size_t head_{0};
+  volatile size_t tail_{0};
+};
+
+}  // namespace api
+}  // namespace esphome
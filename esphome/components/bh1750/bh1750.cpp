@@ -65,7 +65,7 @@ void BH1750Sensor::update() {
       break;
   }
 
-  this->set_timeout("illuminance", wait, [this]() { this->read_data_(); });
+  this->set_timeout(fnv1_hash_static("illuminance"), wait, [this]() { this->read_data_(); });
 }
 
 float BH1750Sensor::get_setup_priority() const { return setup_priority::DATA; }
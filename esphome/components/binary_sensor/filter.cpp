@@ -27,9 +27,11 @@ void Filter::input(bool value, bool is_initial) {
 DelayedOnOffFilter::DelayedOnOffFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout(fnv1_hash_static("ON_OFF"), this->delay_,
+                      [this, is_initial]() { this->output(true, is_initial); });
   } else {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout(fnv1_hash_static("ON_OFF"), this->delay_,
+                      [this, is_initial]() { this->output(false, is_initial); });
   }
   return {};
 }
@@ -39,10 +41,10 @@ float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HA
 DelayedOnFilter::DelayedOnFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout(fnv1_hash_static("ON"), this->delay_, [this, is_initial]() { this->output(true, is_initial); });
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->cancel_timeout(fnv1_hash_static("ON"));
     return false;
   }
 }
@@ -52,10 +54,10 @@ float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDW
 DelayedOffFilter::DelayedOffFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout(fnv1_hash_static("OFF"), this->delay_, [this, is_initial]() { this->output(false, is_initial); });
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->cancel_timeout(fnv1_hash_static("OFF"));
     return true;
   }
 }
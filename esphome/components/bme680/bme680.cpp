@@ -239,7 +239,7 @@ void BME680Component::update() {
     return;
   }
 
-  this->set_timeout("data", this->calc_meas_duration_(), [this]() { this->read_data_(); });
+  this->set_timeout(fnv1_hash_static("data"), this->calc_meas_duration_(), [this]() { this->read_data_(); });
 }
 
 uint8_t BME680Component::calc_heater_resistance_(uint16_t temperature) {
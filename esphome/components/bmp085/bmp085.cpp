@@ -17,7 +17,7 @@ void BMP085Component::update() {
   if (!this->set_mode_(BMP085_CONTROL_MODE_TEMPERATURE))
     return;
 
-  this->set_timeout("temperature", 5, [this]() { this->read_temperature_(); });
+  this->set_timeout(fnv1_hash_static("temperature"), 5, [this]() { this->read_temperature_(); });
 }
 void BMP085Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up BMP085...");
@@ -86,7 +86,7 @@ void BMP085Component::read_temperature_() {
     return;
   }
 
-  this->set_timeout("pressure", 26, [this]() { this->read_pressure_(); });
+  this->set_timeout(fnv1_hash_static("pressure"), 26, [this]() { this->read_pressure_(); });
 }
 void BMP085Component::read_pressure_() {
   uint8_t buffer[3];
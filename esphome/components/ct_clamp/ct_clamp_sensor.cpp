@@ -7,11 +7,18 @@ namespace esphome {
 namespace ct_clamp {
 
 static const char *TAG = "ct_clamp";
+/// Samples are read in bursts of at most this many samples (or this many microseconds) and processed as a block.
+static const size_t CT_CLAMP_BURST_SIZE = 32;
+static const uint32_t CT_CLAMP_BURST_DURATION = 1000;
+/// Factor of the low pass filter for the DC offset, per sample.
+static const float CT_CLAMP_OFFSET_ALPHA = 0.001f;
 
 void CTClampSensor::setup() {
+  if (this->rms_window_ != 0)
+    this->rms_values_.reserve(this->sample_duration_ / this->rms_window_ + 1);
   this->is_calibrating_offset_ = true;
   this->high_freq_.start();
-  this->set_timeout("calibrate_offset", this->sample_duration_, [this]() {
+  this->set_timeout(fnv1_hash_static("calibrate_offset"), this->sample_duration_, [this]() {
     this->high_freq_.stop();
     this->is_calibrating_offset_ = false;
     if (this->num_samples_ != 0) {
@@ -23,6 +30,8 @@ void CTClampSensor::setup() {
 void CTClampSensor::dump_config() {
   LOG_SENSOR("", "CT Clamp Sensor", this);
   ESP_LOGCONFIG(TAG, "  Sample Duration: %.2fs", this->sample_duration_ / 1e3f);
+  if (this->rms_window_ != 0)
+    ESP_LOGCONFIG(TAG, "  RMS Window: %ums", this->rms_window_);
   LOG_UPDATE_INTERVAL(this);
 }
 
@@ -36,54 +45,77 @@ void CTClampSensor::update() {
   this->high_freq_.start();
 
   // Set timeout for ending sampling phase
-  this->set_timeout("read", this->sample_duration_, [this]() {
+  this->set_timeout(fnv1_hash_static("read"), this->sample_duration_, [this]() {
     this->is_sampling_ = false;
     this->high_freq_.stop();
+    // the last window ends with the sampling phase
+    this->finish_window_();
 
-    if (this->num_samples_ == 0) {
+    if (this->rms_values_.empty()) {
       // Shouldn't happen, but let's not crash if it does.
       this->publish_state(NAN);
       return;
     }
 
-    float raw = this->sample_sum_ / this->num_samples_;
-    float irms = std::sqrt(raw);
-    ESP_LOGD(TAG, "'%s' - Raw Value: %.2fA", this->name_.c_str(), irms);
-    this->publish_state(irms);
+    ESP_LOGD(TAG, "'%s' - Raw Value: %.2fA", this->name_.c_str(), this->rms_values_.back());
+    const uint32_t period = this->rms_window_ != 0 ? this->rms_window_ : this->sample_duration_;
+    this->publish_samples(this->rms_values_.data(), this->rms_values_.size(), period * 1000);
   });
 
   // Set sampling values
   this->is_sampling_ = true;
   this->num_samples_ = 0;
   this->sample_sum_ = 0.0f;
+  this->window_start_ = millis();
+  this->rms_values_.clear();
+}
+
+void CTClampSensor::finish_window_() {
+  if (this->num_samples_ != 0)
+    this->rms_values_.push_back(std::sqrt(this->sample_sum_ / this->num_samples_));
+  this->num_samples_ = 0;
+  this->sample_sum_ = 0.0f;
+  this->window_start_ = millis();
 }
 
 void CTClampSensor::loop() {
   if (!this->is_sampling_ && !this->is_calibrating_offset_)
     return;
 
-  // Perform a single sample
-  float value = this->source_->sample();
-  if (isnan(value))
+  // Read a burst of samples
+  float samples[CT_CLAMP_BURST_SIZE];
+  size_t n = 0;
+  const uint32_t start = micros();
+  do {
+    float value = this->source_->sample();
+    if (!isnan(value))
+      samples[n++] = value;
+  } while (n < CT_CLAMP_BURST_SIZE && micros() - start < CT_CLAMP_BURST_DURATION);
+  if (n == 0)
     return;
+  const float sum = sensor::sum_values(samples, n);
 
   if (this->is_calibrating_offset_) {
-    this->sample_sum_ += value;
-    this->num_samples_++;
+    this->sample_sum_ += sum;
+    this->num_samples_ += n;
     return;
   }
 
-  // Adjust DC offset via low pass filter (exponential moving average)
-  const float alpha = 0.001f;
-  this->offset_ = this->offset_ * (1 - alpha) + value * alpha;
-
-  // Filtered value centered around the mid-point (0V)
-  float filtered = value - this->offset_;
+  // Filtered values centered around the mid-point (0V), with the DC offset from before the burst
+  for (size_t i = 0; i < n; i++)
+    samples[i] -= this->offset_;
 
   // IRMS is sqrt(∑v_i²)
-  float sq = filtered * filtered;
-  this->sample_sum_ += sq;
-  this->num_samples_++;
+  this->sample_sum_ += sensor::sum_squares(samples, n);
+  this->num_samples_ += n;
+
+  // Adjust DC offset via low pass filter (exponential moving average), applied to the mean of the burst as if the
+  // filter was applied to every sample
+  const float alpha = 1.0f - powf(1.0f - CT_CLAMP_OFFSET_ALPHA, n);
+  this->offset_ += (sum / n - this->offset_) * alpha;
+
+  if (this->rms_window_ != 0 && millis() - this->window_start_ >= this->rms_window_)
+    this->finish_window_();
 }
 
 }  // namespace ct_clamp
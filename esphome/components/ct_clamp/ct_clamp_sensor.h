@@ -20,14 +20,20 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
   }
 
   void set_sample_duration(uint32_t sample_duration) { sample_duration_ = sample_duration; }
+  void set_rms_window(uint32_t rms_window) { rms_window_ = rms_window; }
   void set_source(voltage_sampler::VoltageSampler *source) { source_ = source; }
 
  protected:
+  /// Finish the current RMS window and start the next one.
+  void finish_window_();
+
   /// High Frequency loop() requester used during sampling phase.
   HighFrequencyLoopRequester high_freq_;
 
   /// Duration in ms of the sampling phase.
   uint32_t sample_duration_;
+  /// Duration in ms of the windows an RMS value is published for, 0 for one value for the whole sampling phase.
+  uint32_t rms_window_{0};
   /// The sampling source to read values from.
   voltage_sampler::VoltageSampler *source_;
 
@@ -43,6 +49,9 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
 
   float sample_sum_ = 0.0f;
   uint32_t num_samples_ = 0;
+  uint32_t window_start_ = 0;
+  /// RMS values of the finished windows of the current sampling phase, published as one block.
+  std::vector<float> rms_values_;
   bool is_sampling_ = false;
   /// Calibrate offset value once at boot
   bool is_calibrating_offset_ = false;
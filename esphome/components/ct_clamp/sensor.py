@@ -6,15 +6,25 @@ from esphome.const import CONF_SENSOR, CONF_ID, ICON_FLASH, UNIT_AMPERE
 AUTO_LOAD = ['voltage_sampler']
 
 CONF_SAMPLE_DURATION = 'sample_duration'
+CONF_RMS_WINDOW = 'rms_window'
 
 ct_clamp_ns = cg.esphome_ns.namespace('ct_clamp')
 CTClampSensor = ct_clamp_ns.class_('CTClampSensor', sensor.Sensor, cg.PollingComponent)
 
-CONFIG_SCHEMA = sensor.sensor_schema(UNIT_AMPERE, ICON_FLASH, 2).extend({
+
+def validate_rms_window(config):
+    if CONF_RMS_WINDOW in config and config[CONF_RMS_WINDOW] > config[CONF_SAMPLE_DURATION]:
+        raise cv.Invalid("{} must not be longer than {}".format(CONF_RMS_WINDOW, CONF_SAMPLE_DURATION))
+    return config
+
+
+CONFIG_SCHEMA = cv.All(sensor.sensor_schema(UNIT_AMPERE, ICON_FLASH, 2).extend({
     cv.GenerateID(): cv.declare_id(CTClampSensor),
     cv.Required(CONF_SENSOR): cv.use_id(voltage_sampler.VoltageSampler),
     cv.Optional(CONF_SAMPLE_DURATION, default='200ms'): cv.positive_time_period_milliseconds,
-}).extend(cv.polling_component_schema('60s'))
+    # Publish one RMS value per window as a block instead of one for the whole sampling phase
+    cv.Optional(CONF_RMS_WINDOW): cv.positive_time_period_milliseconds,
+}).extend(cv.polling_component_schema('60s')), validate_rms_window)
 
 
 def to_code(config):
@@ -25,3 +35,5 @@ def to_code(config):
     sens = yield cg.get_variable(config[CONF_SENSOR])
     cg.add(var.set_source(sens))
     cg.add(var.set_sample_duration(config[CONF_SAMPLE_DURATION]))
+    if CONF_RMS_WINDOW in config:
+        cg.add(var.set_rms_window(config[CONF_RMS_WINDOW]))
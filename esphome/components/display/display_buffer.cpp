@@ -3,14 +3,26 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace display {
 
 static const char *TAG = "display";
 
+/// Size of the tiles update_dirty_window_() compares, a multiple of 8 rows for page based displays.
+static const int DIRTY_TILE_SIZE = 16;
+
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(1, 1, 1, 1);
 
+static Color color_from_rgb_565(uint16_t color565) {
+  const uint8_t r = (color565 >> 11) & 0x1F;
+  const uint8_t g = (color565 >> 5) & 0x3F;
+  const uint8_t b = color565 & 0x1F;
+  return Color((uint32_t(r << 3 | r >> 2) << 16) | (uint32_t(g << 2 | g >> 4) << 8) | (b << 3 | b >> 2));
+}
+
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   this->buffer_ = new uint8_t[buffer_length];
   if (this->buffer_ == nullptr) {
@@ -18,6 +30,78 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
     return;
   }
   this->clear();
+  if (this->double_buffer_) {
+    this->back_buffer_ = new uint8_t[buffer_length];
+    if (this->back_buffer_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate second buffer for display, using a single one!");
+    } else {
+      memcpy(this->back_buffer_, this->buffer_, buffer_length);
+    }
+  }
+  // nothing is known about what the display itself shows yet
+  this->mark_dirty_(0, 0, this->get_width_internal(), this->get_height_internal());
+}
+void DisplayBuffer::reset_dirty_() {
+  this->dirty_x_low_ = INT_MAX;
+  this->dirty_y_low_ = INT_MAX;
+  this->dirty_x_high_ = -1;
+  this->dirty_y_high_ = -1;
+}
+bool DisplayBuffer::update_dirty_window_() {
+  if (!this->is_dirty_())
+    return false;
+  const int width = this->get_width_internal();
+  const int height = this->get_height_internal();
+  const int tiles_x = (width + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+  const bool first = this->tile_hashes_.empty();
+  if (first)
+    this->tile_hashes_.resize(tiles_x * ((height + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE));
+
+  // only tiles in the dirty window can have changed, they are compared by hashing their part of the buffer
+  const int tile_x1 = this->dirty_x_low_ / DIRTY_TILE_SIZE;
+  const int tile_x2 = this->dirty_x_high_ / DIRTY_TILE_SIZE;
+  const int tile_y1 = this->dirty_y_low_ / DIRTY_TILE_SIZE;
+  const int tile_y2 = this->dirty_y_high_ / DIRTY_TILE_SIZE;
+  size_t offset, length, rows, stride;
+  if (!this->get_buffer_window_internal(0, 0, 1, 1, &offset, &length, &rows, &stride))
+    return true;  // the driver doesn't describe its buffer, keep the whole window
+  this->reset_dirty_();
+  for (int tile_y = tile_y1; tile_y <= tile_y2; tile_y++) {
+    for (int tile_x = tile_x1; tile_x <= tile_x2; tile_x++) {
+      const int x = tile_x * DIRTY_TILE_SIZE;
+      const int y = tile_y * DIRTY_TILE_SIZE;
+      const int tile_width = std::min(DIRTY_TILE_SIZE, width - x);
+      const int tile_height = std::min(DIRTY_TILE_SIZE, height - y);
+      this->get_buffer_window_internal(x, y, tile_width, tile_height, &offset, &length, &rows, &stride);
+      // 64-bit FNV-1a, a collision leaves a stale tile and with 32 bits colliding contents are easy to come by
+      uint64_t hash = 14695981039346656037ULL;
+      for (const uint8_t *row = this->buffer_ + offset; rows > 0; rows--, row += stride) {
+        for (size_t i = 0; i < length; i++) {
+          hash ^= row[i];
+          hash *= 1099511628211ULL;
+        }
+      }
+      uint64_t &tile_hash = this->tile_hashes_[tile_y * tiles_x + tile_x];
+      if (first || hash != tile_hash) {
+        tile_hash = hash;
+        this->mark_dirty_(x, y, tile_width, tile_height);
+      }
+    }
+  }
+  return this->is_dirty_();
+}
+bool DisplayBuffer::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset,
+                                               size_t *length, size_t *rows, size_t *stride) {
+  return false;
+}
+const uint8_t *DisplayBuffer::swap_buffers_() {
+  const uint8_t *front = this->buffer_;
+  if (this->back_buffer_ == nullptr) {
+    this->reset_dirty_();
+    return front;
+  }
+  std::swap(this->buffer_, this->back_buffer_);
+  return front;
 }
 void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
@@ -85,14 +169,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->filled_rectangle(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->filled_rectangle(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -100,12 +180,248 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1, y1, height, color);
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
-void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+void HOT DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  if (!this->clip_(&x1, &y1, &width, &height))
+    return;
+  this->fill_clipped_(x1, y1, width, height, color);
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::fill_span(int x, int y, int width, Color color) {
+  this->filled_rectangle(x, y, width, 1, color);
+}
+bool DisplayBuffer::clip_(int *x1, int *y1, int *width, int *height) {
+  const int x2 = std::min(*x1 + *width, this->get_width());
+  const int y2 = std::min(*y1 + *height, this->get_height());
+  *x1 = std::max(*x1, 0);
+  *y1 = std::max(*y1, 0);
+  *width = x2 - *x1;
+  *height = y2 - *y1;
+  return *width > 0 && *height > 0;
+}
+void HOT DisplayBuffer::rotate_rectangle_(int *x1, int *y1, int *width, int *height) {
+  // the same mapping as draw_pixel_at(), applied to the corners
+  const int x = *x1, y = *y1, w = *width, h = *height;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      *x1 = this->get_width_internal() - y - h;
+      *y1 = x;
+      *width = h;
+      *height = w;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      *x1 = this->get_width_internal() - x - w;
+      *y1 = this->get_height_internal() - y - h;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      *x1 = y;
+      *y1 = this->get_height_internal() - x - w;
+      *width = h;
+      *height = w;
+      break;
+  }
+}
+void HOT DisplayBuffer::fill_clipped_(int x1, int y1, int width, int height, Color color) {
+  this->rotate_rectangle_(&x1, &y1, &width, &height);
+  this->fill_absolute_rectangle_internal(x1, y1, width, height, color);
+}
+void HOT DisplayBuffer::fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) {
+  for (int y = y1; y < y1 + height; y++)
+    for (int x = x1; x < x1 + width; x++)
+      this->draw_absolute_pixel_internal(x, y, color);
+}
+void HOT DisplayBuffer::draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length,
+                                                 const uint8_t *data) {
+  for (int i = 0; i < length; i++) {
+    const uint16_t color565 = (pgm_read_byte(data) << 8) | pgm_read_byte(data + 1);
+    this->draw_absolute_pixel_internal(x1, y1, color_from_rgb_565(color565));
+    x1 += step_x;
+    y1 += step_y;
+    data += 2;
+  }
+}
+void HOT DisplayBuffer::fill_page_buffer_(int x1, int y1, int width, int height, Color color) {
+  // each byte is a column of 8 pixels, fill page by page
+  const bool on = color.is_on();
+  for (int y = y1; y < y1 + height;) {
+    const int page_end = std::min((y / 8 + 1) * 8, y1 + height);
+    const uint8_t mask = (0xFF << (y % 8)) & (0xFF >> (8 - (page_end - (y / 8) * 8)));
+    uint8_t *pos = this->buffer_ + x1 + (y / 8) * this->get_width_internal();
+    int first = -1, last = -1;
+    for (int i = 0; i < width; i++, pos++) {
+      const uint8_t value = on ? (*pos | mask) : (*pos & ~mask);
+      if (value == *pos)
+        continue;
+      *pos = value;
+      if (first == -1)
+        first = i;
+      last = i;
+    }
+    if (first != -1)
+      this->mark_dirty_(x1 + first, y, last - first + 1, page_end - y);
+    y = page_end;
+  }
+}
+void HOT DisplayBuffer::fill_rgb565_buffer_(int x1, int y1, int width, int height, Color color) {
+  const uint16_t color565 = color.to_rgb_565();
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
+  for (int y = y1; y < y1 + height; y++) {
+    uint8_t *row = this->buffer_ + (x1 + y * this->get_width_internal()) * 2;
+    // only the part of the row between the first and the last changed pixel is written
+    int first = 0;
+    while (first < width && row[first * 2] == high && row[first * 2 + 1] == low)
+      first++;
+    if (first == width)
+      continue;
+    int last = width - 1;
+    while (row[last * 2] == high && row[last * 2 + 1] == low)
+      last--;
+    this->mark_dirty_(x1 + first, y, last - first + 1, 1);
+
+    uint8_t *pos = row + first * 2;
+    if (high == low) {
+      memset(pos, high, (last - first + 1) * 2);
+      continue;
+    }
+    for (int i = first; i <= last; i++) {
+      *pos++ = high;
+      *pos++ = low;
+    }
   }
 }
+void HOT DisplayBuffer::draw_rgb565_buffer_run_(int x1, int y1, int step_x, int step_y, int length,
+                                                const uint8_t *data) {
+  // the buffer is in the same format, copy the pixels and mark the changed part
+  uint8_t *pos = this->buffer_ + (x1 + y1 * this->get_width_internal()) * 2;
+  const int pos_step = (step_x + step_y * this->get_width_internal()) * 2;
+  int first = -1, last = -1;
+  for (int i = 0; i < length; i++, pos += pos_step, data += 2) {
+    const uint8_t high = pgm_read_byte(data);
+    const uint8_t low = pgm_read_byte(data + 1);
+    if (pos[0] == high && pos[1] == low)
+      continue;
+    pos[0] = high;
+    pos[1] = low;
+    if (first == -1)
+      first = i;
+    last = i;
+  }
+  if (first == -1)
+    return;
+  this->mark_dirty_(x1 + first * step_x, y1 + first * step_y);
+  this->mark_dirty_(x1 + last * step_x, y1 + last * step_y);
+}
+void DisplayBuffer::blit(int x, int y, int width, int height, const uint8_t *data, Color color) {
+  const Color colors[2] = {COLOR_OFF, color};
+  this->blit_(x, y, width, height, data, 1, colors, true);
+}
+void DisplayBuffer::blit(int x, int y, int width, int height, const uint8_t *data, Color color, Color background) {
+  const Color colors[2] = {background, color};
+  this->blit_(x, y, width, height, data, 1, colors, false);
+}
+void DisplayBuffer::blit_alpha(int x, int y, int width, int height, const uint8_t *data, uint8_t bpp, Color color,
+                               Color background) {
+  // pixels must not cross byte boundaries
+  if (bpp == 0 || bpp > 8 || 8 % bpp != 0)
+    return;
+  this->blit_(x, y, width, height, data, bpp, this->get_alpha_lut_(bpp, color, background), true);
+}
+const Color *DisplayBuffer::get_alpha_lut_(uint8_t bpp, Color color, Color background) {
+  const uint32_t levels = 1u << bpp;
+  if (this->alpha_lut_.size() == levels && this->alpha_lut_color_.raw_32 == color.raw_32 &&
+      this->alpha_lut_background_.raw_32 == background.raw_32)
+    return this->alpha_lut_.data();
+
+  this->alpha_lut_.resize(levels);
+  this->alpha_lut_color_ = color;
+  this->alpha_lut_background_ = background;
+  const uint32_t max = levels - 1;
+  for (uint32_t alpha = 0; alpha < levels; alpha++) {
+    for (uint8_t i = 0; i < 4; i++)
+      this->alpha_lut_[alpha].raw[i] = (background.raw[i] * (max - alpha) + color.raw[i] * alpha + max / 2) / max;
+  }
+  return this->alpha_lut_.data();
+}
+void DisplayBuffer::rotation_steps_(int *step_x_x, int *step_x_y, int *step_y_x, int *step_y_y) {
+  *step_x_x = 1;
+  *step_x_y = 0;
+  *step_y_x = 0;
+  *step_y_y = 1;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      *step_x_x = 0;
+      *step_x_y = 1;
+      *step_y_x = -1;
+      *step_y_y = 0;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      *step_x_x = -1;
+      *step_y_y = -1;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      *step_x_x = 0;
+      *step_x_y = -1;
+      *step_y_x = 1;
+      *step_y_y = 0;
+      break;
+  }
+}
+void HOT DisplayBuffer::blit_(int x, int y, int width, int height, const uint8_t *data, uint8_t bpp,
+                              const Color *colors, bool transparent) {
+  const int stride = (width * bpp + 7) / 8;
+  const uint8_t mask = (1 << bpp) - 1;
+  int x1 = x, y1 = y;
+  if (!this->clip_(&x1, &y1, &width, &height))
+    return;
+  const int src_x = x1 - x;
+  const int src_y = y1 - y;
+
+  // resolve the rotation once: where the first pixel ends up and the steps along the bitmap's x and y axes
+  int abs_x1 = x1, abs_y1 = y1, abs_width = 1, abs_height = 1;
+  this->rotate_rectangle_(&abs_x1, &abs_y1, &abs_width, &abs_height);
+  int step_x_x, step_x_y, step_y_x, step_y_y;
+  this->rotation_steps_(&step_x_x, &step_x_y, &step_y_x, &step_y_y);
+
+  for (int row = 0; row < height; row++) {
+    const uint8_t *src = data + (src_y + row) * stride;
+    const int abs_x = abs_x1 + row * step_y_x;
+    const int abs_y = abs_y1 + row * step_y_y;
+    int col = 0;
+    while (col < width) {
+      // find the run of equal pixels starting at col
+      const int start = col;
+      int bit = (src_x + col) * bpp;
+      const uint8_t value = (pgm_read_byte(src + bit / 8) >> (8 - bpp - bit % 8)) & mask;
+      do {
+        col++;
+        bit += bpp;
+      } while (col < width && ((pgm_read_byte(src + bit / 8) >> (8 - bpp - bit % 8)) & mask) == value);
+
+      if (value == 0 && transparent)
+        continue;
+      const Color &run_color = colors[value];
+      int run_x = abs_x + start * step_x_x;
+      int run_y = abs_y + start * step_x_y;
+      const int length = col - start;
+      if (length == 1) {
+        this->draw_absolute_pixel_internal(run_x, run_y, run_color);
+      } else if (step_x_x != 0) {
+        if (step_x_x < 0)
+          run_x -= length - 1;
+        this->fill_absolute_rectangle_internal(run_x, run_y, length, 1, run_color);
+      } else {
+        if (step_x_y < 0)
+          run_y -= length - 1;
+        this->fill_absolute_rectangle_internal(run_x, run_y, 1, length, run_color);
+      }
+    }
+  }
+  App.feed_wdt();
+}
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
   int dy = 0;
@@ -157,6 +473,10 @@ void DisplayBuffer::filled_circle(int center_x, int center_y, int radius, Color
 }
 
 void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align, const char *text) {
+  this->print(x, y, font, color, COLOR_OFF, align, text);
+}
+void DisplayBuffer::print(int x, int y, Font *font, Color color, Color background, TextAlign align,
+                          const char *text) {
   int x_start, y_start;
   int width, height;
   this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
@@ -171,9 +491,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].width_;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->filled_rectangle(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -185,13 +503,11 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     int scan_x1, scan_y1, scan_width, scan_height;
     glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
 
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    if (glyph.bpp_ == 1)
+      this->blit(x_at + scan_x1, y_start + scan_y1, scan_width, scan_height, glyph.data_, color);
+    else
+      this->blit_alpha(x_at + scan_x1, y_start + scan_y1, scan_width, scan_height, glyph.data_, glyph.bpp_, color,
+                       background);
 
     x_at += glyph.width_ + glyph.offset_x_;
 
@@ -207,27 +523,44 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 void DisplayBuffer::image(int x, int y, Image *image) { this->image(x, y, COLOR_ON, image); }
 void DisplayBuffer::image(int x, int y, Color color, Image *image, bool invert) {
   if (image->get_type() == BINARY) {
-    for (int img_x = 0; img_x < image->get_width(); img_x++) {
-      for (int img_y = 0; img_y < image->get_height(); img_y++) {
-        if (invert)
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? COLOR_OFF : color);
-        else
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color : COLOR_OFF);
-      }
-    }
-  } else if (image->get_type() == GRAYSCALE) {
-    for (int img_x = 0; img_x < image->get_width(); img_x++) {
-      for (int img_y = 0; img_y < image->get_height(); img_y++) {
-        this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-      }
+    if (invert)
+      this->blit(x, y, image->get_width(), image->get_height(), image->data_start_, COLOR_OFF, color);
+    else
+      this->blit(x, y, image->get_width(), image->get_height(), image->data_start_, color, COLOR_OFF);
+    return;
+  }
+
+  int x1 = x, y1 = y, width = image->get_width(), height = image->get_height();
+  if (!this->clip_(&x1, &y1, &width, &height))
+    return;
+  // resolve the rotation once: the position of the first pixel and the steps along the image's x and y axes
+  int abs_x1 = x1, abs_y1 = y1, abs_width = 1, abs_height = 1;
+  this->rotate_rectangle_(&abs_x1, &abs_y1, &abs_width, &abs_height);
+  int step_x_x, step_x_y, step_y_x, step_y_y;
+  this->rotation_steps_(&step_x_x, &step_x_y, &step_y_x, &step_y_y);
+
+  for (int img_y = y1 - y; img_y < y1 - y + height; img_y++) {
+    if (image->get_type() == RGB565) {
+      // stored in the format of most color displays, drivers can copy the rows directly
+      const uint8_t *row = image->data_start_ + (img_y * image->get_width() + x1 - x) * 2;
+      this->draw_rgb565_run_internal(abs_x1, abs_y1, step_x_x, step_x_y, width, row);
+      abs_x1 += step_y_x;
+      abs_y1 += step_y_y;
+      continue;
     }
-  } else if (image->get_type() == RGB) {
-    for (int img_x = 0; img_x < image->get_width(); img_x++) {
-      for (int img_y = 0; img_y < image->get_height(); img_y++) {
-        this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
-      }
+    int abs_x = abs_x1, abs_y = abs_y1;
+    for (int img_x = x1 - x; img_x < x1 - x + width; img_x++) {
+      if (image->get_type() == GRAYSCALE)
+        this->draw_absolute_pixel_internal(abs_x, abs_y, image->get_grayscale_pixel(img_x, img_y));
+      else
+        this->draw_absolute_pixel_internal(abs_x, abs_y, image->get_color_pixel(img_x, img_y));
+      abs_x += step_x_x;
+      abs_y += step_x_y;
     }
+    abs_x1 += step_y_x;
+    abs_y1 += step_y_y;
   }
+  App.feed_wdt();
 }
 void DisplayBuffer::get_text_bounds(int x, int y, const char *text, Font *font, TextAlign align, int *x1, int *y1,
                                     int *width, int *height) {
@@ -344,34 +677,37 @@ void DisplayBuffer::strftime(int x, int y, Font *font, const char *format, time:
 #endif
 
 Glyph::Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-             int height)
+             int height, uint8_t bpp)
     : char_(a_char),
       data_(data_start + offset),
       offset_x_(offset_x),
       offset_y_(offset_y),
       width_(width),
-      height_(height) {}
+      height_(height),
+      bpp_(bpp) {}
 bool Glyph::get_pixel(int x, int y) const {
   const int x_data = x - this->offset_x_;
   const int y_data = y - this->offset_y_;
   if (x_data < 0 || x_data >= this->width_ || y_data < 0 || y_data >= this->height_)
     return false;
-  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
-  const uint32_t pos = x_data + y_data * width_8;
-  return pgm_read_byte(this->data_ + (pos / 8u)) & (0x80 >> (pos % 8u));
+  const uint32_t width_8 = ((this->width_ * this->bpp_ + 7u) / 8u) * 8u;
+  const uint32_t pos = x_data * this->bpp_ + y_data * width_8;
+  const uint8_t mask = (1 << this->bpp_) - 1;
+  return (pgm_read_byte(this->data_ + (pos / 8u)) >> (8u - this->bpp_ - pos % 8u)) & mask;
 }
 const char *Glyph::get_char() const { return this->char_; }
 bool Glyph::compare_to(const char *str) const {
   // 1 -> this->char_
   // 2 -> str
+  // glyphs are sorted by their UTF-8 bytes, compare unsigned like the code generator does
   for (uint32_t i = 0;; i++) {
     if (this->char_[i] == '\0')
       return true;
     if (str[i] == '\0')
       return false;
-    if (this->char_[i] > str[i])
+    if (uint8_t(this->char_[i]) > uint8_t(str[i]))
       return false;
-    if (this->char_[i] < str[i])
+    if (uint8_t(this->char_[i]) < uint8_t(str[i]))
       return true;
   }
   // this should not happen
@@ -393,7 +729,53 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *width = this->width_;
   *height = this->height_;
 }
+void Font::set_glyph_table(uint32_t first_codepoint, const uint16_t *table, uint32_t size) {
+  this->glyph_table_first_ = first_codepoint;
+  this->glyph_table_ = table;
+  this->glyph_table_size_ = size;
+}
 int Font::match_next_glyph(const char *str, int *match_length) {
+  if (this->glyph_table_ == nullptr)
+    return this->search_glyph_(str, match_length);
+
+  // decode the first UTF-8 code point
+  const auto *bytes = reinterpret_cast<const uint8_t *>(str);
+  uint32_t codepoint;
+  int length;
+  if (bytes[0] < 0x80) {
+    codepoint = bytes[0];
+    length = 1;
+  } else if ((bytes[0] & 0xE0) == 0xC0) {
+    codepoint = bytes[0] & 0x1F;
+    length = 2;
+  } else if ((bytes[0] & 0xF0) == 0xE0) {
+    codepoint = bytes[0] & 0x0F;
+    length = 3;
+  } else if ((bytes[0] & 0xF8) == 0xF0) {
+    codepoint = bytes[0] & 0x07;
+    length = 4;
+  } else {
+    return this->search_glyph_(str, match_length);
+  }
+  for (int i = 1; i < length; i++) {
+    if ((bytes[i] & 0xC0) != 0x80)
+      return this->search_glyph_(str, match_length);
+    codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+  }
+  // overlong encodings never match a glyph
+  if ((length == 2 && codepoint < 0x80) || (length == 3 && codepoint < 0x800) || (length == 4 && codepoint < 0x10000))
+    return this->search_glyph_(str, match_length);
+
+  const uint32_t index = codepoint - this->glyph_table_first_;
+  if (index >= this->glyph_table_size_)
+    return this->search_glyph_(str, match_length);
+  const uint16_t entry = pgm_read_word(this->glyph_table_ + index);
+  if (entry == GLYPH_TABLE_SEARCH)
+    return this->search_glyph_(str, match_length);
+  *match_length = length;
+  return int(entry) - 1;
+}
+int Font::search_glyph_(const char *str, int *match_length) {
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -411,6 +793,22 @@ int Font::match_next_glyph(const char *str, int *match_length) {
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
   *baseline = this->baseline_;
   *height = this->bottom_;
+
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  uint32_t length = 0;
+  for (; str[length] != '\0'; length++) {
+    hash ^= uint8_t(str[length]);
+    hash *= 16777619UL;
+  }
+  for (auto &entry : this->measure_cache_) {
+    if (entry.hash == hash && entry.text.size() == length && memcmp(entry.text.data(), str, length) == 0) {
+      *width = entry.width;
+      *x_offset = entry.x_offset;
+      return;
+    }
+  }
+
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -438,6 +836,15 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   }
   *x_offset = min_x;
   *width = x - min_x;
+
+  if (length == 0)
+    return;
+  MeasureCacheEntry &entry = this->measure_cache_[this->measure_cache_next_];
+  this->measure_cache_next_ = (this->measure_cache_next_ + 1) % MEASURE_CACHE_SIZE;
+  entry.hash = hash;
+  entry.text.assign(str, length);
+  entry.width = *width;
+  entry.x_offset = *x_offset;
 }
 const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(std::vector<Glyph> &&glyphs, int baseline, int bottom)
@@ -453,6 +860,10 @@ bool Image::get_pixel(int x, int y) const {
 Color Image::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return 0;
+  if (this->type_ == RGB565) {
+    const uint8_t *data = this->data_start_ + (x + y * this->width_) * 2;
+    return color_from_rgb_565((pgm_read_byte(data) << 8) | pgm_read_byte(data + 1));
+  }
   const uint32_t pos = (x + y * this->width_) * 3;
   const uint32_t color32 = (pgm_read_byte(this->data_start_ + pos + 2) << 0) |
                            (pgm_read_byte(this->data_start_ + pos + 1) << 8) |
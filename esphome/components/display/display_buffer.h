@@ -5,6 +5,9 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/color.h"
 
+#include <algorithm>
+#include <climits>
+
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
 #endif
@@ -68,7 +71,7 @@ extern const Color COLOR_OFF;
 /// Turn the pixel ON.
 extern const Color COLOR_ON;
 
-enum ImageType { BINARY = 0, GRAYSCALE = 1, RGB = 2 };
+enum ImageType { BINARY = 0, GRAYSCALE = 1, RGB = 2, RGB565 = 3 };
 
 enum DisplayRotation {
   DISPLAY_ROTATION_0_DEGREES = 0,
@@ -121,6 +124,35 @@ class DisplayBuffer {
   /// Fill a rectangle with the top left point at [x1,y1] and the bottom right point at [x1+width,y1+height].
   void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON);
 
+  /// Fill the horizontal span from the point [x,y] to [x+width,y] with the given color.
+  void fill_span(int x, int y, int width, Color color = COLOR_ON);
+
+  /** Draw a 1-bit bitmap with the top left at [x,y].
+   *
+   * The rows of the bitmap start at a byte boundary and the bits are stored MSB first, the same format the
+   * font and image code generation uses. The data may be in flash (PROGMEM). Clipping and rotation are
+   * resolved once and runs of pixels are drawn with a single fill.
+   *
+   * @param x The x coordinate of the upper left corner.
+   * @param y The y coordinate of the upper left corner.
+   * @param width The width of the bitmap in pixels.
+   * @param height The height of the bitmap in pixels.
+   * @param data The bitmap data.
+   * @param color The color to draw set pixels with, unset pixels are left untouched.
+   */
+  void blit(int x, int y, int width, int height, const uint8_t *data, Color color = COLOR_ON);
+  /// Same as above, but draw unset pixels with the background color.
+  void blit(int x, int y, int width, int height, const uint8_t *data, Color color, Color background);
+
+  /** Draw an anti-aliased bitmap with bpp (1, 2, 4 or 8) bits of alpha per pixel with the top left at [x,y].
+   *
+   * Stored like the 1-bit bitmaps of blit(), with each pixel taking bpp bits. The buffer can't be read back, so
+   * pixels are blended between background and color, which should therefore be the color the bitmap is drawn on.
+   * Pixels with an alpha of 0 are left untouched. The blended colors are kept in a lookup table between calls.
+   */
+  void blit_alpha(int x, int y, int width, int height, const uint8_t *data, uint8_t bpp, Color color,
+                  Color background = COLOR_OFF);
+
   /// Draw the outline of a circle centered around [center_x,center_y] with the radius radius with the given color.
   void circle(int center_x, int center_xy, int radius, Color color = COLOR_ON);
 
@@ -138,6 +170,18 @@ class DisplayBuffer {
    */
   void print(int x, int y, Font *font, Color color, TextAlign align, const char *text);
 
+  /** Print `text` with the anchor point at [x,y] with `font`, blending anti-aliased fonts with `background`.
+   *
+   * @param x The x coordinate of the text alignment anchor point.
+   * @param y The y coordinate of the text alignment anchor point.
+   * @param font The font to draw the text with.
+   * @param color The color to draw the text with.
+   * @param background The color the text is drawn on.
+   * @param align The alignment of the text.
+   * @param text The text to draw.
+   */
+  void print(int x, int y, Font *font, Color color, Color background, TextAlign align, const char *text);
+
   /** Print `text` with the top left at [x,y] with `font`.
    *
    * @param x The x coordinate of the upper left corner.
@@ -293,20 +337,115 @@ class DisplayBuffer {
   /// Internal method to set the display rotation with.
   void set_rotation(DisplayRotation rotation);
 
+  /// Render into a second buffer while the first one is being sent, for drivers that flush asynchronously.
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
+
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill a rectangle of the display, drivers can override this to write their buffer format directly.
+   *
+   * The coordinates are in the orientation of the display itself (rotation is already applied), the
+   * rectangle is clipped to the display and not empty.
+   */
+  virtual void fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color);
+
+  /** Draw length big endian RGB565 pixels from data (which may be in flash), the first one at [x1,y1].
+   *
+   * Each following pixel is [step_x,step_y] from the previous one, in the orientation of the display itself. All
+   * pixels are on the display. Drivers with an RGB565 buffer can override this to copy the data directly.
+   */
+  virtual void draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
 
   void init_internal_(uint32_t buffer_length);
 
+  /// Clip a rectangle to the display, returns false if nothing of it is visible.
+  bool clip_(int *x1, int *y1, int *width, int *height);
+  /// Map a clipped rectangle to the orientation of the display itself.
+  void rotate_rectangle_(int *x1, int *y1, int *width, int *height);
+  /// Fill a clipped rectangle.
+  void fill_clipped_(int x1, int y1, int width, int height, Color color);
+  /// How the display's own coordinates change when stepping along the rotated x and y axes.
+  void rotation_steps_(int *step_x_x, int *step_x_y, int *step_y_x, int *step_y_y);
+  /// Draw a bitmap with bpp bits per pixel, using colors[value] for each pixel value. Transparent skips 0 values.
+  void blit_(int x, int y, int width, int height, const uint8_t *data, uint8_t bpp, const Color *colors,
+             bool transparent);
+  /// The colors for each alpha value with bpp bits, blended from background to color.
+  const Color *get_alpha_lut_(uint8_t bpp, Color color, Color background);
+
+  /** Implementations of fill_absolute_rectangle_internal() and draw_rgb565_run_internal() for common buffer layouts.
+   *
+   * Both layouts store the rows of the display one after the other, and only mark what they change as dirty. In a
+   * page buffer each byte is a column of 8 pixels (the lowest bit at the top) of a page of 8 rows. An RGB565 buffer
+   * stores each pixel as two bytes of big endian RGB565.
+   */
+  void fill_page_buffer_(int x1, int y1, int width, int height, Color color);
+  void fill_rgb565_buffer_(int x1, int y1, int width, int height, Color color);
+  void draw_rgb565_buffer_run_(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data);
+
+  /** Extend the dirty window, the part of the buffer that changed since the last reset_dirty_().
+   *
+   * Drivers call this (in the orientation of the display itself) only when a write actually changes their
+   * buffer, so that they can send just the dirty window to the display.
+   */
+  void mark_dirty_(int x, int y) {
+    this->dirty_x_low_ = std::min(this->dirty_x_low_, x);
+    this->dirty_y_low_ = std::min(this->dirty_y_low_, y);
+    this->dirty_x_high_ = std::max(this->dirty_x_high_, x);
+    this->dirty_y_high_ = std::max(this->dirty_y_high_, y);
+  }
+  void mark_dirty_(int x1, int y1, int width, int height) {
+    this->mark_dirty_(x1, y1);
+    this->mark_dirty_(x1 + width - 1, y1 + height - 1);
+  }
+  bool is_dirty_() const { return this->dirty_x_low_ <= this->dirty_x_high_; }
+  void reset_dirty_();
+  /** Narrow the dirty window down to the tiles whose contents changed since the last call.
+   *
+   * Since update() clears the buffer before drawing, everything drawn ends up in the dirty window even if it is
+   * the same as before. Drivers call this right before sending the dirty window, returns false if nothing changed.
+   */
+  bool update_dirty_window_();
+
+  /** Get where a rectangle (in the orientation of the display itself) is stored in the buffer.
+   *
+   * The rectangle is stored as rows runs of length bytes, the first one at offset and each stride bytes after
+   * the previous one. Drivers implement this to have the dirty window narrowed down by update_dirty_window_().
+   */
+  virtual bool get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                          size_t *rows, size_t *stride);
+
+  /** Hand the buffer with the dirty window over to be sent and switch to the buffer to render the next frame into.
+   *
+   * Without double buffering that is the same buffer and the dirty window is reset. With double buffering the
+   * buffers are swapped, the dirty window stays as the other buffer is stale there. Returns the buffer to send,
+   * which must not be changed until it has been sent.
+   */
+  const uint8_t *swap_buffers_();
+
   void do_update_();
 
   uint8_t *buffer_{nullptr};
+  /// The buffer being sent while rendering into buffer_, nullptr without double buffering.
+  uint8_t *back_buffer_{nullptr};
+  bool double_buffer_{false};
+  /// Inclusive bounds of the dirty window, empty if low > high.
+  int dirty_x_low_{INT_MAX};
+  int dirty_y_low_{INT_MAX};
+  int dirty_x_high_{-1};
+  int dirty_y_high_{-1};
+  /// Hashes of the buffer contents per tile as of the last update_dirty_window_().
+  std::vector<uint64_t> tile_hashes_{};
+  /// Lookup table of the last get_alpha_lut_() call, one entry per alpha value.
+  std::vector<Color> alpha_lut_{};
+  Color alpha_lut_color_{};
+  Color alpha_lut_background_{};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
   optional<display_writer_t> writer_{};
   DisplayPage *page_{nullptr};
@@ -333,7 +472,7 @@ class DisplayPage {
 class Glyph {
  public:
   Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-        int height);
+        int height, uint8_t bpp = 1);
 
   bool get_pixel(int x, int y) const;
 
@@ -355,6 +494,8 @@ class Glyph {
   int offset_y_;
   int width_;
   int height_;
+  /// Bits of alpha per pixel, 1 for fonts without anti-aliasing.
+  uint8_t bpp_;
 };
 
 class Font {
@@ -367,16 +508,43 @@ class Font {
    */
   Font(std::vector<Glyph> &&glyphs, int baseline, int bottom);
 
+  /** Set the table for looking up glyphs by the code point they start with.
+   *
+   * Entry i is for code point first_codepoint + i: 0 if there is no glyph starting with it, the glyph index + 1 if
+   * exactly one glyph consisting of only this code point starts with it and GLYPH_TABLE_SEARCH otherwise. The table
+   * is stored in flash (PROGMEM), code points outside of it are looked up with a binary search.
+   */
+  void set_glyph_table(uint32_t first_codepoint, const uint16_t *table, uint32_t size);
+
   int match_next_glyph(const char *str, int *match_length);
 
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height);
 
   const std::vector<Glyph> &get_glyphs() const;
 
+  static const uint16_t GLYPH_TABLE_SEARCH = 0xFFFF;
+
  protected:
+  int search_glyph_(const char *str, int *match_length);
+
   std::vector<Glyph> glyphs_;
   int baseline_;
   int bottom_;
+  uint32_t glyph_table_first_{0};
+  const uint16_t *glyph_table_{nullptr};
+  uint32_t glyph_table_size_{0};
+
+  /// The last measured strings, text is usually redrawn with the same contents on every update.
+  struct MeasureCacheEntry {
+    /// Compared first, the text is only compared on a matching hash.
+    uint32_t hash;
+    std::string text;
+    int width;
+    int x_offset;
+  };
+  static const uint8_t MEASURE_CACHE_SIZE = 4;
+  MeasureCacheEntry measure_cache_[MEASURE_CACHE_SIZE]{};
+  uint8_t measure_cache_next_{0};
 };
 
 class Image {
@@ -391,6 +559,8 @@ class Image {
   ImageType get_type() const;
 
  protected:
+  friend DisplayBuffer;
+
   int width_;
   int height_;
   ImageType type_{BINARY};
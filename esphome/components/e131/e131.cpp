@@ -16,6 +16,8 @@ namespace e131 {
 
 static const char *TAG = "e131";
 static const int PORT = 5568;
+/// Without synchronization packets for this long, synchronized data is applied immediately (E1.31 data loss timeout).
+static const uint32_t SYNC_TIMEOUT = 2500;
 
 E131Component::E131Component() {}
 
@@ -38,22 +40,43 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
 
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    // anything longer is not a valid packet, the rest of the datagram is discarded by the next parsePacket()
+    size_t size = std::min<size_t>(packet_size, sizeof(this->receive_buffer_));
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (!udp_->read(this->receive_buffer_, size)) {
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet recevied of size %zu.", payload.size());
+    switch (packet_(this->receive_buffer_, size, universe, packet)) {
+      case E131_PACKET_INVALID:
+        ESP_LOGV(TAG, "Invalid packet recevied of size %u.", packet_size);
+        continue;
+      case E131_PACKET_SYNC:
+        sync_(universe);
+        continue;
+      case E131_PACKET_DATA:
+        break;
+    }
+
+    E131Universe *entry = get_universe_(universe);
+    if (entry == nullptr) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
       continue;
     }
 
+    if (packet.sync_universe != 0) {
+      set_sync_universe_(packet.sync_universe);
+      if (has_sync_ && millis() - last_sync_ < SYNC_TIMEOUT) {
+        hold_(*entry, packet);
+        continue;
+      }
+    }
+
+    entry->held_values.clear();
     if (!process_(universe, packet)) {
       ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
     }
@@ -90,6 +113,38 @@ void E131Component::remove_effect(E131AddressableLightEffect *light_effect) {
   }
 }
 
+E131Universe *E131Component::get_universe_(int universe) {
+  const int index = universe - first_universe_;
+  if (index < 0 || index >= int(universes_.size()) || universes_[index].consumers == 0)
+    return nullptr;
+  return &universes_[index];
+}
+
+void E131Component::hold_(E131Universe &entry, const E131Packet &packet) {
+  entry.held_values.assign(packet.values, packet.values + packet.count);
+}
+
+void E131Component::sync_(int sync_universe) {
+  if (sync_universe == 0 || sync_universe != sync_universe_)
+    return;
+
+  has_sync_ = true;
+  last_sync_ = millis();
+
+  // the light effects only write the LEDs, they are shown together by the lights' next loop()
+  for (size_t i = 0; i < universes_.size(); i++) {
+    E131Universe &entry = universes_[i];
+    if (entry.held_values.empty())
+      continue;
+
+    E131Packet packet{static_cast<uint16_t>(entry.held_values.size()), entry.held_values.data(),
+                      static_cast<uint16_t>(sync_universe)};
+    process_(first_universe_ + i, packet);
+    // clear() keeps the capacity for the next synchronized packet
+    entry.held_values.clear();
+  }
+}
+
 bool E131Component::process_(int universe, const E131Packet &packet) {
   bool handled = false;
 
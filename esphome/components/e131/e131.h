@@ -4,7 +4,7 @@
 
 #include <memory>
 #include <set>
-#include <map>
+#include <vector>
 
 class UDP;
 
@@ -16,10 +16,23 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+const int E131_MAX_PACKET_SIZE = 638;
 
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  /// Points into the receive buffer (or the data held for synchronization), values[0] is the start code.
+  const uint8_t *values;
+  /// The universe whose synchronization packet applies this data, 0 to apply it immediately.
+  uint16_t sync_universe;
+};
+
+enum E131PacketType { E131_PACKET_INVALID, E131_PACKET_DATA, E131_PACKET_SYNC };
+
+/// An entry of the universe table, indexed by the universe number relative to the lowest joined universe.
+struct E131Universe {
+  uint16_t consumers{0};
+  /// The data held until the next synchronization packet, empty if there is none.
+  std::vector<uint8_t> held_values;
 };
 
 class E131Component : public esphome::Component {
@@ -39,18 +52,33 @@ class E131Component : public esphome::Component {
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  E131PacketType packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
   bool process_(int universe, const E131Packet &packet);
+  /// Keep the data of a synchronized packet until the synchronization packet arrives.
+  void hold_(E131Universe &entry, const E131Packet &packet);
+  /// Process the data held for all universes, so that they are shown in the same frame.
+  void sync_(int sync_universe);
+  void set_sync_universe_(int sync_universe);
   bool join_igmp_groups_();
+  void join_igmp_group_(int universe);
+  void leave_igmp_group_(int universe);
   void join_(int universe);
   void leave_(int universe);
+  E131Universe *get_universe_(int universe);
 
  protected:
   E131ListenMethod listen_method_{E131_MULTICAST};
   std::unique_ptr<UDP> udp_;
   std::set<E131AddressableLightEffect *> light_effects_;
-  std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  std::vector<E131Universe> universes_;
+  /// The universe number of universes_[0].
+  int first_universe_{0};
+  /// Datagrams are parsed in place, the packet values point into this buffer.
+  uint8_t receive_buffer_[E131_MAX_PACKET_SIZE];
+  /// The universe the sender announced for synchronization packets, 0 if it doesn't synchronize.
+  int sync_universe_{0};
+  uint32_t last_sync_{0};
+  bool has_sync_{false};
 };
 
 }  // namespace e131
@@ -6,7 +6,8 @@ namespace esphome {
 namespace e131 {
 
 static const char *TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = (E131_MAX_PROPERTY_VALUES_COUNT - 1);
+static const int CHUNK_SIZE = 32;
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -53,34 +54,41 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   int output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end = std::min(it->size(), std::min(output_offset + get_lights_per_universe(), packet.count - 1));
+  int received_lights = (packet.count - 1) / channels_;
+  int output_end = std::min(it->size(), output_offset + std::min(get_lights_per_universe(), received_lights));
   auto input_data = packet.values + 1;
 
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(light::ESPColor(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
-
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(light::ESPColor(input_data[0], input_data[1], input_data[2],
-                                   (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
-
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(light::ESPColor(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+  // convert in chunks, so that the LEDs are written with a single bulk write per chunk
+  light::ESPColor colors[CHUNK_SIZE];
+  while (output_offset < output_end) {
+    int count = std::min(output_end - output_offset, CHUNK_SIZE);
+
+    switch (channels_) {
+      case E131_MONO:
+        for (int i = 0; i < count; i++, input_data++) {
+          colors[i] = light::ESPColor(input_data[0], input_data[0], input_data[0], input_data[0]);
+        }
+        break;
+
+      case E131_RGB:
+        for (int i = 0; i < count; i++, input_data += 3) {
+          colors[i] = light::ESPColor(input_data[0], input_data[1], input_data[2],
+                                      (input_data[0] + input_data[1] + input_data[2]) / 3);
+        }
+        break;
+
+      case E131_RGBW:
+        for (int i = 0; i < count; i++, input_data += 4) {
+          colors[i] = light::ESPColor(input_data[0], input_data[1], input_data[2], input_data[3]);
+        }
+        break;
+    }
+
+    it->set_colors(output_offset, colors, count);
+    output_offset += count;
   }
 
   return true;
@@ -12,8 +12,11 @@ static const char *TAG = "e131";
 
 static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 static const uint32_t VECTOR_ROOT = 4;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
 static const uint32_t VECTOR_FRAME = 2;
+static const uint32_t VECTOR_FRAME_SYNC = 1;
 static const uint8_t VECTOR_DMP = 2;
+static const int MAX_UNIVERSE = 63999;
 
 // E1.31 Packet Structure
 union E131RawPacket {
@@ -31,7 +34,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -46,12 +49,35 @@ union E131RawPacket {
     uint8_t property_values[E131_MAX_PROPERTY_VALUES_COUNT];
   } __attribute__((packed));
 
-  uint8_t raw[638];
+  // E1.31 Synchronization Packet Structure
+  struct {
+    // Root Layer
+    uint16_t preamble_size;
+    uint16_t postamble_size;
+    uint8_t acn_id[12];
+    uint16_t root_flength;
+    uint32_t root_vector;
+    uint8_t cid[16];
+
+    // Frame Layer
+    uint16_t frame_flength;
+    uint32_t frame_vector;
+    uint8_t sequence_number;
+    uint16_t sync_address;
+    uint16_t reserved;
+  } __attribute__((packed)) sync;
+
+  uint8_t raw[E131_MAX_PACKET_SIZE];
 };
 
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const long E131_MIN_PACKET_SIZE = reinterpret_cast<long>(&((E131RawPacket *) nullptr)->property_values[1]);
+const long E131_SYNC_PACKET_SIZE = reinterpret_cast<long>(&((E131RawPacket *) nullptr)->sync.reserved) + 2;
+
+static ip4_addr_t multicast_address(int universe) {
+  return {static_cast<uint32_t>(IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
+}
 
 bool E131Component::join_igmp_groups_() {
   if (listen_method_ != E131_MULTICAST)
@@ -59,77 +85,136 @@ bool E131Component::join_igmp_groups_() {
   if (!udp_)
     return false;
 
-  for (auto universe : universe_consumers_) {
-    if (!universe.second)
-      continue;
+  for (size_t i = 0; i < universes_.size(); i++) {
+    if (universes_[i].consumers)
+      join_igmp_group_(first_universe_ + i);
+  }
+  if (sync_universe_ != 0)
+    join_igmp_group_(sync_universe_);
+
+  return true;
+}
 
-    ip4_addr_t multicast_addr = {
-        static_cast<uint32_t>(IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff)))};
+void E131Component::join_igmp_group_(int universe) {
+  ip4_addr_t multicast_addr = multicast_address(universe);
 
-    auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
+  auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
-    if (err) {
-      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.first);
-    }
+  if (err) {
+    ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe);
   }
+}
 
-  return true;
+void E131Component::leave_igmp_group_(int universe) {
+  ip4_addr_t multicast_addr = multicast_address(universe);
+
+  igmp_leavegroup(IP4_ADDR_ANY4, &multicast_addr);
 }
 
 void E131Component::join_(int universe) {
-  // store only latest received packet for the given universe
-  auto consumers = ++universe_consumers_[universe];
+  if (universe < 1 || universe > MAX_UNIVERSE)
+    return;
+  // the table only spans the joined universes, usually a few consecutive ones
+  if (universes_.empty()) {
+    first_universe_ = universe;
+  } else if (universe < first_universe_) {
+    universes_.insert(universes_.begin(), first_universe_ - universe, E131Universe());
+    first_universe_ = universe;
+  }
+  const int index = universe - first_universe_;
+  if (index >= int(universes_.size()))
+    universes_.resize(index + 1);
+
+  auto consumers = ++universes_[index].consumers;
 
   if (consumers > 1) {
     return;  // we already joined before
   }
 
-  if (join_igmp_groups_()) {
-    ESP_LOGD(TAG, "Joined %d universe for E1.31.", universe);
+  // joining a group twice would need two leaves, so join only the new one
+  if (listen_method_ == E131_MULTICAST && udp_ && universe != sync_universe_) {
+    join_igmp_group_(universe);
   }
+
+  ESP_LOGD(TAG, "Joined %d universe for E1.31.", universe);
 }
 
 void E131Component::leave_(int universe) {
-  auto consumers = --universe_consumers_[universe];
+  E131Universe *entry = get_universe_(universe);
+  if (entry == nullptr)
+    return;
+
+  auto consumers = --entry->consumers;
 
   if (consumers > 0) {
     return;  // we have other consumers of the given universe
   }
 
-  if (listen_method_ == E131_MULTICAST) {
-    ip4_addr_t multicast_addr = {
-        static_cast<uint32_t>(IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
+  // release the held data, clear() would keep its capacity
+  std::vector<uint8_t>().swap(entry->held_values);
 
-    igmp_leavegroup(IP4_ADDR_ANY4, &multicast_addr);
+  if (listen_method_ == E131_MULTICAST && universe != sync_universe_) {
+    leave_igmp_group_(universe);
   }
 
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
-    return false;
+void E131Component::set_sync_universe_(int sync_universe) {
+  if (sync_universe == sync_universe_)
+    return;
+
+  // multicast synchronization packets are sent to the synchronization universe's group
+  if (listen_method_ == E131_MULTICAST) {
+    if (sync_universe_ != 0 && get_universe_(sync_universe_) == nullptr)
+      leave_igmp_group_(sync_universe_);
+    if (get_universe_(sync_universe) == nullptr)
+      join_igmp_group_(sync_universe);
+  }
+
+  ESP_LOGD(TAG, "Synchronizing E1.31 universes with %d universe.", sync_universe);
+  sync_universe_ = sync_universe;
+  has_sync_ = false;
+}
 
-  auto sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+E131PacketType E131Component::packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet) {
+  if (size < E131_SYNC_PACKET_SIZE)
+    return E131_PACKET_INVALID;
+
+  auto sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
-    return false;
+    return E131_PACKET_INVALID;
+
+  if (htonl(sbuff->root_vector) == VECTOR_ROOT_EXTENDED) {
+    if (htonl(sbuff->sync.frame_vector) != VECTOR_FRAME_SYNC)
+      return E131_PACKET_INVALID;
+    universe = htons(sbuff->sync.sync_address);
+    return E131_PACKET_SYNC;
+  }
+
+  if (size < E131_MIN_PACKET_SIZE)
+    return E131_PACKET_INVALID;
   if (htonl(sbuff->root_vector) != VECTOR_ROOT)
-    return false;
+    return E131_PACKET_INVALID;
   if (htonl(sbuff->frame_vector) != VECTOR_FRAME)
-    return false;
+    return E131_PACKET_INVALID;
   if (sbuff->dmp_vector != VECTOR_DMP)
-    return false;
+    return E131_PACKET_INVALID;
   if (sbuff->property_values[0] != 0)
-    return false;
+    return E131_PACKET_INVALID;
 
   universe = htons(sbuff->universe);
   packet.count = htons(sbuff->property_value_count);
   if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
-    return false;
-
-  memcpy(packet.values, sbuff->property_values, packet.count);
-  return true;
+    return E131_PACKET_INVALID;
+  // the values are used in place, they must have been received completely
+  if (E131_MIN_PACKET_SIZE - 1 + packet.count > long(size))
+    return E131_PACKET_INVALID;
+
+  packet.values = sbuff->property_values;
+  packet.sync_universe = htons(sbuff->sync_address);
+  return E131_PACKET_DATA;
 }
 
 }  // namespace e131
@@ -6,11 +6,15 @@ namespace fastled_base {
 
 static const char *TAG = "fastled";
 
+/// CRGB keeps the channels in red, green, blue order, the controller applies the pixel order.
+static const uint8_t CRGB_OFFSETS[3] = {0, 1, 2};
+
 void FastLEDLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up FastLED light...");
   this->controller_->init();
   this->controller_->setLeds(this->leds_, this->num_leds_);
   this->effect_data_ = new uint8_t[this->num_leds_];
+  this->set_pixel_buffer_(reinterpret_cast<uint8_t *>(this->leds_), 3, CRGB_OFFSETS, this->effect_data_);
   if (!this->max_refresh_rate_.has_value()) {
     this->set_max_refresh_rate(this->controller_->getMaxRefreshRate());
   }
@@ -30,10 +34,14 @@ void FastLEDLightOutput::loop() {
     return;
   }
   this->last_refresh_ = now;
+  // the LEDs after the last changed one keep their state, only the strip up to it has to be sent
+  const int count = std::min(this->dirty_.end, this->num_leds_);
   this->mark_shown_();
 
-  ESP_LOGVV(TAG, "Writing RGB values to bus...");
+  ESP_LOGVV(TAG, "Writing RGB values of %d LEDs to bus...", count);
+  this->controller_->setLeds(this->leds_, count);
   this->controller_->showLeds();
+  this->controller_->setLeds(this->leds_, this->num_leds_);
 }
 
 }  // namespace fastled_base
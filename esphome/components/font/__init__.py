@@ -65,18 +65,48 @@ def validate_truetype_file(value):
 
 DEFAULT_GLYPHS = ' !"%()+,-.:0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 CONF_RAW_DATA_ID = 'raw_data_id'
+CONF_RAW_GLYPH_TABLE_ID = 'raw_glyph_table_id'
+CONF_BPP = 'bpp'
+# Keep in sync with Font::GLYPH_TABLE_SEARCH
+GLYPH_TABLE_SEARCH = 0xFFFF
+GLYPH_TABLE_MAX_SIZE = 1024
 
 FONT_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(Font),
     cv.Required(CONF_FILE): validate_truetype_file,
     cv.Optional(CONF_GLYPHS, default=DEFAULT_GLYPHS): validate_glyphs,
     cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
+    cv.Optional(CONF_BPP, default=1): cv.one_of(1, 2, 4, 8, int=True),
     cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
+    cv.GenerateID(CONF_RAW_GLYPH_TABLE_ID): cv.declare_id(cg.uint16),
 })
 
 CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA)
 
 
+def build_glyph_table(glyphs):
+    """Build the table Font::match_next_glyph() uses to look up glyphs by their first code point.
+
+    Returns the first code point and the table entries, see Font::set_glyph_table(). Code points above
+    the first one + GLYPH_TABLE_MAX_SIZE are not in the table and are found by binary search instead.
+    """
+    if not glyphs or len(glyphs) >= GLYPH_TABLE_SEARCH:
+        return 0, []
+    first = min(ord(glyph[0]) for glyph in glyphs)
+    last = min(max(ord(glyph[0]) for glyph in glyphs), first + GLYPH_TABLE_MAX_SIZE - 1)
+    table = [0] * (last - first + 1)
+    for i, glyph in enumerate(glyphs):
+        index = ord(glyph[0]) - first
+        if index >= len(table):
+            continue
+        if table[index] != 0 or len(glyph) > 1:
+            # several glyphs start with this code point, which one matches depends on the following ones
+            table[index] = GLYPH_TABLE_SEARCH
+        else:
+            table[index] = i + 1
+    return first, table
+
+
 def to_code(config):
     from PIL import ImageFont
 
@@ -88,20 +118,25 @@ def to_code(config):
 
     ascent, descent = font.getmetrics()
 
+    bpp = config[CONF_BPP]
+    max_alpha = (1 << bpp) - 1
     glyph_args = {}
     data = []
     for glyph in config[CONF_GLYPHS]:
-        mask = font.getmask(glyph, mode='1')
+        # anti-aliased glyphs are rendered with 8 bits of alpha and quantized to bpp bits
+        mask = font.getmask(glyph, mode='1' if bpp == 1 else 'L')
         _, (offset_x, offset_y) = font.font.getsize(glyph)
         width, height = mask.size
-        width8 = ((width + 7) // 8) * 8
+        width8 = ((width * bpp + 7) // 8) * 8
         glyph_data = [0 for _ in range(height * width8 // 8)]  # noqa: F812
         for y in range(height):
             for x in range(width):
-                if not mask.getpixel((x, y)):
+                pixel = mask.getpixel((x, y))
+                if not pixel:
                     continue
-                pos = x + y * width8
-                glyph_data[pos // 8] |= 0x80 >> (pos % 8)
+                alpha = 1 if bpp == 1 else (pixel * max_alpha + 127) // 255
+                pos = x * bpp + y * width8
+                glyph_data[pos // 8] |= alpha << (8 - bpp - pos % 8)
         glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
         data += glyph_data
 
@@ -110,6 +145,14 @@ def to_code(config):
 
     glyphs = []
     for glyph in config[CONF_GLYPHS]:
-        glyphs.append(Glyph(glyph, prog_arr, *glyph_args[glyph]))
+        if bpp == 1:
+            glyphs.append(Glyph(glyph, prog_arr, *glyph_args[glyph]))
+        else:
+            glyphs.append(Glyph(glyph, prog_arr, *glyph_args[glyph], bpp))
+
+    var = cg.new_Pvariable(config[CONF_ID], glyphs, ascent, ascent + descent)
 
-    cg.new_Pvariable(config[CONF_ID], glyphs, ascent, ascent + descent)
+    first, table = build_glyph_table(config[CONF_GLYPHS])
+    if table:
+        table_arr = cg.progmem_array(config[CONF_RAW_GLYPH_TABLE_ID], table)
+        cg.add(var.set_glyph_table(first, table_arr, len(table)))
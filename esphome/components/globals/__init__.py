@@ -10,12 +10,15 @@ globals_ns = cg.esphome_ns.namespace('globals')
 GlobalsComponent = globals_ns.class_('GlobalsComponent', cg.Component)
 GlobalVarSetAction = globals_ns.class_('GlobalVarSetAction', automation.Action)
 
+CONF_SAVE_DELAY = 'save_delay'
+
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
     cv.Required(CONF_TYPE): cv.string_strict,
     cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
     cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
+    cv.Optional(CONF_SAVE_DELAY, default='1s'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -40,6 +43,7 @@ def to_code(config):
             value = value.encode()
         hash_ = int(hashlib.md5(value).hexdigest()[:8], 16)
         cg.add(glob.set_restore_value(hash_))
+        cg.add(glob.set_save_delay(config[CONF_SAVE_DELAY]))
 
 
 @automation.register_action('globals.set', GlobalVarSetAction, cv.Schema({
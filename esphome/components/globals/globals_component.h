@@ -3,10 +3,14 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
+#include <algorithm>
 
 namespace esphome {
 namespace globals {
 
+/// Writes through references from value()/id() that are not marked dirty are found by comparing at this interval.
+static const uint32_t GLOBALS_COMPARE_INTERVAL = 60000;
+
 template<typename T> class GlobalsComponent : public Component {
  public:
   using value_type = T;
@@ -22,31 +26,49 @@ template<typename T> class GlobalsComponent : public Component {
     if (this->restore_value_) {
       this->rtc_ = global_preferences.make_preference<T>(1944399030U ^ this->name_hash_);
       this->rtc_.load(&this->value_);
+      // The value can be modified through any reference returned by value()/id() without mark_dirty(), so it is
+      // also compared with the last saved value now and then instead of in every loop().
+      this->set_interval(fnv1_hash_static("compare"), std::max(this->save_delay_, GLOBALS_COMPARE_INTERVAL),
+                         [this]() { this->save_(); });
     }
     memcpy(&this->prev_value_, &this->value_, sizeof(T));
   }
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
-  void loop() override {
-    if (this->restore_value_) {
-      int diff = memcmp(&this->value_, &this->prev_value_, sizeof(T));
-      if (diff != 0) {
-        this->rtc_.save(&this->value_);
-        memcpy(&this->prev_value_, &this->value_, sizeof(T));
-      }
-    }
+  void on_shutdown() override {
+    if (this->restore_value_)
+      this->save_();
   }
 
   void set_restore_value(uint32_t name_hash) {
     this->restore_value_ = true;
     this->name_hash_ = name_hash;
   }
+  void set_save_delay(uint32_t save_delay) { this->save_delay_ = save_delay; }
+
+  /// Save the value after the save delay, all changes marked within the delay are written together.
+  void mark_dirty() {
+    if (!this->restore_value_ || this->save_pending_)
+      return;
+    this->save_pending_ = true;
+    this->set_timeout(fnv1_hash_static("save"), this->save_delay_, [this]() { this->save_(); });
+  }
 
  protected:
+  void save_() {
+    this->save_pending_ = false;
+    if (memcmp(&this->value_, &this->prev_value_, sizeof(T)) == 0)
+      return;
+    this->rtc_.save(&this->value_);
+    memcpy(&this->prev_value_, &this->value_, sizeof(T));
+  }
+
   T value_{};
   T prev_value_{};
   bool restore_value_{false};
+  bool save_pending_{false};
+  uint32_t save_delay_{0};
   uint32_t name_hash_{};
   ESPPreferenceObject rtc_;
 };
@@ -59,7 +81,10 @@ template<class C, typename... Ts> class GlobalVarSetAction : public Action<Ts...
 
   TEMPLATABLE_VALUE(T, value);
 
-  void play(Ts... x) override { this->parent_->value() = this->value_.value(x...); }
+  void play(Ts... x) override {
+    this->parent_->value() = this->value_.value(x...);
+    this->parent_->mark_dirty();
+  }
 
  protected:
   C *parent_;
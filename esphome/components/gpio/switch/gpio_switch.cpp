@@ -81,7 +81,7 @@ void GPIOSwitch::write_state(bool state) {
       }
     }
     if (found && this->interlock_wait_time_ != 0) {
-      this->set_timeout("interlock", this->interlock_wait_time_, [this, state] {
+      this->set_timeout(fnv1_hash_static("interlock"), this->interlock_wait_time_, [this, state] {
         // Don't write directly, call the function again
         // (some other switch may have changed state while we were waiting)
         this->write_state(state);
@@ -91,7 +91,7 @@ void GPIOSwitch::write_state(bool state) {
   } else if (this->interlock_wait_time_ != 0) {
     // If we are switched off during the interlock wait time, cancel any pending
     // re-activations
-    this->cancel_timeout("interlock");
+    this->cancel_timeout(fnv1_hash_static("interlock"));
   }
 
   this->pin_->digital_write(state);
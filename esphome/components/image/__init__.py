@@ -11,7 +11,7 @@ _LOGGER = logging.getLogger(__name__)
 DEPENDENCIES = ['display']
 MULTI_CONF = True
 
-ImageType = {'binary': 0, 'grayscale': 1, 'rgb': 2}
+ImageType = {'binary': 0, 'grayscale': 1, 'rgb': 2, 'rgb565': 3}
 
 Image_ = display.display_ns.class_('Image')
 
@@ -53,6 +53,22 @@ def to_code(config):
             rhs = [HexInt(x) for x in data]
             prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
             cg.new_Pvariable(config[CONF_ID], prog_arr, width, height, ImageType['grayscale'])
+        elif config[CONF_TYPE].startswith('RGB565'):
+            # big endian like the buffers of color displays, which can then copy it directly
+            width, height = image.size
+            image = image.convert('RGB')
+            pixels = list(image.getdata())
+            data = [0 for _ in range(height * width * 2)]
+            pos = 0
+            for pix in pixels:
+                rgb = ((pix[0] >> 3) << 11) | ((pix[1] >> 2) << 5) | (pix[2] >> 3)
+                data[pos] = rgb >> 8
+                pos += 1
+                data[pos] = rgb & 0xFF
+                pos += 1
+            rhs = [HexInt(x) for x in data]
+            prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
+            cg.new_Pvariable(config[CONF_ID], prog_arr, width, height, ImageType['rgb565'])
         elif config[CONF_TYPE].startswith('RGB'):
             width, height = image.size
             image = image.convert('RGB')
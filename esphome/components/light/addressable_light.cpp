@@ -1,11 +1,18 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <cstdlib>
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
 static const char *TAG = "light.addressable";
 
+/// Spans of at least this many LEDs are transformed through a lookup table per channel instead of correcting each
+/// value on its own.
+static const int32_t BULK_LUT_THRESHOLD = 256;
+
 const ESPColor ESPColor::BLACK = ESPColor(0, 0, 0, 0);
 const ESPColor ESPColor::WHITE = ESPColor(255, 255, 255, 255);
 
@@ -76,53 +83,24 @@ ESPColor ESPHSVColor::to_rgb() const {
   return rgb;
 }
 
-void ESPRangeView::set(const ESPColor &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
-  }
-}
+void ESPRangeView::set(const ESPColor &color) { this->parent_->fill(this->begin_, this->end_, color); }
 ESPColorView ESPRangeView::operator[](int32_t index) const {
   index = interpret_index(index, this->size()) + this->begin_;
   return (*this->parent_)[index];
 }
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
-void ESPRangeView::set_red(uint8_t red) {
-  for (auto c : *this)
-    c.set_red(red);
-}
-void ESPRangeView::set_green(uint8_t green) {
-  for (auto c : *this)
-    c.set_green(green);
-}
-void ESPRangeView::set_blue(uint8_t blue) {
-  for (auto c : *this)
-    c.set_blue(blue);
-}
-void ESPRangeView::set_white(uint8_t white) {
-  for (auto c : *this)
-    c.set_white(white);
-}
+void ESPRangeView::set_red(uint8_t red) { this->parent_->fill_channel(this->begin_, this->end_, 0, red); }
+void ESPRangeView::set_green(uint8_t green) { this->parent_->fill_channel(this->begin_, this->end_, 1, green); }
+void ESPRangeView::set_blue(uint8_t blue) { this->parent_->fill_channel(this->begin_, this->end_, 2, blue); }
+void ESPRangeView::set_white(uint8_t white) { this->parent_->fill_channel(this->begin_, this->end_, 3, white); }
 void ESPRangeView::set_effect_data(uint8_t effect_data) {
-  for (auto c : *this)
-    c.set_effect_data(effect_data);
-}
-void ESPRangeView::fade_to_white(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_white(amnt);
-}
-void ESPRangeView::fade_to_black(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_black(amnt);
-}
-void ESPRangeView::lighten(uint8_t delta) {
-  for (auto c : *this)
-    c.lighten(delta);
-}
-void ESPRangeView::darken(uint8_t delta) {
-  for (auto c : *this)
-    c.darken(delta);
+  this->parent_->fill_effect_data(this->begin_, this->end_, effect_data);
 }
+void ESPRangeView::fade_to_white(uint8_t amnt) { this->parent_->fade_to_white(this->begin_, this->end_, amnt); }
+void ESPRangeView::fade_to_black(uint8_t amnt) { this->parent_->scale(this->begin_, this->end_, amnt); }
+void ESPRangeView::lighten(uint8_t delta) { this->parent_->add(this->begin_, this->end_, delta); }
+void ESPRangeView::darken(uint8_t delta) { this->parent_->subtract(this->begin_, this->end_, delta); }
 ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {
   // If size doesn't match, error (todo warning)
   if (rhs.size() != this->size())
@@ -134,22 +112,7 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {
     return *this;
   }
 
-  // If both equal, already done
-  if (rhs.begin_ == this->begin_)
-    return *this;
-
-  if (rhs.begin_ > this->begin_) {
-    // Copy from left
-    for (int32_t i = 0; i < this->size(); i++) {
-      (*this)[i].set(rhs[i].get());
-    }
-  } else {
-    // Copy from right
-    for (int32_t i = this->size() - 1; i >= 0; i--) {
-      (*this)[i].set(rhs[i].get());
-    }
-  }
-
+  this->parent_->copy(this->begin_, rhs.begin_, this->size());
   return *this;
 }
 
@@ -179,55 +142,436 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+bool AddressableLight::clamp_range_(int32_t *from, int32_t *to) const {
+  const int32_t size = this->size();
+  *from = std::max(*from, int32_t(0));
+  *to = std::min(*to, size);
+  return *from < *to;
+}
+
+/// Replace every byte of [data, data + len) by its entry in the lookup table, four bytes at a time. Returns
+/// whether any byte changed.
+static bool apply_lut(uint8_t *data, size_t len, const uint8_t *lut) {
+  uint32_t changed = 0;
+  while (len != 0 && (reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+    changed |= *data ^ lut[*data];
+    *data = lut[*data];
+    data++;
+    len--;
+  }
+  for (; len >= 4; data += 4, len -= 4) {
+    uint32_t word, result;
+    memcpy(&word, data, 4);
+    result = uint32_t(lut[word & 0xFF]) | uint32_t(lut[(word >> 8) & 0xFF]) << 8 |
+             uint32_t(lut[(word >> 16) & 0xFF]) << 16 | uint32_t(lut[word >> 24]) << 24;
+    changed |= word ^ result;
+    memcpy(data, &result, 4);
+  }
+  for (; len != 0; data++, len--) {
+    changed |= *data ^ lut[*data];
+    *data = lut[*data];
+  }
+  return changed != 0;
+}
+
+template<typename F> void AddressableLight::transform_(int32_t from, int32_t to, const F &f) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels == nullptr) {
+    for (int32_t i = from; i < to; i++) {
+      ESPColorView view = this->tracked_view_(i);
+      ESPColor color = view.get();
+      for (uint8_t c = 0; c < 4; c++)
+        color[c] = f(c, color[c]);
+      view.set(color);
+    }
+    return;
+  }
+
+  const ESPColorCorrection &corr = this->correction_;
+  const uint8_t channels = buffer.channels;
+  const int32_t count = to - from;
+  uint8_t *const start = buffer.pixels + from * channels;
+  uint8_t changed = 0;
+  if (count < BULK_LUT_THRESHOLD) {
+    for (uint8_t c = 0; c < channels; c++) {
+      uint8_t *p = start + buffer.offsets[c];
+      for (int32_t i = 0; i < count; i++, p += channels) {
+        const uint8_t value = corr.color_correct_channel(c, f(c, corr.color_uncorrect_channel(c, *p)));
+        changed |= *p ^ value;
+        *p = value;
+      }
+    }
+    if (changed != 0)
+      this->dirty_.mark(from, to);
+    return;
+  }
+
+  // raw value -> raw value after uncorrect, f, correct
+  uint8_t lut[256];
+  for (uint16_t v = 0; v < 256; v++)
+    lut[v] = corr.color_correct_channel(0, f(0, corr.color_uncorrect_channel(0, v)));
+  // usually all channels share the same table, then the whole span can be processed at once
+  bool uniform = true;
+  for (uint8_t c = 1; c < channels && uniform; c++) {
+    for (uint16_t v = 0; v < 256 && uniform; v++)
+      uniform = lut[v] == corr.color_correct_channel(c, f(c, corr.color_uncorrect_channel(c, v)));
+  }
+  if (uniform) {
+    if (apply_lut(start, count * channels, lut))
+      this->dirty_.mark(from, to);
+    return;
+  }
+  for (uint8_t c = 0; c < channels; c++) {
+    if (c != 0) {
+      for (uint16_t v = 0; v < 256; v++)
+        lut[v] = corr.color_correct_channel(c, f(c, corr.color_uncorrect_channel(c, v)));
+    }
+    uint8_t *p = start + buffer.offsets[c];
+    for (int32_t i = 0; i < count; i++, p += channels) {
+      changed |= *p ^ lut[*p];
+      *p = lut[*p];
+    }
+  }
+  if (changed != 0)
+    this->dirty_.mark(from, to);
+}
+
+void AddressableLight::fill(int32_t from, int32_t to, const ESPColor &color) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->tracked_view_(i).set(color);
+    return;
+  }
+  const uint8_t channels = buffer.channels;
+  const ESPColor corrected = this->correction_.color_correct(color);
+  uint8_t pattern[4];
+  for (uint8_t c = 0; c < channels; c++)
+    pattern[buffer.offsets[c]] = corrected.raw[c];
+  // only write (and mark dirty) the part that actually changes
+  auto is_pattern = [&pattern, channels](const uint8_t *led) {
+    uint8_t diff = 0;
+    for (uint8_t c = 0; c < channels; c++)
+      diff |= led[c] ^ pattern[c];
+    return diff == 0;
+  };
+  while (from < to && is_pattern(buffer.pixels + from * channels))
+    from++;
+  while (from < to && is_pattern(buffer.pixels + (to - 1) * channels))
+    to--;
+  if (from == to)
+    return;
+  this->dirty_.mark(from, to);
+  uint8_t *const start = buffer.pixels + from * channels;
+  memcpy(start, pattern, channels);
+  // double the filled part until the whole span is set
+  const size_t len = (to - from) * channels;
+  for (size_t filled = channels; filled < len;) {
+    const size_t n = std::min(filled, len - filled);
+    memcpy(start + filled, start, n);
+    filled += n;
+  }
+}
+
+void AddressableLight::fill_channel(int32_t from, int32_t to, uint8_t channel, uint8_t value) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels == nullptr) {
+    for (int32_t i = from; i < to; i++) {
+      ESPColorView view = this->tracked_view_(i);
+      switch (channel) {
+        case 0:
+          view.set_red(value);
+          break;
+        case 1:
+          view.set_green(value);
+          break;
+        case 2:
+          view.set_blue(value);
+          break;
+        default:
+          view.set_white(value);
+          break;
+      }
+    }
+    return;
+  }
+  if (channel >= buffer.channels)
+    return;
+  const uint8_t corrected = this->correction_.color_correct_channel(channel, value);
+  uint8_t *p = buffer.pixels + from * buffer.channels + buffer.offsets[channel];
+  uint8_t changed = 0;
+  for (int32_t i = from; i < to; i++, p += buffer.channels) {
+    changed |= *p ^ corrected;
+    *p = corrected;
+  }
+  if (changed != 0)
+    this->dirty_.mark(from, to);
+}
+
+void AddressableLight::fill_effect_data(int32_t from, int32_t to, uint8_t effect_data) {
+  if (!this->clamp_range_(&from, &to))
+    return;
+  if (this->pixel_buffer_.pixels == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->get_view_internal(i).set_effect_data(effect_data);
+    return;
+  }
+  if (this->pixel_buffer_.effect_data != nullptr)
+    memset(this->pixel_buffer_.effect_data + from, effect_data, to - from);
+}
+
+void AddressableLight::set_colors(int32_t from, const ESPColor *colors, int32_t count) {
+  int32_t to = from + count;
+  const int32_t first = from;
+  if (!this->clamp_range_(&from, &to))
+    return;
+  colors += from - first;
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels == nullptr) {
+    for (int32_t i = from; i < to; i++)
+      this->tracked_view_(i).set(*colors++);
+    return;
+  }
+  uint8_t *p = buffer.pixels + from * buffer.channels;
+  uint8_t changed = 0;
+  for (int32_t i = from; i < to; i++, p += buffer.channels, colors++) {
+    for (uint8_t c = 0; c < buffer.channels; c++) {
+      const uint8_t value = this->correction_.color_correct_channel(c, colors->raw[c]);
+      changed |= p[buffer.offsets[c]] ^ value;
+      p[buffer.offsets[c]] = value;
+    }
+  }
+  if (changed != 0)
+    this->dirty_.mark(from, to);
+}
+
+void AddressableLight::scale(int32_t from, int32_t to, uint8_t scale) {
+  this->transform_(from, to, [scale](uint8_t, uint8_t v) { return esp_scale8(v, scale); });
+}
+void AddressableLight::fade_to_white(int32_t from, int32_t to, uint8_t amnt) {
+  this->transform_(from, to, [amnt](uint8_t, uint8_t v) { return uint8_t(255 - esp_scale8(v, amnt)); });
+}
+void AddressableLight::add(int32_t from, int32_t to, uint8_t delta) {
+  this->transform_(from, to, [delta](uint8_t, uint8_t v) { return uint8_t(std::min(v + delta, 255)); });
+}
+void AddressableLight::subtract(int32_t from, int32_t to, uint8_t delta) {
+  this->transform_(from, to, [delta](uint8_t, uint8_t v) { return uint8_t(std::max(v - delta, 0)); });
+}
+void AddressableLight::blend(int32_t from, int32_t to, const ESPColor &color, uint8_t alpha) {
+  const ESPColor scaled = color * alpha;
+  const uint8_t inv_alpha = 255 - alpha;
+  this->transform_(from, to, [scaled, inv_alpha](uint8_t c, uint8_t v) {
+    return uint8_t(std::min(scaled.raw[c] + esp_scale8(v, inv_alpha), 255));
+  });
+}
+
+void AddressableLight::copy(int32_t dst, int32_t src, int32_t count) {
+  const int32_t size = this->size();
+  if (dst < 0 || src < 0 || dst >= size || src >= size || dst == src)
+    return;
+  count = std::min(count, size - std::max(dst, src));
+  if (count <= 0)
+    return;
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels != nullptr) {
+    // raw copy, going through uncorrect and correct again would lose precision at low brightness
+    uint8_t *const to = buffer.pixels + dst * buffer.channels;
+    const uint8_t *const from = buffer.pixels + src * buffer.channels;
+    if (memcmp(to, from, count * buffer.channels) == 0)
+      return;
+    this->dirty_.mark(dst, dst + count);
+    memmove(to, from, count * buffer.channels);
+    return;
+  }
+  if (src > dst) {
+    // Copy from left
+    for (int32_t i = 0; i < count; i++)
+      this->tracked_view_(dst + i).set(this->get_view_internal(src + i).get());
+  } else {
+    // Copy from right
+    for (int32_t i = count - 1; i >= 0; i--)
+      this->tracked_view_(dst + i).set(this->get_view_internal(src + i).get());
+  }
+}
+
+bool AddressableLight::is_any_on_() {
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  if (buffer.pixels == nullptr) {
+    for (auto c : *this) {
+      if (c.get().is_on())
+        return true;
+    }
+    return false;
+  }
+  const uint8_t *p = buffer.pixels;
+  size_t len = this->size() * buffer.channels;
+  uint32_t any = 0;
+  for (; len >= 4; p += 4, len -= 4) {
+    uint32_t word;
+    memcpy(&word, p, 4);
+    any |= word;
+  }
+  for (; len != 0; p++, len--)
+    any |= *p;
+  return any != 0;
+}
+
+/// Round a 16-bit fixed point value to 8 bits, 65535 / 255 = 257.
+static uint8_t q16_to_8(uint32_t value) { return (value + 128) / 257; }
+/// Round the product of two 16-bit fixed point values to 8 bits.
+static uint8_t q16_product_to_8(uint32_t a, uint32_t b) { return q16_to_8((a * b + 32767) / 65535); }
+
 ESPColor esp_color_from_light_color_values(LightColorValues val) {
-  auto r = static_cast<uint8_t>(roundf(val.get_red() * 255.0f));
-  auto g = static_cast<uint8_t>(roundf(val.get_green() * 255.0f));
-  auto b = static_cast<uint8_t>(roundf(val.get_blue() * 255.0f));
-  auto w = static_cast<uint8_t>(roundf(val.get_white() * val.get_state() * 255.0f));
+  auto r = q16_to_8(val.get_red_raw());
+  auto g = q16_to_8(val.get_green_raw());
+  auto b = q16_to_8(val.get_blue_raw());
+  auto w = q16_product_to_8(val.get_white_raw(), val.get_state_raw());
   return ESPColor(r, g, b, w);
 }
 
+bool AddressableLight::take_transition_snapshot_(LightTransformer *transformer) {
+  if (this->snapshot_transformer_ == transformer)
+    return true;
+
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  const uint8_t channels = buffer.pixels != nullptr ? buffer.channels : 4;
+  const int32_t size = this->size();
+  if (this->transition_snapshot_ == nullptr) {
+    const size_t len = size * channels;
+#ifdef ARDUINO_ARCH_ESP32
+    if (psramFound())
+      this->transition_snapshot_ = static_cast<uint8_t *>(ps_malloc(len));
+#endif
+    if (this->transition_snapshot_ == nullptr)
+      this->transition_snapshot_ = static_cast<uint8_t *>(malloc(len));
+    if (this->transition_snapshot_ == nullptr) {
+      ESP_LOGW(TAG, "Not enough memory for exact transitions, falling back to approximated transitions");
+      this->exact_transitions_ = false;
+      return false;
+    }
+  }
+
+  // local brightness is 255 here, the uncorrected colors are premultiplied by the brightness like the target
+  uint8_t *snapshot = this->transition_snapshot_;
+  if (buffer.pixels != nullptr) {
+    for (uint8_t c = 0; c < channels; c++) {
+      const uint8_t *p = buffer.pixels + buffer.offsets[c];
+      for (int32_t i = 0; i < size; i++, p += channels)
+        snapshot[i * channels + c] = this->correction_.color_uncorrect_channel(c, *p);
+    }
+  } else {
+    for (int32_t i = 0; i < size; i++, snapshot += channels)
+      memcpy(snapshot, this->get_view_internal(i).get().raw, channels);
+  }
+  this->snapshot_transformer_ = transformer;
+  this->snapshot_progress_ = LightTransitionTransformer::smoothed_progress16(transformer->get_progress16());
+  return true;
+}
+
+void AddressableLight::write_exact_transition_(LightTransformer *transformer, const ESPColor &target) {
+  // the snapshot may have been taken in the middle of a transition (for example after an effect), rescale the
+  // progress so that the lerp starts at the snapshot
+  const uint32_t start = this->snapshot_progress_;
+  uint32_t progress = LightTransitionTransformer::smoothed_progress16(transformer->get_progress16());
+  progress = progress <= start ? 0 : start >= 65535 ? 65535 : ((progress - start) * 65535) / (65535 - start);
+
+  const ESPPixelBuffer &buffer = this->pixel_buffer_;
+  const uint8_t channels = buffer.pixels != nullptr ? buffer.channels : 4;
+  const int32_t size = this->size();
+  const uint8_t *snapshot = this->transition_snapshot_;
+  if (buffer.pixels == nullptr) {
+    for (int32_t i = 0; i < size; i++, snapshot += channels) {
+      ESPColor color;
+      for (uint8_t c = 0; c < channels; c++) {
+        const int32_t from = snapshot[c];
+        color.raw[c] = from + (((int32_t(target.raw[c]) - from) * int32_t(progress) + 32768) >> 16);
+      }
+      this->tracked_view_(i).set(color);
+    }
+    return;
+  }
+  uint8_t lut[256];
+  uint8_t changed = 0;
+  for (uint8_t c = 0; c < channels; c++) {
+    const int32_t to = target.raw[c];
+    uint8_t *p = buffer.pixels + buffer.offsets[c];
+    const uint8_t *from = snapshot + c;
+    if (size < BULK_LUT_THRESHOLD) {
+      for (int32_t i = 0; i < size; i++, p += channels, from += channels) {
+        const uint8_t lerped = *from + (((to - *from) * int32_t(progress) + 32768) >> 16);
+        const uint8_t value = this->correction_.color_correct_channel(c, lerped);
+        changed |= *p ^ value;
+        *p = value;
+      }
+      continue;
+    }
+    // lerp from each possible start value, so that each LED is a single lookup
+    for (int32_t v = 0; v < 256; v++)
+      lut[v] = this->correction_.color_correct_channel(c, v + (((to - v) * int32_t(progress) + 32768) >> 16));
+    for (int32_t i = 0; i < size; i++, p += channels, from += channels) {
+      changed |= *p ^ lut[*from];
+      *p = lut[*from];
+    }
+  }
+  if (changed != 0)
+    this->dirty_.mark(0, size);
+}
+
 void AddressableLight::write_state(LightState *state) {
   auto val = state->current_values;
-  auto max_brightness = static_cast<uint8_t>(roundf(val.get_brightness() * val.get_state() * 255.0f));
+  auto max_brightness = q16_product_to_8(val.get_brightness_raw(), val.get_state_raw());
   this->correction_.set_local_brightness(max_brightness);
 
   this->last_transition_progress_ = 0.0f;
   this->accumulated_alpha_ = 0.0f;
 
-  if (this->is_effect_active())
+  if (this->is_effect_active()) {
+    // the effect changes the LEDs, a transition continuing afterwards has to start from the new colors
+    this->snapshot_transformer_ = nullptr;
     return;
+  }
 
   // don't use LightState helper, gamma correction+brightness is handled by ESPColorView
 
   if (state->transformer_ == nullptr || !state->transformer_->is_transition()) {
     // no transformer active or non-transition one
+    this->snapshot_transformer_ = nullptr;
     this->all() = esp_color_from_light_color_values(val);
   } else {
     // transition transformer active, activate specialized transition for addressable effects
     // instead of using a unified transition for all LEDs, we use the current state each LED as the
-    // start. Warning: ugly
-
-    // We can't use a direct lerp smoothing here though - that would require creating a copy of the original
-    // state of each LED at the start of the transition
-    // Instead, we "fake" the look of the LERP by using an exponential average over time and using
-    // dynamically-calculated alpha values to match the look of the
-
-    float new_progress = state->transformer_->get_progress();
-    float prev_smoothed = LightTransitionTransformer::smoothed_progress(last_transition_progress_);
-    float new_smoothed = LightTransitionTransformer::smoothed_progress(new_progress);
-    this->last_transition_progress_ = new_progress;
-
+    // start.
     auto end_values = state->transformer_->get_end_values();
     ESPColor target_color = esp_color_from_light_color_values(end_values);
 
     // our transition will handle brightness, disable brightness in correction.
     this->correction_.set_local_brightness(255);
     uint8_t orig_w = target_color.w;
-    target_color *= static_cast<uint8_t>(roundf(end_values.get_brightness() * end_values.get_state() * 255.0f));
+    target_color *= q16_product_to_8(end_values.get_brightness_raw(), end_values.get_state_raw());
     // w is not scaled by brightness
     target_color.w = orig_w;
 
+    if (this->exact_transitions_ && this->take_transition_snapshot_(state->transformer_.get())) {
+      this->write_exact_transition_(state->transformer_.get(), target_color);
+      this->schedule_show();
+      return;
+    }
+
+    // Without a snapshot of the LEDs at the start of the transition we can't lerp, so we "fake" the look of the
+    // LERP by using an exponential average over time and using dynamically-calculated alpha values to match the
+    // look of the smoothed progress. Warning: ugly
+
+    float new_progress = state->transformer_->get_progress();
+    float prev_smoothed = LightTransitionTransformer::smoothed_progress(last_transition_progress_);
+    float new_smoothed = LightTransitionTransformer::smoothed_progress(new_progress);
+    this->last_transition_progress_ = new_progress;
+
     float denom = (1.0f - new_smoothed);
     float alpha = denom == 0.0f ? 0.0f : (new_smoothed - prev_smoothed) / denom;
 
@@ -245,13 +589,8 @@ void AddressableLight::write_state(LightState *state) {
     alpha255 = clamp(alpha255, 0.0f, 255.0f);
     auto alpha8 = static_cast<uint8_t>(alpha255);
 
-    if (alpha8 != 0) {
-      uint8_t inv_alpha8 = 255 - alpha8;
-      ESPColor add = target_color * alpha8;
-
-      for (auto led : *this)
-        led = add + led.get() * inv_alpha8;
-    }
+    if (alpha8 != 0)
+      this->blend(0, this->size(), target_color, alpha8);
   }
 
   this->schedule_show();
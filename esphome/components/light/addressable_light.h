@@ -245,6 +245,31 @@ class ESPColorCorrection {
     uint8_t res = uncorrected / this->max_brightness_.white;
     return res;
   }
+  /// Correct a single channel, 0 is red, 1 green, 2 blue and 3 white.
+  inline uint8_t color_correct_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    switch (channel) {
+      case 0:
+        return this->color_correct_red(value);
+      case 1:
+        return this->color_correct_green(value);
+      case 2:
+        return this->color_correct_blue(value);
+      default:
+        return this->color_correct_white(value);
+    }
+  }
+  inline uint8_t color_uncorrect_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    switch (channel) {
+      case 0:
+        return this->color_uncorrect_red(value);
+      case 1:
+        return this->color_uncorrect_green(value);
+      case 2:
+        return this->color_uncorrect_blue(value);
+      default:
+        return this->color_uncorrect_white(value);
+    }
+  }
 
  protected:
   uint8_t gamma_table_[256];
@@ -253,6 +278,28 @@ class ESPColorCorrection {
   uint8_t local_brightness_{255};
 };
 
+/// The LEDs [begin, end) of a light that changed since it was last shown.
+struct ESPDirtyRange {
+  bool empty() const { return this->begin >= this->end; }
+  void mark(int32_t index) { this->mark(index, index + 1); }
+  void mark(int32_t from, int32_t to) {
+    if (from >= to)
+      return;
+    if (this->empty()) {
+      this->begin = from;
+      this->end = to;
+    } else {
+      this->begin = std::min(this->begin, from);
+      this->end = std::max(this->end, to);
+    }
+  }
+  void clear() { this->begin = this->end = 0; }
+
+  // everything is dirty initially, the LEDs may show anything before the first show
+  int32_t begin{0};
+  int32_t end{INT32_MAX};
+};
+
 class ESPColorSettable {
  public:
   virtual void set(const ESPColor &color) = 0;
@@ -300,13 +347,17 @@ class ESPColorView : public ESPColorSettable {
     return *this;
   }
   void set(const ESPColor &color) override { this->set_rgbw(color.r, color.g, color.b, color.w); }
-  void set_red(uint8_t red) override { *this->red_ = this->color_correction_->color_correct_red(red); }
-  void set_green(uint8_t green) override { *this->green_ = this->color_correction_->color_correct_green(green); }
-  void set_blue(uint8_t blue) override { *this->blue_ = this->color_correction_->color_correct_blue(blue); }
+  void set_red(uint8_t red) override { this->write_(this->red_, this->color_correction_->color_correct_red(red)); }
+  void set_green(uint8_t green) override {
+    this->write_(this->green_, this->color_correction_->color_correct_green(green));
+  }
+  void set_blue(uint8_t blue) override {
+    this->write_(this->blue_, this->color_correction_->color_correct_blue(blue));
+  }
   void set_white(uint8_t white) override {
     if (this->white_ == nullptr)
       return;
-    *this->white_ = this->color_correction_->color_correct_white(white);
+    this->write_(this->white_, this->color_correction_->color_correct_white(white));
   }
   void set_effect_data(uint8_t effect_data) override {
     if (this->effect_data_ == nullptr)
@@ -342,14 +393,29 @@ class ESPColorView : public ESPColorSettable {
   void raw_set_color_correction(const ESPColorCorrection *color_correction) {
     this->color_correction_ = color_correction;
   }
+  /// Report changes of this LED as the given index to dirty.
+  void raw_set_dirty_range(ESPDirtyRange *dirty, int32_t index) {
+    this->dirty_ = dirty;
+    this->index_ = index;
+  }
 
  protected:
+  void write_(uint8_t *raw, uint8_t value) {
+    if (*raw == value)
+      return;
+    *raw = value;
+    if (this->dirty_ != nullptr)
+      this->dirty_->mark(this->index_);
+  }
+
   uint8_t *const red_;
   uint8_t *const green_;
   uint8_t *const blue_;
   uint8_t *const white_;
   uint8_t *const effect_data_;
   const ESPColorCorrection *color_correction_;
+  ESPDirtyRange *dirty_{nullptr};
+  int32_t index_{0};
 };
 
 class AddressableLight;
@@ -418,11 +484,23 @@ class ESPRangeIterator {
   int32_t i_;
 };
 
+/// Layout of the contiguous pixel buffer of an output, used by the bulk operations of AddressableLight.
+struct ESPPixelBuffer {
+  /// channels bytes per LED, LED i starts at pixels + i * channels.
+  uint8_t *pixels{nullptr};
+  /// 3 for RGB and 4 for RGBW outputs.
+  uint8_t channels{0};
+  /// Offsets of the red, green, blue (and white) bytes within an LED.
+  const uint8_t *offsets{nullptr};
+  /// One byte per LED, nullptr if the output has no effect data.
+  uint8_t *effect_data{nullptr};
+};
+
 class AddressableLight : public LightOutput, public Component {
  public:
   virtual int32_t size() const = 0;
-  ESPColorView operator[](int32_t index) const { return this->get_view_internal(interpret_index(index, this->size())); }
-  ESPColorView get(int32_t index) { return this->get_view_internal(interpret_index(index, this->size())); }
+  ESPColorView operator[](int32_t index) const { return this->tracked_view_(interpret_index(index, this->size())); }
+  ESPColorView get(int32_t index) { return this->tracked_view_(interpret_index(index, this->size())); }
   virtual void clear_effect_data() = 0;
   ESPRangeView range(int32_t from, int32_t to) {
     from = interpret_index(from, this->size());
@@ -450,6 +528,31 @@ class AddressableLight : public LightOutput, public Component {
       amnt = this->size();
     this->range(amnt, this->size()) = this->range(0, -amnt);
   }
+
+  /** Bulk operations on the LEDs [from, to).
+   *
+   * Outputs that registered their pixel buffer with set_pixel_buffer_() are processed one channel at a time
+   * directly on that buffer, long spans through a lookup table per channel. The results are the same as
+   * applying the operation to each ESPColorView. Outputs without a pixel buffer fall back to the views.
+   */
+  void fill(int32_t from, int32_t to, const ESPColor &color);
+  /// Set one channel (0 is red, 1 green, 2 blue and 3 white) of the LEDs.
+  void fill_channel(int32_t from, int32_t to, uint8_t channel, uint8_t value);
+  void fill_effect_data(int32_t from, int32_t to, uint8_t effect_data);
+  /// Set count LEDs starting at from to the (uncorrected) colors.
+  void set_colors(int32_t from, const ESPColor *colors, int32_t count);
+  /// Scale the LEDs by scale/256 (fade to black).
+  void scale(int32_t from, int32_t to, uint8_t scale);
+  void fade_to_white(int32_t from, int32_t to, uint8_t amnt);
+  /// Saturating add of delta to every channel (lighten).
+  void add(int32_t from, int32_t to, uint8_t delta);
+  /// Saturating subtract of delta from every channel (darken).
+  void subtract(int32_t from, int32_t to, uint8_t delta);
+  /// Mix the LEDs with color, alpha 255 is only color.
+  void blend(int32_t from, int32_t to, const ESPColor &color, uint8_t alpha);
+  /// Copy count LEDs from src to dst, the ranges may overlap.
+  void copy(int32_t dst, int32_t src, int32_t count);
+
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
   void write_state(LightState *state) override;
@@ -462,6 +565,21 @@ class AddressableLight : public LightOutput, public Component {
     this->state_parent_ = state;
   }
   void schedule_show() { this->next_show_ = true; }
+  /** Mark the LEDs [from, to) as changed.
+   *
+   * Only changed LEDs are sent to the strip, writes through this class are tracked automatically. Call this after
+   * modifying the LEDs through the underlying controller directly.
+   */
+  void mark_dirty(int32_t from, int32_t to) {
+    if (this->clamp_range_(&from, &to))
+      this->dirty_.mark(from, to);
+  }
+  /** Transition each LED exactly from its color at the start of the transition to the target color.
+   *
+   * This keeps a copy of all LEDs (one byte per channel) for the duration of the transition, in PSRAM if the
+   * ESP32 has some. Without it transitions are approximated by an exponential average towards the target.
+   */
+  void set_exact_transitions(bool exact_transitions) { this->exact_transitions_ = exact_transitions; }
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -470,30 +588,64 @@ class AddressableLight : public LightOutput, public Component {
   void call_setup() override;
 
  protected:
-  bool should_show_() const { return this->effect_active_ || this->next_show_; }
+  /// Whether a show was requested and any LED changed since the last show.
+  bool should_show_() const { return (this->effect_active_ || this->next_show_) && !this->dirty_.empty(); }
   void mark_shown_() {
     this->next_show_ = false;
+    this->dirty_.clear();
 #ifdef USE_POWER_SUPPLY
-    for (auto c : *this) {
-      if (c.get().is_on()) {
-        this->power_.request();
-        return;
-      }
-    }
-    this->power_.unrequest();
+    if (this->is_any_on_())
+      this->power_.request();
+    else
+      this->power_.unrequest();
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// The view of an LED that reports changes to this light.
+  ESPColorView tracked_view_(int32_t index) const {
+    ESPColorView view = this->get_view_internal(index);
+    view.raw_set_dirty_range(&this->dirty_, index);
+    return view;
+  }
+
+  /** Register the buffer the output keeps its LEDs in, offsets and the buffers must outlive the light.
+   *
+   * Outputs whose driver swaps buffers when sending the LEDs must register the new buffer each time.
+   */
+  void set_pixel_buffer_(uint8_t *pixels, uint8_t channels, const uint8_t *offsets, uint8_t *effect_data) {
+    this->pixel_buffer_.pixels = pixels;
+    this->pixel_buffer_.channels = channels;
+    this->pixel_buffer_.offsets = offsets;
+    this->pixel_buffer_.effect_data = effect_data;
+  }
+  /// Clamp [from, to) to the LEDs of this light, returns false if the range is empty.
+  bool clamp_range_(int32_t *from, int32_t *to) const;
+  /// Replace every channel value v of the LEDs [from, to) by f(channel, v), on uncorrected values.
+  template<typename F> void transform_(int32_t from, int32_t to, const F &f);
+  bool is_any_on_();
+  /// Snapshot the LEDs as the start of a transition, returns false if there is no memory for the snapshot.
+  bool take_transition_snapshot_(LightTransformer *transformer);
+  void write_exact_transition_(LightTransformer *transformer, const ESPColor &target);
 
   bool effect_active_{false};
   bool next_show_{true};
   ESPColorCorrection correction_{};
+  ESPPixelBuffer pixel_buffer_{};
+  /// Views handed out by the const operator[] write to the LEDs as well.
+  mutable ESPDirtyRange dirty_{};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_;
 #endif
   LightState *state_parent_{nullptr};
   float last_transition_progress_{0.0f};
   float accumulated_alpha_{0.0f};
+  bool exact_transitions_{false};
+  /// Uncorrected colors of all LEDs at the start of the transition, premultiplied by the brightness.
+  uint8_t *transition_snapshot_{nullptr};
+  /// The transition the snapshot belongs to, only used for comparison.
+  const LightTransformer *snapshot_transformer_{nullptr};
+  /// Smoothed progress of the transition when the snapshot was taken.
+  uint16_t snapshot_progress_{0};
 };
 
 }  // namespace light
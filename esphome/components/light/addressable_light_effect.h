@@ -150,10 +150,7 @@ class AddressableScanEffect : public AddressableLightEffect {
   void set_scan_width(uint32_t scan_width) { this->scan_width_ = scan_width; }
   void apply(AddressableLight &it, const ESPColor &current_color) override {
     it.all() = ESPColor::BLACK;
-
-    for (auto i = 0; i < this->scan_width_; i++) {
-      it[this->at_led_ + i] = current_color;
-    }
+    it.range(this->at_led_, this->at_led_ + this->scan_width_) = current_color;
 
     const uint32_t now = millis();
     if (now - this->last_move_ > this->move_interval_) {
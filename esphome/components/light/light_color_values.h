@@ -17,7 +17,9 @@ namespace light {
  * Not all values have to be populated though, for example a simple monochromatic light only needs
  * to access the state and brightness attributes.
  *
- * Please note all float values are automatically clamped.
+ * Please note all float values are automatically clamped. Internally they are stored in 16-bit fixed point
+ * (65535 is 1.0), so that transitions can be calculated without floating point math. Values with 8-bit
+ * precision (n / 255) are represented exactly.
  *
  * state - Whether the light should be on/off. Represented as a float for transitions.
  * brightness - The brightness of the light.
@@ -29,12 +31,12 @@ class LightColorValues {
  public:
   /// Construct the LightColorValues with all attributes enabled, but state set to 0.0
   LightColorValues()
-      : state_(0.0f),
-        brightness_(1.0f),
-        red_(1.0f),
-        green_(1.0f),
-        blue_(1.0f),
-        white_(1.0f),
+      : state_(0),
+        brightness_(Q16_ONE),
+        red_(Q16_ONE),
+        green_(Q16_ONE),
+        blue_(Q16_ONE),
+        white_(Q16_ONE),
         color_temperature_{1.0f} {}
 
   LightColorValues(float state, float brightness, float red, float green, float blue, float white,
@@ -94,14 +96,36 @@ class LightColorValues {
    * @return The linearly interpolated LightColorValues.
    */
   static LightColorValues lerp(const LightColorValues &start, const LightColorValues &end, float completion) {
-    LightColorValues v;
-    v.set_state(esphome::lerp(completion, start.get_state(), end.get_state()));
-    v.set_brightness(esphome::lerp(completion, start.get_brightness(), end.get_brightness()));
-    v.set_red(esphome::lerp(completion, start.get_red(), end.get_red()));
-    v.set_green(esphome::lerp(completion, start.get_green(), end.get_green()));
-    v.set_blue(esphome::lerp(completion, start.get_blue(), end.get_blue()));
-    v.set_white(esphome::lerp(completion, start.get_white(), end.get_white()));
-    v.set_color_temperature(esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
+    // a float has 24 bits of precision, so the conversion is exact
+    uint32_t t;
+    if (!(completion > 0.0f))
+      t = 0;
+    else if (completion >= 1.0f)
+      t = UINT32_MAX;
+    else
+      t = completion * 4294967296.0f;
+    return lerp_q32(start, end, t);
+  }
+
+  /// Same as lerp(), but with the completion in 16-bit fixed point (65535 is 1.0). Rounds to nearest.
+  static LightColorValues lerp_q16(const LightColorValues &start, const LightColorValues &end, uint16_t completion) {
+    LightColorValues v = lerp_channels_(start, end, [completion](uint16_t a, uint16_t b) -> uint16_t {
+      // fits in 32 bits, and 65535 is odd so there are no ties
+      return (a * (65535UL - completion) + b * uint32_t(completion) + 32767UL) / 65535UL;
+    });
+    v.lerp_color_temperature_(start, end, from_q16_(completion));
+    return v;
+  }
+
+  /** Same as lerp(), but with the completion in 32-bit fixed point (2^32 is 1.0). Rounds to nearest.
+   *
+   * 2^32 - 1 stands for 1.0 as well, it can't be told apart in the 16-bit results.
+   */
+  static LightColorValues lerp_q32(const LightColorValues &start, const LightColorValues &end, uint32_t completion) {
+    LightColorValues v = lerp_channels_(start, end, [completion](uint16_t a, uint16_t b) -> uint16_t {
+      return (a * ((1ULL << 32) - completion) + b * uint64_t(completion) + (1ULL << 31)) >> 32;
+    });
+    v.lerp_color_temperature_(start, end, completion / 4294967296.0f);
     return v;
   }
 
@@ -171,29 +195,29 @@ class LightColorValues {
   }
 
   /// Convert these light color values to a binary representation and write them to binary.
-  void as_binary(bool *binary) const { *binary = this->state_ == 1.0f; }
+  void as_binary(bool *binary) const { *binary = this->state_ == Q16_ONE; }
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
   void as_brightness(float *brightness, float gamma = 0) const {
-    *brightness = gamma_correct(this->state_ * this->brightness_, gamma);
+    *brightness = gamma_correct(this->get_state() * this->get_brightness(), gamma);
   }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
   void as_rgb(float *red, float *green, float *blue, float gamma = 0, bool color_interlock = false) const {
-    float brightness = this->state_ * this->brightness_;
+    float brightness = this->get_state() * this->get_brightness();
     if (color_interlock) {
-      brightness = brightness * (1.0f - this->white_);
+      brightness = brightness * (1.0f - this->get_white());
     }
-    *red = gamma_correct(brightness * this->red_, gamma);
-    *green = gamma_correct(brightness * this->green_, gamma);
-    *blue = gamma_correct(brightness * this->blue_, gamma);
+    *red = gamma_correct(brightness * this->get_red(), gamma);
+    *green = gamma_correct(brightness * this->get_green(), gamma);
+    *blue = gamma_correct(brightness * this->get_blue(), gamma);
   }
 
   /// Convert these light color values to an RGBW representation and write them to red, green, blue, white.
   void as_rgbw(float *red, float *green, float *blue, float *white, float gamma = 0,
                bool color_interlock = false) const {
     this->as_rgb(red, green, blue, gamma, color_interlock);
-    *white = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    *white = gamma_correct(this->get_state() * this->get_brightness() * this->get_white(), gamma);
   }
 
   /// Convert these light color values to an RGBWW representation with the given parameters.
@@ -204,7 +228,7 @@ class LightColorValues {
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma_correct(this->get_state() * this->get_brightness() * this->get_white(), gamma);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -220,7 +244,7 @@ class LightColorValues {
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma_correct(this->get_state() * this->get_brightness() * this->get_white(), gamma);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -238,38 +262,46 @@ class LightColorValues {
   bool operator!=(const LightColorValues &rhs) const { return !(rhs == *this); }
 
   /// Get the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  float get_state() const { return this->state_; }
+  float get_state() const { return from_q16_(this->state_); }
   /// Get the binary true/false state of these light color values.
-  bool is_on() const { return this->get_state() != 0.0f; }
+  bool is_on() const { return this->state_ != 0; }
   /// Set the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  void set_state(float state) { this->state_ = clamp(state, 0.0f, 1.0f); }
+  void set_state(float state) { this->state_ = to_q16_(state); }
   /// Set the state of these light color values as a binary true/false.
-  void set_state(bool state) { this->state_ = state ? 1.0f : 0.0f; }
+  void set_state(bool state) { this->state_ = state ? Q16_ONE : 0; }
 
   /// Get the brightness property of these light color values. In range 0.0 to 1.0
-  float get_brightness() const { return this->brightness_; }
+  float get_brightness() const { return from_q16_(this->brightness_); }
   /// Set the brightness property of these light color values. In range 0.0 to 1.0
-  void set_brightness(float brightness) { this->brightness_ = clamp(brightness, 0.0f, 1.0f); }
+  void set_brightness(float brightness) { this->brightness_ = to_q16_(brightness); }
 
   /// Get the red property of these light color values. In range 0.0 to 1.0
-  float get_red() const { return this->red_; }
+  float get_red() const { return from_q16_(this->red_); }
   /// Set the red property of these light color values. In range 0.0 to 1.0
-  void set_red(float red) { this->red_ = clamp(red, 0.0f, 1.0f); }
+  void set_red(float red) { this->red_ = to_q16_(red); }
 
   /// Get the green property of these light color values. In range 0.0 to 1.0
-  float get_green() const { return this->green_; }
+  float get_green() const { return from_q16_(this->green_); }
   /// Set the green property of these light color values. In range 0.0 to 1.0
-  void set_green(float green) { this->green_ = clamp(green, 0.0f, 1.0f); }
+  void set_green(float green) { this->green_ = to_q16_(green); }
 
   /// Get the blue property of these light color values. In range 0.0 to 1.0
-  float get_blue() const { return this->blue_; }
+  float get_blue() const { return from_q16_(this->blue_); }
   /// Set the blue property of these light color values. In range 0.0 to 1.0
-  void set_blue(float blue) { this->blue_ = clamp(blue, 0.0f, 1.0f); }
+  void set_blue(float blue) { this->blue_ = to_q16_(blue); }
 
   /// Get the white property of these light color values. In range 0.0 to 1.0
-  float get_white() const { return white_; }
+  float get_white() const { return from_q16_(this->white_); }
   /// Set the white property of these light color values. In range 0.0 to 1.0
-  void set_white(float white) { this->white_ = clamp(white, 0.0f, 1.0f); }
+  void set_white(float white) { this->white_ = to_q16_(white); }
+
+  /// The raw 16-bit fixed point values, 65535 is 1.0.
+  uint16_t get_state_raw() const { return this->state_; }
+  uint16_t get_brightness_raw() const { return this->brightness_; }
+  uint16_t get_red_raw() const { return this->red_; }
+  uint16_t get_green_raw() const { return this->green_; }
+  uint16_t get_blue_raw() const { return this->blue_; }
+  uint16_t get_white_raw() const { return this->white_; }
 
   /// Get the color temperature property of these light color values in mired.
   float get_color_temperature() const { return this->color_temperature_; }
@@ -279,12 +311,45 @@ class LightColorValues {
   }
 
  protected:
-  float state_;  ///< ON / OFF, float for transition
-  float brightness_;
-  float red_;
-  float green_;
-  float blue_;
-  float white_;
+  static const uint16_t Q16_ONE = 65535;
+
+  static uint16_t to_q16_(float value) {
+    // written so that NaN becomes 0
+    if (!(value > 0.0f))
+      return 0;
+    if (value >= 1.0f)
+      return Q16_ONE;
+    // only exactly 0 and 1 become 0 and 1, is_on() and as_binary() don't change by rounding
+    return std::min<uint32_t>(std::max<uint32_t>(value * 65535.0f + 0.5f, 1), Q16_ONE - 1);
+  }
+  static float from_q16_(uint16_t value) { return value / 65535.0f; }
+  /// Interpolate every 16-bit channel with f(start, end).
+  template<typename F>
+  static LightColorValues lerp_channels_(const LightColorValues &start, const LightColorValues &end, const F &f) {
+    LightColorValues v;
+    v.state_ = f(start.state_, end.state_);
+    v.brightness_ = f(start.brightness_, end.brightness_);
+    v.red_ = f(start.red_, end.red_);
+    v.green_ = f(start.green_, end.green_);
+    v.blue_ = f(start.blue_, end.blue_);
+    v.white_ = f(start.white_, end.white_);
+    return v;
+  }
+  void lerp_color_temperature_(const LightColorValues &start, const LightColorValues &end, float completion) {
+    if (start.color_temperature_ == end.color_temperature_) {
+      this->color_temperature_ = start.color_temperature_;
+    } else {
+      this->set_color_temperature(
+          esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
+    }
+  }
+
+  uint16_t state_;  ///< ON / OFF, not just binary for transitions
+  uint16_t brightness_;
+  uint16_t red_;
+  uint16_t green_;
+  uint16_t blue_;
+  uint16_t white_;
   float color_temperature_;  ///< Color Temperature in Mired
 };
 
@@ -0,0 +1,25 @@
+#include "light_transformer.h"
+
+namespace esphome {
+namespace light {
+
+/// round(a * b / 2^32), a must be less than 2^63.
+static uint64_t mul_q32(uint64_t a, uint32_t b) {
+  return (a >> 32) * b + (((a & UINT32_MAX) * b + (1ULL << 31)) >> 32);
+}
+
+uint32_t LightTransitionTransformer::smoothed_progress32(uint32_t x) {
+  // x^3 * (10 - x * (15 - 6 * x)), every step rounds to nearest
+  const uint32_t x3 = mul_q32(mul_q32(x, x), x);
+  const uint64_t w = (10ULL << 32) - mul_q32((15ULL << 32) - 6ULL * x, x);
+  return std::min<uint64_t>(mul_q32(w, x3), UINT32_MAX);
+}
+uint16_t LightTransitionTransformer::smoothed_progress16(uint16_t x) {
+  // x / 65535 in 32-bit fixed point is x * 65537 + x / 65535, rounded
+  const uint64_t x32 = uint64_t(x) * 65537 + (x >= 32768 ? 1 : 0);
+  const uint32_t s = LightTransitionTransformer::smoothed_progress32(std::min<uint64_t>(x32, UINT32_MAX));
+  return (uint64_t(s) * 65535 + (1ULL << 31)) >> 32;
+}
+
+}  // namespace light
+}  // namespace esphome
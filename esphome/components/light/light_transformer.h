@@ -17,7 +17,7 @@ class LightTransformer {
   LightTransformer() = delete;
 
   /// Whether this transformation is finished
-  virtual bool is_finished() { return this->get_progress() >= 1.0f; }
+  virtual bool is_finished() { return millis() - this->start_time_ >= this->length_; }
 
   /// This will be called to get the current values for output.
   virtual LightColorValues get_values() = 0;
@@ -31,9 +31,26 @@ class LightTransformer {
   virtual bool publish_at_end() = 0;
   virtual bool is_transition() = 0;
 
-  float get_progress() { return clamp((millis() - this->start_time_) / float(this->length_), 0.0f, 1.0f); }
+  float get_progress() { return this->get_progress16() / 65535.0f; }
+
+  /// The progress in 16-bit fixed point (65535 is 1.0) rounded to nearest, calculated without floating point math.
+  uint16_t get_progress16() {
+    const uint32_t elapsed = millis() - this->start_time_;
+    if (elapsed >= this->length_)
+      return 65535;
+    return (uint64_t(elapsed) * 65535 + this->length_ / 2) / this->length_;
+  }
 
  protected:
+  /// The progress in 32-bit fixed point (2^32 is 1.0) rounded to nearest, 2^32 - 1 once finished.
+  uint32_t get_progress32_() {
+    const uint32_t elapsed = millis() - this->start_time_;
+    if (elapsed >= this->length_)
+      return UINT32_MAX;
+    const uint64_t progress = ((uint64_t(elapsed) << 32) + this->length_ / 2) / this->length_;
+    return std::min<uint64_t>(progress, UINT32_MAX);
+  }
+
   const LightColorValues &get_start_values_() const { return this->start_values_; }
 
   const LightColorValues &get_target_values_() const { return this->target_values_; }
@@ -61,14 +78,22 @@ class LightTransitionTransformer : public LightTransformer {
   }
 
   LightColorValues get_values() override {
-    float v = LightTransitionTransformer::smoothed_progress(this->get_progress());
-    return LightColorValues::lerp(this->get_start_values_(), this->get_target_values_(), v);
+    uint32_t v = LightTransitionTransformer::smoothed_progress32(this->get_progress32_());
+    return LightColorValues::lerp_q32(this->get_start_values_(), this->get_target_values_(), v);
   }
 
   bool publish_at_end() override { return false; }
   bool is_transition() override { return true; }
 
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
+  /** smoothed_progress() in 32-bit fixed point (2^32 is 1.0, 2^32 - 1 stands for 1.0 as well).
+   *
+   * Calculated with integer math only, the result is within 12 / 2^32 of the exact value. That is precise enough
+   * for the values of a transition to round to the same 16-bit (and 8-bit) values as the exact calculation.
+   */
+  static uint32_t smoothed_progress32(uint32_t x);
+  /// smoothed_progress() in 16-bit fixed point (65535 is 1.0).
+  static uint16_t smoothed_progress16(uint16_t x);
 };
 
 class LightFlashTransformer : public LightTransformer {
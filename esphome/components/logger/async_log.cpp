@@ -0,0 +1,409 @@
+#include "async_log.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include "esphome/core/helpers.h"
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+static const size_t RECORD_ALIGN = alignof(AsyncLogRecord);
+
+enum AsyncLogArgType : uint8_t {
+  ASYNC_LOG_ARG_NONE,
+  ASYNC_LOG_ARG_INT,
+  ASYNC_LOG_ARG_LONG,
+  ASYNC_LOG_ARG_LONG_LONG,
+  ASYNC_LOG_ARG_DOUBLE,
+  ASYNC_LOG_ARG_POINTER,
+  ASYNC_LOG_ARG_STRING,
+  /// %n, the pointer is consumed but nothing is written.
+  ASYNC_LOG_ARG_COUNT,
+  /// Conversions we can't pack (long double, wide strings), everything after it is output verbatim.
+  ASYNC_LOG_ARG_UNSUPPORTED,
+};
+
+struct AsyncLogSpec {
+  /// One past the conversion character.
+  const char *end;
+  AsyncLogArgType type;
+  bool width_star;
+  bool precision_star;
+  /// Literal precision, -1 if none was given.
+  int precision;
+};
+
+static inline char read_format_char(const char *p, bool in_flash) {
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+  if (in_flash)
+    return static_cast<char>(pgm_read_byte(p));
+#endif
+  return *p;
+}
+
+static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+/// Parse a conversion specification, p points to the character after the '%'.
+static AsyncLogSpec parse_spec(const char *p, bool in_flash) {
+  AsyncLogSpec spec{};
+  spec.precision = -1;
+  char c = read_format_char(p, in_flash);
+  while (c == '-' || c == '+' || c == ' ' || c == '#' || c == '0')
+    c = read_format_char(++p, in_flash);
+  if (c == '*') {
+    spec.width_star = true;
+    c = read_format_char(++p, in_flash);
+  } else {
+    while (is_digit(c))
+      c = read_format_char(++p, in_flash);
+  }
+  if (c == '.') {
+    c = read_format_char(++p, in_flash);
+    if (c == '*') {
+      spec.precision_star = true;
+      c = read_format_char(++p, in_flash);
+    } else {
+      spec.precision = 0;
+      while (is_digit(c)) {
+        spec.precision = spec.precision * 10 + (c - '0');
+        c = read_format_char(++p, in_flash);
+      }
+    }
+  }
+
+  uint8_t longs = 0;
+  bool long_double = false;
+  if (c == 'h') {
+    c = read_format_char(++p, in_flash);
+    if (c == 'h')
+      c = read_format_char(++p, in_flash);
+  } else if (c == 'l') {
+    longs = 1;
+    c = read_format_char(++p, in_flash);
+    if (c == 'l') {
+      longs = 2;
+      c = read_format_char(++p, in_flash);
+    }
+  } else if (c == 'z' || c == 't') {
+    // size_t and ptrdiff_t have the size of long on all supported platforms
+    longs = 1;
+    c = read_format_char(++p, in_flash);
+  } else if (c == 'j') {
+    longs = 2;
+    c = read_format_char(++p, in_flash);
+  } else if (c == 'L') {
+    long_double = true;
+    c = read_format_char(++p, in_flash);
+  }
+
+  switch (c) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      spec.type = longs == 0 ? ASYNC_LOG_ARG_INT : (longs == 1 ? ASYNC_LOG_ARG_LONG : ASYNC_LOG_ARG_LONG_LONG);
+      break;
+    case 'c':
+      spec.type = longs == 0 ? ASYNC_LOG_ARG_INT : ASYNC_LOG_ARG_UNSUPPORTED;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.type = long_double ? ASYNC_LOG_ARG_UNSUPPORTED : ASYNC_LOG_ARG_DOUBLE;
+      break;
+    case 's':
+      spec.type = longs == 0 ? ASYNC_LOG_ARG_STRING : ASYNC_LOG_ARG_UNSUPPORTED;
+      break;
+    case 'p':
+      spec.type = ASYNC_LOG_ARG_POINTER;
+      break;
+    case 'n':
+      spec.type = ASYNC_LOG_ARG_COUNT;
+      break;
+    case '%':
+      spec.type = ASYNC_LOG_ARG_NONE;
+      break;
+    default:
+      spec.type = ASYNC_LOG_ARG_UNSUPPORTED;
+      return spec;
+  }
+  spec.end = p + 1;
+  return spec;
+}
+
+template<typename T> static inline size_t pack_value(uint8_t *dst, size_t at, size_t capacity, T value) {
+  if (dst != nullptr && at + sizeof(T) <= capacity)
+    memcpy(dst + at, &value, sizeof(T));
+  return at + sizeof(T);
+}
+template<typename T> static inline T unpack_value(const uint8_t *&src) {
+  T value;
+  memcpy(&value, src, sizeof(T));
+  src += sizeof(T);
+  return value;
+}
+
+void AsyncLogBuffer::init(size_t capacity, size_t max_string_length) {
+  this->capacity_ = capacity - capacity % RECORD_ALIGN;
+  this->max_string_length_ = max_string_length;
+  this->buffer_ = new uint8_t[this->capacity_];
+}
+
+bool AsyncLogBuffer::push(uint8_t level, const char *tag, int line, const char *format, bool format_in_flash,
+                          va_list args) {
+#ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&this->lock_);
+  bool ret = this->push_(level, tag, line, format, format_in_flash, args);
+  portEXIT_CRITICAL(&this->lock_);
+  return ret;
+#else
+  // a log call from an interrupt handler must not preempt a push() between reserve_() and publishing head_
+  InterruptLock lock;
+  return this->push_(level, tag, line, format, format_in_flash, args);
+#endif
+}
+
+bool AsyncLogBuffer::push_(uint8_t level, const char *tag, int line, const char *format, bool format_in_flash,
+                           va_list args) {
+  va_list measure;
+  va_copy(measure, args);
+  size_t args_size = this->pack_args_(nullptr, 0, format, format_in_flash, measure);
+  va_end(measure);
+
+  size_t size = sizeof(AsyncLogRecord) + args_size;
+  size = (size + RECORD_ALIGN - 1) / RECORD_ALIGN * RECORD_ALIGN;
+  uint8_t *dst = size <= UINT16_MAX ? this->reserve_(size) : nullptr;
+  if (dst == nullptr) {
+    this->dropped_++;
+    return false;
+  }
+
+  auto *record = reinterpret_cast<AsyncLogRecord *>(dst);
+  record->size = size;
+  record->level = level;
+  record->format_in_flash = format_in_flash;
+  record->line = line;
+  record->args_size = args_size;
+  record->tag = tag;
+  record->format = format;
+  this->pack_args_(dst + sizeof(AsyncLogRecord), args_size, format, format_in_flash, args);
+
+  // the record must be complete before the consumer can see it
+  __sync_synchronize();
+  size_t head = (dst - this->buffer_) + size;
+  this->head_ = head == this->capacity_ ? 0 : head;
+  this->pushed_++;
+  return true;
+}
+
+uint8_t *AsyncLogBuffer::reserve_(size_t size) {
+  size_t head = this->head_;
+  size_t tail = this->tail_;
+  // head_ must never catch up with tail_, an equal head and tail means the buffer is empty
+  if (head >= tail) {
+    size_t to_end = this->capacity_ - head;
+    if (size < to_end || (size == to_end && tail != 0))
+      return this->buffer_ + head;
+    if (size < tail) {
+      // doesn't fit before the end, mark the rest as unused and start over at the beginning
+      reinterpret_cast<AsyncLogRecord *>(this->buffer_ + head)->size = 0;
+      return this->buffer_;
+    }
+    return nullptr;
+  }
+  if (size < tail - head)
+    return this->buffer_ + head;
+  return nullptr;
+}
+
+const AsyncLogRecord *AsyncLogBuffer::front() {
+  size_t tail = this->tail_;
+  if (tail == this->head_)
+    return nullptr;
+  __sync_synchronize();
+  auto *record = reinterpret_cast<AsyncLogRecord *>(this->buffer_ + tail);
+  if (record->size == 0) {
+    this->tail_ = tail = 0;
+    if (tail == this->head_)
+      return nullptr;
+    record = reinterpret_cast<AsyncLogRecord *>(this->buffer_);
+  }
+  return record;
+}
+
+void AsyncLogBuffer::pop() {
+  const AsyncLogRecord *record = this->front();
+  if (record == nullptr)
+    return;
+  size_t tail = this->tail_ + record->size;
+  // the record must be read completely before the producer may overwrite it
+  __sync_synchronize();
+  this->tail_ = tail == this->capacity_ ? 0 : tail;
+  this->popped_++;
+}
+
+size_t AsyncLogBuffer::pack_args_(uint8_t *dst, size_t capacity, const char *format, bool format_in_flash,
+                                  va_list args) const {
+  size_t at = 0;
+  const char *p = format;
+  for (char c = read_format_char(p, format_in_flash); c != '\0'; c = read_format_char(p, format_in_flash)) {
+    p++;
+    if (c != '%')
+      continue;
+
+    AsyncLogSpec spec = parse_spec(p, format_in_flash);
+    if (spec.type == ASYNC_LOG_ARG_UNSUPPORTED)
+      break;
+    p = spec.end;
+
+    if (spec.width_star)
+      at = pack_value<int>(dst, at, capacity, va_arg(args, int));
+    if (spec.precision_star) {
+      spec.precision = va_arg(args, int);
+      at = pack_value<int>(dst, at, capacity, spec.precision);
+    }
+
+    switch (spec.type) {
+      case ASYNC_LOG_ARG_INT:
+        at = pack_value<int>(dst, at, capacity, va_arg(args, int));
+        break;
+      case ASYNC_LOG_ARG_LONG:
+        at = pack_value<long>(dst, at, capacity, va_arg(args, long));  // NOLINT
+        break;
+      case ASYNC_LOG_ARG_LONG_LONG:
+        at = pack_value<long long>(dst, at, capacity, va_arg(args, long long));  // NOLINT
+        break;
+      case ASYNC_LOG_ARG_DOUBLE:
+        at = pack_value<double>(dst, at, capacity, va_arg(args, double));
+        break;
+      case ASYNC_LOG_ARG_POINTER:
+        at = pack_value<void *>(dst, at, capacity, va_arg(args, void *));
+        break;
+      case ASYNC_LOG_ARG_COUNT:
+        va_arg(args, void *);
+        break;
+      case ASYNC_LOG_ARG_STRING: {
+        const char *str = va_arg(args, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        size_t max_len = this->max_string_length_;
+        if (spec.precision >= 0 && size_t(spec.precision) < max_len)
+          max_len = spec.precision;
+        size_t len = strnlen(str, max_len);
+        if (dst != nullptr) {
+          // the string may have changed since the size was measured, never write past the reserved space
+          if (at + len + 1 > capacity)
+            len = at < capacity ? capacity - at - 1 : 0;
+          if (at < capacity) {
+            memcpy(dst + at, str, len);
+            dst[at + len] = '\0';
+          }
+        }
+        at += len + 1;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return at;
+}
+
+size_t AsyncLogBuffer::format(const AsyncLogRecord *record, char *out, size_t size) {
+  if (size == 0)
+    return 0;
+  const bool in_flash = record->format_in_flash;
+  const uint8_t *args = record->args();
+  const char *p = record->format;
+  size_t at = 0;
+  // the null terminator always needs a place
+  const size_t max = size - 1;
+  bool verbatim = false;
+  for (char c = read_format_char(p, in_flash); c != '\0' && at < max; c = read_format_char(p, in_flash)) {
+    if (c != '%' || verbatim) {
+      out[at++] = c;
+      p++;
+      continue;
+    }
+
+    AsyncLogSpec spec = parse_spec(p + 1, in_flash);
+    if (spec.type == ASYNC_LOG_ARG_UNSUPPORTED) {
+      // the arguments of this and all later conversions weren't packed
+      verbatim = true;
+      continue;
+    }
+
+    // copy the conversion specification, replacing '*' with the packed width and precision
+    char conversion[32];
+    size_t len = 0;
+    bool overflow = false;
+    for (const char *q = p; q != spec.end && !overflow; q++) {
+      char d = read_format_char(q, in_flash);
+      if (d == '*') {
+        int n = snprintf(conversion + len, sizeof(conversion) - len, "%d", unpack_value<int>(args));
+        len += n;
+      } else if (len < sizeof(conversion)) {
+        conversion[len++] = d;
+      }
+      overflow = len >= sizeof(conversion) - 1;
+    }
+    p = spec.end;
+    if (overflow) {
+      verbatim = true;
+      continue;
+    }
+    conversion[len] = '\0';
+
+    int ret = 0;
+    switch (spec.type) {
+      case ASYNC_LOG_ARG_NONE:
+        out[at] = '%';
+        ret = 1;
+        break;
+      case ASYNC_LOG_ARG_INT:
+        ret = snprintf(out + at, size - at, conversion, unpack_value<int>(args));
+        break;
+      case ASYNC_LOG_ARG_LONG:
+        ret = snprintf(out + at, size - at, conversion, unpack_value<long>(args));  // NOLINT
+        break;
+      case ASYNC_LOG_ARG_LONG_LONG:
+        ret = snprintf(out + at, size - at, conversion, unpack_value<long long>(args));  // NOLINT
+        break;
+      case ASYNC_LOG_ARG_DOUBLE:
+        ret = snprintf(out + at, size - at, conversion, unpack_value<double>(args));
+        break;
+      case ASYNC_LOG_ARG_POINTER:
+        ret = snprintf(out + at, size - at, conversion, unpack_value<void *>(args));
+        break;
+      case ASYNC_LOG_ARG_STRING: {
+        const char *str = reinterpret_cast<const char *>(args);
+        args += strlen(str) + 1;
+        ret = snprintf(out + at, size - at, conversion, str);
+        break;
+      }
+      default:
+        break;
+    }
+    if (ret < 0)
+      continue;
+    at += ret;
+    if (at > max)
+      at = max;
+  }
+  out[at] = '\0';
+  return at;
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include "esphome/core/esphal.h"
+
+namespace esphome {
+namespace logger {
+
+/// A single queued log call, followed in memory by its packed printf arguments.
+struct AsyncLogRecord {
+  /// Total size including this header and padding, 0 marks the end of the used part of the buffer.
+  uint16_t size;
+  uint8_t level;
+  /// Set if format points to a string stored in flash (PROGMEM).
+  bool format_in_flash;
+  uint16_t line;
+  /// Size of the packed arguments.
+  uint16_t args_size;
+  const char *tag;
+  const char *format;
+
+  const uint8_t *args() const { return reinterpret_cast<const uint8_t *>(this) + sizeof(AsyncLogRecord); }
+};
+
+/** Ring buffer of log calls whose formatting is deferred.
+ *
+ * push() only copies the level, tag, format pointer and the printf arguments into the buffer (strings passed
+ * with %s are copied, everything else is stored by value), format() later reconstructs the message. The tag and
+ * format string must therefore outlive the record, which holds for the logging macros.
+ *
+ * Records are stored contiguously: a single producer reserves at head_, a single consumer releases at tail_.
+ * The producer side is serialized because log calls can come from several contexts: with a spinlock on the ESP32,
+ * where IDF tasks log from other cores, and by disabling interrupts on the ESP8266, where interrupt handlers may log.
+ */
+class AsyncLogBuffer {
+ public:
+  /// Allocate the buffer, max_string_length bounds how many bytes of each %s argument are copied.
+  void init(size_t capacity, size_t max_string_length);
+  size_t get_capacity() const { return this->capacity_; }
+
+  /// Queue a log call, returns false (and counts it as dropped) if there was not enough space.
+  bool push(uint8_t level, const char *tag, int line, const char *format, bool format_in_flash, va_list args);
+
+  /// The oldest queued record or nullptr if the buffer is empty.
+  const AsyncLogRecord *front();
+  /// Release the record returned by front().
+  void pop();
+
+  /// Number of records pushed but not popped yet.
+  uint32_t pending() const { return this->pushed_ - this->popped_; }
+  /// Number of records dropped because the buffer was full.
+  uint32_t get_dropped_count() const { return this->dropped_; }
+
+  /** Format a record like vsnprintf() would have formatted the original call.
+   *
+   * @return The number of characters written to out, excluding the null terminator.
+   */
+  static size_t format(const AsyncLogRecord *record, char *out, size_t size);
+
+ protected:
+  bool push_(uint8_t level, const char *tag, int line, const char *format, bool format_in_flash, va_list args);
+  uint8_t *reserve_(size_t size);
+  /// Pack the printf arguments into dst (if not nullptr) and return their packed size.
+  size_t pack_args_(uint8_t *dst, size_t capacity, const char *format, bool format_in_flash, va_list args) const;
+
+  uint8_t *buffer_{nullptr};
+  size_t capacity_{0};
+  size_t max_string_length_{0};
+  volatile size_t head_{0};
+  volatile size_t tail_{0};
+  volatile uint32_t pushed_{0};
+  volatile uint32_t popped_{0};
+  volatile uint32_t dropped_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+#endif
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
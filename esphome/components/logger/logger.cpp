@@ -46,6 +46,14 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   if (level > this->level_for(tag))
     return;
 
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_active_) {
+    this->async_buffer_.push(level, tag, line, format, false, args);
+    this->enable_loop();
+    return;
+  }
+#endif
+
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -58,6 +66,14 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   if (level > this->level_for(tag))
     return;
 
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_active_) {
+    this->async_buffer_.push(level, tag, line, reinterpret_cast<const char *>(format), true, args);
+    this->enable_loop();
+    return;
+  }
+#endif
+
   this->reset_buffer_();
   // copy format string
   const char *format_pgm_p = (PGM_P) format;
@@ -116,6 +132,59 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 #endif
 }
 
+#ifdef USE_LOGGER_ASYNC
+void Logger::set_async_buffer_size(size_t size) { this->async_buffer_.init(size, this->tx_buffer_size_); }
+void Logger::process_async_(uint32_t count) {
+  for (; count != 0; count--) {
+    const AsyncLogRecord *record = this->async_buffer_.front();
+    if (record == nullptr)
+      break;
+    this->reset_buffer_();
+    this->write_header_(record->level, record->tag, record->line);
+    if (!this->is_buffer_full_()) {
+      this->tx_buffer_at_ +=
+          AsyncLogBuffer::format(record, this->tx_buffer_ + this->tx_buffer_at_, this->buffer_remaining_capacity_());
+    }
+    this->write_footer_();
+    this->log_message_(record->level, record->tag);
+#ifdef ARDUINO_ARCH_ESP32
+    // same as in log_message_(), see there
+    if (xPortGetFreeHeapSize() > 2048)
+      this->async_log_callback_.call(*record, this->tx_buffer_);
+#else
+    this->async_log_callback_.call(*record, this->tx_buffer_);
+#endif
+    this->async_buffer_.pop();
+  }
+
+  uint32_t dropped = this->async_buffer_.get_dropped_count();
+  if (dropped != this->reported_dropped_) {
+    const uint32_t count = dropped - this->reported_dropped_;
+    this->reported_dropped_ = dropped;
+    // Queued like any other message, so that compact log subscribers get it too
+    ESP_LOGW(TAG, "Dropped %u log messages, the async buffer is full!", count);
+  }
+}
+void Logger::add_on_async_log_callback(std::function<void(const AsyncLogRecord &, const char *)> &&callback) {
+  this->async_log_callback_.add(std::move(callback));
+}
+void Logger::loop() {
+  // log synchronously until the first loop() so that messages from setup() can't overflow the buffer
+  this->async_active_ = this->async_buffer_.get_capacity() != 0;
+  this->flush();
+
+  // nothing to do until the next message is queued, which enables the loop again
+  this->disable_loop();
+  if (this->async_buffer_.pending() != 0)
+    this->enable_loop();
+}
+void Logger::flush() {
+  // only process what is queued now, log callbacks may log again
+  this->process_async_(this->async_buffer_.pending());
+}
+void Logger::on_shutdown() { this->flush(); }
+#endif
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
     : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size), uart_(uart) {
   // add 1 to buffer size for null terminator
@@ -186,6 +255,9 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
+#ifdef USE_LOGGER_ASYNC
+  ESP_LOGCONFIG(TAG, "  Async Buffer Size: %u", this->async_buffer_.get_capacity());
+#endif
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
@@ -5,6 +5,9 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#ifdef USE_LOGGER_ASYNC
+#include "async_log.h"
+#endif
 
 namespace esphome {
 
@@ -40,6 +43,28 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_ASYNC
+  /** Enable asynchronous logging with a buffer of the given size in bytes.
+   *
+   * Log calls then only queue their arguments, formatting and writing to serial and the log callbacks
+   * happens in loop(). Until the first loop() messages are still written synchronously. Messages that don't fit
+   * into the buffer are dropped and counted.
+   */
+  void set_async_buffer_size(size_t size);
+  /// Number of log messages dropped because the asynchronous buffer was full.
+  uint32_t get_dropped_count() const { return this->async_buffer_.get_dropped_count(); }
+  /** Register a callback that will be called for every log message processed asynchronously.
+   *
+   * Besides the formatted message it receives the queued record, which allows forwarding the packed
+   * arguments instead of the formatted text.
+   */
+  void add_on_async_log_callback(std::function<void(const AsyncLogRecord &, const char *)> &&callback);
+  /// Output all currently queued log messages.
+  void flush();
+  void loop() override;
+  void on_shutdown() override;
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -62,6 +87,9 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+#ifdef USE_LOGGER_ASYNC
+  void process_async_(uint32_t count);
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -113,6 +141,13 @@ class Logger : public Component {
   };
   std::vector<LogLevelOverride> log_levels_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+#ifdef USE_LOGGER_ASYNC
+  AsyncLogBuffer async_buffer_;
+  CallbackManager<void(const AsyncLogRecord &, const char *)> async_log_callback_{};
+  bool async_active_{false};
+  /// Dropped count at the time it was last reported.
+  uint32_t reported_dropped_{0};
+#endif
 };
 
 extern Logger *global_logger;
@@ -15,7 +15,7 @@ void MAX31855Sensor::update() {
 
   // Conversion time typ: 170ms, max: 220ms
   auto f = std::bind(&MAX31855Sensor::read_data_, this);
-  this->set_timeout("value", 220, f);
+  this->set_timeout(fnv1_hash_static("value"), 220, f);
 }
 
 void MAX31855Sensor::setup() {
@@ -59,7 +59,7 @@ void MAX31865Sensor::update() {
 
   // Datasheet max conversion time is 55ms for 60Hz / 66ms for 50Hz
   auto f = std::bind(&MAX31865Sensor::read_data_, this);
-  this->set_timeout("value", filter_ == FILTER_60HZ ? 55 : 66, f);
+  this->set_timeout(fnv1_hash_static("value"), filter_ == FILTER_60HZ ? 55 : 66, f);
 }
 
 void MAX31865Sensor::setup() {
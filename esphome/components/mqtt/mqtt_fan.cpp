@@ -69,7 +69,7 @@ void MQTTFanComponent::setup() {
   }
 
   auto f = std::bind(&MQTTFanComponent::publish_state, this);
-  this->state_->add_on_state_callback([this, f]() { this->defer("send", f); });
+  this->state_->add_on_state_callback([this, f]() { this->defer(fnv1_hash_static("send"), f); });
 }
 bool MQTTFanComponent::send_initial_state() { return this->publish_state(); }
 std::string MQTTFanComponent::friendly_name() const { return this->state_->get_name(); }
@@ -18,7 +18,7 @@ void MQTTJSONLightComponent::setup() {
   });
 
   auto f = std::bind(&MQTTJSONLightComponent::publish_state_, this);
-  this->state_->add_new_remote_values_callback([this, f]() { this->defer("send", f); });
+  this->state_->add_new_remote_values_callback([this, f]() { this->defer(fnv1_hash_static("send"), f); });
 }
 
 MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : MQTTComponent(), state_(state) {}
@@ -31,8 +31,9 @@ void MQTTSwitchComponent::setup() {
         break;
     }
   });
-  this->switch_->add_on_state_callback(
-      [this](bool enabled) { this->defer("send", [this, enabled]() { this->publish_state(enabled); }); });
+  this->switch_->add_on_state_callback([this](bool enabled) {
+    this->defer(fnv1_hash_static("send"), [this, enabled]() { this->publish_state(enabled); });
+  });
 }
 void MQTTSwitchComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "MQTT Switch '%s': ", this->switch_->get_name().c_str());
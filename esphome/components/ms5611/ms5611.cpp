@@ -46,7 +46,7 @@ void MS5611Component::update() {
   }
 
   auto f = std::bind(&MS5611Component::read_temperature_, this);
-  this->set_timeout("temperature", 10, f);
+  this->set_timeout(fnv1_hash_static("temperature"), 10, f);
 }
 void MS5611Component::read_temperature_() {
   uint8_t bytes[3];
@@ -63,7 +63,7 @@ void MS5611Component::read_temperature_() {
   }
 
   auto f = std::bind(&MS5611Component::read_pressure_, this, raw_temperature);
-  this->set_timeout("pressure", 10, f);
+  this->set_timeout(fnv1_hash_static("pressure"), 10, f);
 }
 void MS5611Component::read_pressure_(uint32_t raw_temperature) {
   uint8_t bytes[3];
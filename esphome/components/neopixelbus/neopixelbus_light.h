@@ -78,6 +78,8 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
 
     this->effect_data_ = new uint8_t[this->size()];
     this->controller_->Begin();
+    this->set_pixel_buffer_(this->controller_->Pixels(), T_COLOR_FEATURE::PixelSize, this->rgb_offsets_,
+                            this->effect_data_);
   }
 
   void loop() override {
@@ -88,6 +90,9 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
     this->controller_->Dirty();
 
     this->controller_->Show();
+    // The ESP32 RMT and ESP8266 async UART methods swap their buffers in Show()
+    this->set_pixel_buffer_(this->controller_->Pixels(), T_COLOR_FEATURE::PixelSize, this->rgb_offsets_,
+                            this->effect_data_);
   }
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
@@ -18,10 +18,16 @@ namespace ota {
 static const char *TAG = "ota";
 
 uint8_t OTA_VERSION_1_0 = 1;
+/// WiFiServer has no accept callback, so new clients are only polled for this often.
+static const uint32_t OTA_POLL_INTERVAL = 250;
 
 void OTAComponent::setup() {
   this->server_ = new WiFiServer(this->port_);
   this->server_->begin();
+#ifdef USE_LOOP_SLEEP
+  // loop() disables itself after each poll
+  this->set_interval(fnv1_hash_static("poll"), OTA_POLL_INTERVAL, [this]() { this->enable_loop(); });
+#endif
 
   this->dump_config();
 }
@@ -46,6 +52,11 @@ void OTAComponent::loop() {
     ESP_LOGI(TAG, "Boot seems successful, resetting boot loop counter.");
     this->clean_rtc();
   }
+
+#ifdef USE_LOOP_SLEEP
+  // handle_() runs a whole update, so there's nothing to do until the poll interval enables the loop again
+  this->disable_loop();
+#endif
 }
 
 void OTAComponent::handle_() {
@@ -171,6 +182,8 @@ void OTAComponent::handle_() {
   ESP_LOGV(TAG, "OTA size is %u bytes", ota_size);
 
 #ifdef ARDUINO_ARCH_ESP8266
+  // preferences saved from now on are not written to flash anymore
+  global_preferences.sync();
   global_preferences.prevent_write(true);
 #endif
 
@@ -46,6 +46,13 @@ class PartitionLightOutput : public light::AddressableLight {
   void loop() override {
     if (this->should_show_()) {
       for (auto seg : this->segments_) {
+        // changes are tracked on the partition, pass them on to the part of the source they happened in
+        int32_t begin = std::max(this->dirty_.begin, seg.get_dst_offset());
+        int32_t end = std::min(this->dirty_.end, seg.get_dst_offset() + seg.get_size());
+        if (begin >= end)
+          continue;
+        int32_t delta = seg.get_src_offset() - seg.get_dst_offset();
+        seg.get_src()->mark_dirty(begin + delta, end + delta);
         seg.get_src()->schedule_show();
       }
       this->mark_shown_();
@@ -3,6 +3,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace pcd8544 {
 
@@ -63,26 +65,36 @@ size_t PCD8544::get_buffer_length_() {
   return size_t(this->get_width_internal()) * size_t(this->get_height_internal()) / 8u;
 }
 
+bool PCD8544::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                         size_t *rows, size_t *stride) {
+  // banks of 8 rows, each byte is a column of 8 pixels
+  *stride = this->get_width_internal();
+  *offset = x1 + (y1 / 8) * *stride;
+  *length = width;
+  *rows = (y1 + height - 1) / 8 - y1 / 8 + 1;
+  return true;
+}
+
 void HOT PCD8544::display() {
-  uint8_t col, maxcol, p;
+  // only the window that changed since the last display() is sent
+  if (!this->update_dirty_window_())
+    return;
+  const uint8_t col = this->dirty_x_low_;
+  size_t offset, length, rows, stride;
+  this->get_buffer_window_internal(col, this->dirty_y_low_, this->dirty_x_high_ - col + 1,
+                                   this->dirty_y_high_ - this->dirty_y_low_ + 1, &offset, &length, &rows, &stride);
 
-  for (p = 0; p < 6; p++) {
+  for (uint8_t p = this->dirty_y_low_ / 8, i = 0; i < rows; p++, i++) {
     this->command(this->PCD8544_SETYADDR | p);
-
-    // start at the beginning of the row
-    col = 0;
-    maxcol = this->get_width_internal() - 1;
-
     this->command(this->PCD8544_SETXADDR | col);
 
     this->start_data_();
-    for (; col <= maxcol; col++) {
-      this->write_byte(this->buffer_[(this->get_width_internal() * p) + col]);
-    }
+    this->write_array(this->buffer_ + offset + i * stride, length);
     this->end_data_();
   }
 
   this->command(this->PCD8544_SETYADDR);
+  this->reset_dirty_();
 }
 
 void HOT PCD8544::draw_absolute_pixel_internal(int x, int y, Color color) {
@@ -92,11 +104,20 @@ void HOT PCD8544::draw_absolute_pixel_internal(int x, int y, Color color) {
 
   uint16_t pos = x + (y / 8) * this->get_width_internal();
   uint8_t subpos = y % 8;
+  uint8_t value = this->buffer_[pos];
   if (color.is_on()) {
-    this->buffer_[pos] |= (1 << subpos);
+    value |= (1 << subpos);
   } else {
-    this->buffer_[pos] &= ~(1 << subpos);
+    value &= ~(1 << subpos);
   }
+  if (value == this->buffer_[pos])
+    return;
+  this->buffer_[pos] = value;
+  this->mark_dirty_(x, y);
+}
+
+void HOT PCD8544::fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) {
+  this->fill_page_buffer_(x1, y1, width, height, color);
 }
 
 void PCD8544::dump_config() {
@@ -117,11 +138,5 @@ void PCD8544::update() {
   this->display();
 }
 
-void PCD8544::fill(Color color) {
-  uint8_t fill = color.is_on() ? 0xFF : 0x00;
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
-    this->buffer_[i] = fill;
-}
-
 }  // namespace pcd8544
 }  // namespace esphome
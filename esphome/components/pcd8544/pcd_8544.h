@@ -39,12 +39,11 @@ class PCD8544 : public PollingComponent,
 
   void initialize();
   void dump_config() override;
+  /// Send the part of the buffer that changed since the last call to the display.
   void HOT display();
 
   void update() override;
 
-  void fill(Color color) override;
-
   void setup() override {
     this->setup_pins_();
     this->initialize();
@@ -52,12 +51,15 @@ class PCD8544 : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) override;
 
   void setup_pins_();
 
   void init_reset_();
 
   size_t get_buffer_length_();
+  bool get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                  size_t *rows, size_t *stride) override;
 
   void start_command_();
   void end_command_();
@@ -25,7 +25,7 @@ float PowerSupply::get_setup_priority() const { return setup_priority::IO; }
 bool PowerSupply::is_enabled() const { return this->enabled_; }
 
 void PowerSupply::request_high_power() {
-  this->cancel_timeout("power-supply-off");
+  this->cancel_timeout(fnv1_hash_static("power-supply-off"));
   this->pin_->digital_write(true);
 
   if (this->active_requests_ == 0) {
@@ -48,7 +48,7 @@ void PowerSupply::unrequest_high_power() {
 
   if (this->active_requests_ == 0) {
     // set timeout for power supply off
-    this->set_timeout("power-supply-off", this->keep_on_time_, [this]() {
+    this->set_timeout(fnv1_hash_static("power-supply-off"), this->keep_on_time_, [this]() {
       ESP_LOGD(TAG, "Disabling power supply.");
       this->pin_->digital_write(false);
       this->enabled_ = false;
@@ -8,8 +8,8 @@ from esphome.const import CONF_ABOVE, CONF_ACCURACY_DECIMALS, CONF_ALPHA, CONF_B
     CONF_EXPIRE_AFTER, CONF_FILTERS, CONF_FROM, CONF_ICON, CONF_ID, CONF_INTERNAL, \
     CONF_ON_RAW_VALUE, CONF_ON_VALUE, CONF_ON_VALUE_RANGE, CONF_SEND_EVERY, CONF_SEND_FIRST_AT, \
     CONF_TO, CONF_TRIGGER_ID, CONF_UNIT_OF_MEASUREMENT, CONF_WINDOW_SIZE, CONF_NAME, CONF_MQTT_ID, \
-    CONF_FORCE_UPDATE
-from esphome.core import CORE, coroutine, coroutine_with_priority
+    CONF_FORCE_UPDATE, CONF_TYPE_ID
+from esphome.core import CORE, ID, coroutine, coroutine_with_priority
 from esphome.util import Registry
 
 CODEOWNERS = ['@esphome/core']
@@ -61,7 +61,12 @@ SensorPublishAction = sensor_ns.class_('SensorPublishAction', automation.Action)
 
 # Filters
 Filter = sensor_ns.class_('Filter')
-MedianFilter = sensor_ns.class_('MedianFilter', Filter)
+SortedWindowFilter = sensor_ns.class_('SortedWindowFilter', Filter)
+MedianFilter = sensor_ns.class_('MedianFilter', SortedWindowFilter)
+QuantileFilter = sensor_ns.class_('QuantileFilter', SortedWindowFilter)
+MinFilter = sensor_ns.class_('MinFilter', SortedWindowFilter)
+MaxFilter = sensor_ns.class_('MaxFilter', SortedWindowFilter)
+TrimmedMeanFilter = sensor_ns.class_('TrimmedMeanFilter', SortedWindowFilter)
 SlidingWindowMovingAverageFilter = sensor_ns.class_('SlidingWindowMovingAverageFilter', Filter)
 ExponentialMovingAverageFilter = sensor_ns.class_('ExponentialMovingAverageFilter', Filter)
 LambdaFilter = sensor_ns.class_('LambdaFilter', Filter)
@@ -75,8 +80,21 @@ DeltaFilter = sensor_ns.class_('DeltaFilter', Filter)
 OrFilter = sensor_ns.class_('OrFilter', Filter)
 CalibrateLinearFilter = sensor_ns.class_('CalibrateLinearFilter', Filter)
 CalibratePolynomialFilter = sensor_ns.class_('CalibratePolynomialFilter', Filter)
+TimeWindowFilter = sensor_ns.class_('TimeWindowFilter', Filter)
+TimeWeightedAverageFilter = sensor_ns.class_('TimeWeightedAverageFilter', TimeWindowFilter)
+MaxInWindowFilter = sensor_ns.class_('MaxInWindowFilter', TimeWindowFilter)
+RateOfChangeFilter = sensor_ns.class_('RateOfChangeFilter', Filter)
+FilterChain = sensor_ns.class_('FilterChain', Filter)
 SensorInRangeCondition = sensor_ns.class_('SensorInRangeCondition', Filter)
 
+# Filters that return their result from new_value() and can therefore be fused into a FilterChain
+FUSABLE_FILTERS = [
+    OffsetFilter, MultiplyFilter, FilterOutValueFilter, MedianFilter, QuantileFilter, MinFilter, MaxFilter,
+    TrimmedMeanFilter, SlidingWindowMovingAverageFilter, ExponentialMovingAverageFilter, ThrottleFilter,
+    DeltaFilter, CalibrateLinearFilter, CalibratePolynomialFilter, TimeWeightedAverageFilter, MaxInWindowFilter,
+    RateOfChangeFilter,
+]
+
 unit_of_measurement = cv.string_strict
 accuracy_decimals = cv.int_
 icon = cv.icon
@@ -129,11 +147,12 @@ def filter_out_filter_to_code(config, filter_id):
     yield cg.new_Pvariable(filter_id, config)
 
 
-MEDIAN_SCHEMA = cv.All(cv.Schema({
+SORTED_WINDOW_SCHEMA = cv.Schema({
     cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
     cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
     cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
-}), validate_send_first_at)
+})
+MEDIAN_SCHEMA = cv.All(SORTED_WINDOW_SCHEMA, validate_send_first_at)
 
 
 @FILTER_REGISTRY.register('median', MedianFilter, MEDIAN_SCHEMA)
@@ -142,6 +161,50 @@ def median_filter_to_code(config, filter_id):
                            config[CONF_SEND_FIRST_AT])
 
 
+CONF_QUANTILE = 'quantile'
+CONF_TRIM = 'trim'
+
+QUANTILE_SCHEMA = cv.All(SORTED_WINDOW_SCHEMA.extend({
+    cv.Optional(CONF_QUANTILE, default=0.9): cv.percentage,
+}), validate_send_first_at)
+
+
+@FILTER_REGISTRY.register('quantile', QuantileFilter, QUANTILE_SCHEMA)
+def quantile_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT], config[CONF_QUANTILE])
+
+
+@FILTER_REGISTRY.register('min', MinFilter, MEDIAN_SCHEMA)
+def min_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT])
+
+
+@FILTER_REGISTRY.register('max', MaxFilter, MEDIAN_SCHEMA)
+def max_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT])
+
+
+def validate_trim(value):
+    value = cv.percentage(value)
+    if value >= 0.5:
+        raise cv.Invalid("trim must be less than 50%, it is removed from both ends of the window")
+    return value
+
+
+TRIMMED_MEAN_SCHEMA = cv.All(SORTED_WINDOW_SCHEMA.extend({
+    cv.Optional(CONF_TRIM, default=0.1): validate_trim,
+}), validate_send_first_at)
+
+
+@FILTER_REGISTRY.register('trimmed_mean', TrimmedMeanFilter, TRIMMED_MEAN_SCHEMA)
+def trimmed_mean_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT], config[CONF_TRIM])
+
+
 SLIDING_AVERAGE_SCHEMA = cv.All(cv.Schema({
     cv.Optional(CONF_WINDOW_SIZE, default=15): cv.positive_not_null_int,
     cv.Optional(CONF_SEND_EVERY, default=15): cv.positive_not_null_int,
@@ -164,6 +227,41 @@ def exponential_moving_average_filter_to_code(config, filter_id):
     yield cg.new_Pvariable(filter_id, config[CONF_ALPHA], config[CONF_SEND_EVERY])
 
 
+CONF_WINDOW = 'window'
+CONF_TIME_UNIT = 'time_unit'
+
+TIME_WINDOW_SCHEMA = cv.Schema({
+    cv.Optional(CONF_WINDOW, default='60s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SEND_EVERY, default=1): cv.positive_not_null_int,
+})
+
+
+@FILTER_REGISTRY.register('time_weighted_average', TimeWeightedAverageFilter, TIME_WINDOW_SCHEMA)
+def time_weighted_average_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW], config[CONF_SEND_EVERY])
+
+
+@FILTER_REGISTRY.register('max_in_window', MaxInWindowFilter, TIME_WINDOW_SCHEMA)
+def max_in_window_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW], config[CONF_SEND_EVERY])
+
+
+RATE_OF_CHANGE_TIME_UNITS = {
+    'ms': 1,
+    's': 1000,
+    'min': 60 * 1000,
+    'h': 60 * 60 * 1000,
+    'd': 24 * 60 * 60 * 1000,
+}
+
+
+@FILTER_REGISTRY.register('rate_of_change', RateOfChangeFilter, cv.Schema({
+    cv.Optional(CONF_TIME_UNIT, default='s'): cv.one_of(*RATE_OF_CHANGE_TIME_UNITS, lower=True),
+}))
+def rate_of_change_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, RATE_OF_CHANGE_TIME_UNITS[config[CONF_TIME_UNIT]])
+
+
 @FILTER_REGISTRY.register('lambda', LambdaFilter, cv.returning_lambda)
 def lambda_filter_to_code(config, filter_id):
     lambda_ = yield cg.process_lambda(config, [(float, 'x')],
@@ -245,7 +343,28 @@ def calibrate_polynomial_filter_to_code(config, filter_id):
 
 @coroutine
 def build_filters(config):
-    yield cg.build_registry_list(FILTER_REGISTRY, config)
+    filters = yield cg.build_registry_list(FILTER_REGISTRY, config)
+    # Fuse each run of consecutive fusable filters into a single FilterChain
+    result = []
+    run = []
+    for conf, filter_ in zip(config, filters):
+        type_id = conf[CONF_TYPE_ID]
+        if type_id.type in FUSABLE_FILTERS:
+            run.append((type_id, filter_))
+            continue
+        result.extend(fuse_filters(run))
+        run = []
+        result.append(filter_)
+    result.extend(fuse_filters(run))
+    yield result
+
+
+def fuse_filters(run):
+    if len(run) < 2:
+        return [filter_ for _, filter_ in run]
+    chain_id = ID(f'{run[0][0].id}_chain', is_declaration=True, type=FilterChain)
+    template_args = cg.TemplateArguments(*[type_id.type for type_id, _ in run])
+    return [cg.new_Pvariable(chain_id, template_args, *[filter_ for _, filter_ in run])]
 
 
 @coroutine
@@ -2,6 +2,8 @@
 #include "sensor.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace sensor {
 
@@ -15,6 +17,26 @@ void Filter::input(float value) {
   if (out.has_value())
     this->output(*out);
 }
+size_t Filter::new_values(float *values, size_t n, uint32_t period_us) {
+  // place every value at its own sample time, the sensor's sample time is the one of the last value
+  const uint32_t end_time = this->parent_->get_sample_time();
+  size_t out = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint64_t age_us = static_cast<uint64_t>(n - 1 - i) * period_us;
+    this->parent_->internal_set_sample_time(end_time - static_cast<uint32_t>(age_us / 1000));
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      values[out++] = *value;
+  }
+  this->parent_->internal_set_sample_time(end_time);
+  return out;
+}
+void Filter::input_values(float *values, size_t n, uint32_t period_us) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_values(n=%u)", this, n);
+  const size_t out = this->new_values(values, n, period_us);
+  if (out != 0)
+    this->output_values(values, out, output_period_(period_us, n, out));
+}
 void Filter::output(float value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
@@ -24,6 +46,15 @@ void Filter::output(float value) {
     this->next_->input(value);
   }
 }
+void Filter::output_values(float *values, size_t n, uint32_t period_us) {
+  if (this->next_ == nullptr) {
+    ESP_LOGVV(TAG, "Filter(%p)::output_values(n=%u) -> SENSOR", this, n);
+    this->parent_->internal_send_state_to_frontend(values[n - 1]);
+  } else {
+    ESP_LOGVV(TAG, "Filter(%p)::output_values(n=%u) -> %p", this, n, this->next_);
+    this->next_->input_values(values, n, period_us);
+  }
+}
 void Filter::initialize(Sensor *parent, Filter *next) {
   ESP_LOGVV(TAG, "Filter(%p)::initialize(parent=%p next=%p)", this, parent, next);
   this->parent_ = parent;
@@ -39,64 +70,272 @@ uint32_t Filter::calculate_remaining_interval(uint32_t input) {
   }
 }
 
-// MedianFilter
-MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MedianFilter::new_value(float value) {
-  if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
+// Block kernels
+float sum_values(const float *values, size_t n) {
+  float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    sum[0] += values[i];
+    sum[1] += values[i + 1];
+    sum[2] += values[i + 2];
+    sum[3] += values[i + 3];
+  }
+  for (; i < n; i++)
+    sum[0] += values[i];
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+float sum_squares(const float *values, size_t n) {
+  float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    sum[0] += values[i] * values[i];
+    sum[1] += values[i + 1] * values[i + 1];
+    sum[2] += values[i + 2] * values[i + 2];
+    sum[3] += values[i + 3] * values[i + 3];
+  }
+  for (; i < n; i++)
+    sum[0] += values[i] * values[i];
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+void min_max(const float *values, size_t n, float *min, float *max) {
+  if (n == 0) {
+    *min = *max = NAN;
+    return;
+  }
+  float lo[4], hi[4];
+  for (size_t j = 0; j < 4; j++)
+    lo[j] = hi[j] = values[0];
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    for (size_t j = 0; j < 4; j++) {
+      lo[j] = values[i + j] < lo[j] ? values[i + j] : lo[j];
+      hi[j] = values[i + j] > hi[j] ? values[i + j] : hi[j];
     }
-    this->queue_.push_back(value);
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
   }
+  for (; i < n; i++) {
+    lo[0] = values[i] < lo[0] ? values[i] : lo[0];
+    hi[0] = values[i] > hi[0] ? values[i] : hi[0];
+  }
+  *min = std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3]));
+  *max = std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3]));
+}
 
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
+/// The number of values until a filter that sends every send_every values sends the next one.
+static size_t values_until_send(size_t send_at, size_t send_every) {
+  return send_at < send_every ? send_every - send_at : 1;
+}
+/// Move the values that aren't NaN to the start of the block and return their count.
+static size_t remove_nan(float *values, size_t n) {
+  return std::remove_if(values, values + n, [](float value) { return isnan(value); }) - values;
+}
 
-    float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
-      } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-      }
+// SortedWindow
+SortedWindow::SortedWindow(size_t window_size) : ring_(window_size), sorted_(window_size) {}
+void SortedWindow::push(float value) {
+  if (this->ring_.capacity() == 0)
+    return;
+  this->sort_();
+  float *sorted = this->sorted_.data();
+  const size_t size = this->ring_.size();
+  // insertion position among the values that stay in the window
+  size_t insert_at;
+  if (!this->ring_.full()) {
+    insert_at = std::upper_bound(sorted, sorted + size, value) - sorted;
+    std::copy_backward(sorted + insert_at, sorted + size, sorted + size + 1);
+  } else {
+    const float evicted = this->ring_.front();
+    const size_t remove_at = std::lower_bound(sorted, sorted + size, evicted) - sorted;
+    if (value >= evicted) {
+      insert_at = std::upper_bound(sorted + remove_at + 1, sorted + size, value) - sorted - 1;
+      std::copy(sorted + remove_at + 1, sorted + insert_at + 1, sorted + remove_at);
+    } else {
+      insert_at = std::upper_bound(sorted, sorted + remove_at, value) - sorted;
+      std::copy_backward(sorted + insert_at, sorted + remove_at, sorted + remove_at + 1);
     }
+  }
+  this->ring_.push(value);
+  sorted[insert_at] = value;
+}
+void SortedWindow::push_values(const float *values, size_t n) {
+  const size_t capacity = this->ring_.capacity();
+  if (n < capacity) {
+    for (size_t i = 0; i < n; i++)
+      this->push(values[i]);
+    return;
+  }
+  this->ring_.clear();
+  for (size_t i = n - capacity; i < n; i++)
+    this->ring_.push(values[i]);
+  std::copy(values + n - capacity, values + n, this->sorted_.begin());
+  this->is_sorted_ = false;
+}
+void SortedWindow::set_window_size(size_t window_size) {
+  this->ring_.set_capacity(window_size);
+  this->sorted_.assign(window_size, 0.0f);
+  for (size_t i = 0; i < this->ring_.size(); i++)
+    this->sorted_[i] = this->ring_[i];
+  std::sort(this->sorted_.begin(), this->sorted_.begin() + this->ring_.size());
+  this->is_sorted_ = true;
+}
+void SortedWindow::sort_() const {
+  if (this->is_sorted_)
+    return;
+  std::sort(this->sorted_.begin(), this->sorted_.begin() + this->ring_.size());
+  this->is_sorted_ = true;
+}
+float SortedWindow::min() const {
+  if (this->is_sorted_)
+    return this->sorted_[0];
+  float min, max;
+  min_max(this->sorted_.data(), this->size(), &min, &max);
+  return min;
+}
+float SortedWindow::max() const {
+  if (this->is_sorted_)
+    return this->sorted_[this->size() - 1];
+  float min, max;
+  min_max(this->sorted_.data(), this->size(), &min, &max);
+  return max;
+}
+float SortedWindow::quantile(float q) const {
+  this->sort_();
+  const size_t last = this->size() - 1;
+  const float pos = q * last;
+  const size_t lower = std::min(static_cast<size_t>(pos), last);
+  const size_t upper = std::min(lower + 1, last);
+  const float frac = pos - lower;
+  if (frac <= 0.0f || lower == upper)
+    return this->sorted_[lower];
+  return this->sorted_[lower] + (this->sorted_[upper] - this->sorted_[lower]) * frac;
+}
+float SortedWindow::sum(size_t begin, size_t end) const {
+  this->sort_();
+  return sum_values(this->sorted_.data() + begin, end - begin);
+}
 
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING", this, median);
-    return median;
+// SortedWindowFilter
+SortedWindowFilter::SortedWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
+void SortedWindowFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
+void SortedWindowFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
+optional<float> SortedWindowFilter::new_value(float value) {
+  if (!isnan(value)) {
+    this->window_.push(value);
+    ESP_LOGVV(TAG, "SortedWindowFilter(%p)::new_value(%f)", this, value);
+  }
+
+  if (++this->send_at_ >= this->send_every_) {
+    this->send_at_ = 0;
+
+    float result = this->window_.empty() ? NAN : this->compute_();
+    ESP_LOGVV(TAG, "SortedWindowFilter(%p)::new_value(%f) SENDING %f", this, value, result);
+    return result;
   }
   return {};
 }
+size_t SortedWindowFilter::new_values(float *values, size_t n, uint32_t period_us) {
+  size_t out = 0;
+  for (size_t i = 0; i < n;) {
+    // the values up to the next output, only the ones that end up in the window are pushed
+    const size_t count = std::min(values_until_send(this->send_at_, this->send_every_), n - i);
+    this->window_.push_values(values + i, remove_nan(values + i, count));
+    i += count;
+    this->send_at_ += count;
+    if (this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      // every output consumed at least one value, so this doesn't overwrite unprocessed values
+      values[out++] = this->window_.empty() ? NAN : this->compute_();
+    }
+  }
+  ESP_LOGVV(TAG, "SortedWindowFilter(%p)::new_values(n=%u) SENDING %u", this, n, out);
+  return out;
+}
+uint32_t SortedWindowFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
 
-uint32_t MedianFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+// MedianFilter
+float MedianFilter::compute_() const { return this->window_.quantile(0.5f); }
+
+// QuantileFilter
+QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+    : SortedWindowFilter(window_size, send_every, send_first_at), quantile_(quantile) {}
+float QuantileFilter::compute_() const { return this->window_.quantile(this->quantile_); }
+
+// MinFilter
+float MinFilter::compute_() const { return this->window_.min(); }
+
+// MaxFilter
+float MaxFilter::compute_() const { return this->window_.max(); }
+
+// TrimmedMeanFilter
+TrimmedMeanFilter::TrimmedMeanFilter(size_t window_size, size_t send_every, size_t send_first_at, float trim)
+    : SortedWindowFilter(window_size, send_every, send_first_at), trim_(trim) {}
+float TrimmedMeanFilter::compute_() const {
+  const size_t size = this->window_.size();
+  size_t trim = static_cast<size_t>(size * this->trim_);
+  if (trim * 2 >= size)
+    trim = (size - 1) / 2;
+  return this->window_.sum(trim, size - trim) / (size - trim * 2);
+}
 
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  if (!isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_.front();
-      this->queue_.pop();
-    }
-    this->queue_.push(value);
-    this->sum_ += value;
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->queue_.set_capacity(window_size);
+  this->recalculate_sum_();
+}
+void SlidingWindowMovingAverageFilter::add_to_sum_(float value) {
+  const float y = value - this->sum_compensation_;
+  const float t = this->sum_ + y;
+  this->sum_compensation_ = (t - this->sum_) - y;
+  this->sum_ = t;
+}
+void SlidingWindowMovingAverageFilter::recalculate_sum_() {
+  this->sum_ = 0.0f;
+  this->sum_compensation_ = 0.0f;
+  this->evicted_ = 0;
+  for (size_t i = 0; i < this->queue_.size(); i++)
+    this->add_to_sum_(this->queue_[i]);
+}
+void SlidingWindowMovingAverageFilter::push_value_(float value) {
+  if (this->queue_.capacity() == 0)
+    return;
+  if (this->queue_.full()) {
+    this->add_to_sum_(-this->queue_.front());
+    this->evicted_++;
+  }
+  this->queue_.push(value);
+  if (this->evicted_ >= this->queue_.capacity()) {
+    this->recalculate_sum_();
+  } else {
+    this->add_to_sum_(value);
+  }
+}
+void SlidingWindowMovingAverageFilter::push_values_(const float *values, size_t n) {
+  const size_t capacity = this->queue_.capacity();
+  if (n < capacity || capacity == 0) {
+    for (size_t i = 0; i < n; i++)
+      this->push_value_(values[i]);
+    return;
   }
-  float average;
+  this->queue_.clear();
+  for (size_t i = n - capacity; i < n; i++)
+    this->queue_.push(values[i]);
+  this->sum_ = sum_values(values + n - capacity, capacity);
+  this->sum_compensation_ = 0.0f;
+  this->evicted_ = 0;
+}
+float SlidingWindowMovingAverageFilter::average_() const {
   if (this->queue_.empty())
-    average = 0.0f;
-  else
-    average = this->sum_ / this->queue_.size();
+    return 0.0f;
+  return this->sum_ / this->queue_.size();
+}
+optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
+  if (!isnan(value))
+    this->push_value_(value);
+  const float average = this->average_();
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
 
   if (++this->send_at_ >= this->send_every_) {
@@ -107,6 +346,21 @@ optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
   return {};
 }
 
+size_t SlidingWindowMovingAverageFilter::new_values(float *values, size_t n, uint32_t period_us) {
+  size_t out = 0;
+  for (size_t i = 0; i < n;) {
+    const size_t count = std::min(values_until_send(this->send_at_, this->send_every_), n - i);
+    this->push_values_(values + i, remove_nan(values + i, count));
+    i += count;
+    this->send_at_ += count;
+    if (this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      values[out++] = this->average_();
+    }
+  }
+  ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_values(n=%u) SENDING %u", this, n, out);
+  return out;
+}
 uint32_t SlidingWindowMovingAverageFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
 
 // ExponentialMovingAverageFilter
@@ -135,6 +389,146 @@ void ExponentialMovingAverageFilter::set_send_every(size_t send_every) { this->s
 void ExponentialMovingAverageFilter::set_alpha(float alpha) { this->alpha_ = alpha; }
 uint32_t ExponentialMovingAverageFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
 
+// TimeWindow
+TimeWindow::TimeWindow(uint32_t window_ms) : bucket_width_(std::max<uint32_t>(window_ms / TIME_WINDOW_BUCKETS, 1)) {
+  this->clear_();
+}
+void TimeWindow::clear_() {
+  for (auto &bucket : this->buckets_)
+    bucket = {0.0f, 0, NAN};
+  this->current_ = 0;
+}
+void TimeWindow::next_bucket_() {
+  this->current_ = (this->current_ + 1) % TIME_WINDOW_BUCKETS;
+  this->bucket_start_ += this->bucket_width_;
+  this->buckets_[this->current_] = {0.0f, 0, NAN};
+}
+void TimeWindow::advance(uint32_t time) {
+  if (!this->started_) {
+    this->started_ = true;
+    this->bucket_start_ = time;
+    return;
+  }
+  const int32_t elapsed = time - this->bucket_start_;
+  if (elapsed < 0)
+    // older than the current bucket, accounted to the current bucket
+    return;
+  if (uint32_t(elapsed) >= this->bucket_width_ * TIME_WINDOW_BUCKETS) {
+    // everything expired
+    this->clear_();
+    this->bucket_start_ = time;
+    return;
+  }
+  while (time - this->bucket_start_ >= this->bucket_width_)
+    this->next_bucket_();
+}
+void TimeWindow::add_held(float value, uint32_t start, uint32_t end) {
+  // only the part within the window matters
+  const uint32_t window = this->bucket_width_ * TIME_WINDOW_BUCKETS;
+  if (end - start > window)
+    start = end - window;
+  this->advance(start);
+  if (int32_t(start - this->bucket_start_) < 0)
+    start = this->bucket_start_;
+
+  while (int32_t(end - start) > 0) {
+    Bucket &bucket = this->buckets_[this->current_];
+    const uint32_t bucket_end = this->bucket_start_ + this->bucket_width_;
+    const uint32_t until = int32_t(end - bucket_end) < 0 ? end : bucket_end;
+    bucket.integral += value * (until - start);
+    bucket.duration += until - start;
+    start = until;
+    if (start == bucket_end)
+      this->next_bucket_();
+  }
+}
+void TimeWindow::add_sample(float value, uint32_t time) {
+  this->advance(time);
+  Bucket &bucket = this->buckets_[this->current_];
+  if (isnan(bucket.max) || value > bucket.max)
+    bucket.max = value;
+}
+float TimeWindow::get_integral() const {
+  float integral = 0.0f;
+  for (const auto &bucket : this->buckets_)
+    integral += bucket.integral;
+  return integral;
+}
+uint32_t TimeWindow::get_duration() const {
+  uint32_t duration = 0;
+  for (const auto &bucket : this->buckets_)
+    duration += bucket.duration;
+  return duration;
+}
+float TimeWindow::get_max() const {
+  float max = NAN;
+  for (const auto &bucket : this->buckets_) {
+    if (isnan(max) || bucket.max > max)
+      max = bucket.max;
+  }
+  return max;
+}
+
+// TimeWindowFilter
+TimeWindowFilter::TimeWindowFilter(uint32_t window_ms, size_t send_every)
+    : window_(window_ms), send_every_(send_every), send_at_(send_every - 1) {}
+optional<float> TimeWindowFilter::new_value(float value) {
+  if (isnan(value))
+    return {};
+  const uint32_t time = this->parent_->get_sample_time();
+  const float result = this->compute_(value, time);
+  ESP_LOGVV(TAG, "TimeWindowFilter(%p)::new_value(%f) at %u -> %f", this, value, time, result);
+
+  if (++this->send_at_ >= this->send_every_) {
+    this->send_at_ = 0;
+    return result;
+  }
+  return {};
+}
+uint32_t TimeWindowFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+
+// TimeWeightedAverageFilter
+float TimeWeightedAverageFilter::compute_(float value, uint32_t time) {
+  if (isnan(this->last_value_)) {
+    this->window_.advance(time);
+  } else if (int32_t(time - this->last_time_) > 0) {
+    // the previous value was the current one until now
+    this->window_.add_held(this->last_value_, this->last_time_, time);
+  }
+  this->last_value_ = value;
+  this->last_time_ = time;
+
+  const uint32_t duration = this->window_.get_duration();
+  if (duration == 0)
+    return value;
+  return this->window_.get_integral() / duration;
+}
+
+// MaxInWindowFilter
+float MaxInWindowFilter::compute_(float value, uint32_t time) {
+  this->window_.add_sample(value, time);
+  return this->window_.get_max();
+}
+
+// RateOfChangeFilter
+RateOfChangeFilter::RateOfChangeFilter(uint32_t time_unit_ms) : time_unit_ms_(time_unit_ms) {}
+optional<float> RateOfChangeFilter::new_value(float value) {
+  if (isnan(value))
+    return {};
+  const uint32_t time = this->parent_->get_sample_time();
+  optional<float> rate;
+  if (!isnan(this->last_value_)) {
+    const int32_t elapsed = time - this->last_time_;
+    if (elapsed <= 0)
+      // no time passed, wait for a later value
+      return {};
+    rate = (value - this->last_value_) * this->time_unit_ms_ / elapsed;
+  }
+  this->last_value_ = value;
+  this->last_time_ = time;
+  return rate;
+}
+
 // LambdaFilter
 LambdaFilter::LambdaFilter(lambda_filter_t lambda_filter) : lambda_filter_(std::move(lambda_filter)) {}
 const lambda_filter_t &LambdaFilter::get_lambda_filter() const { return this->lambda_filter_; }
@@ -149,13 +543,9 @@ optional<float> LambdaFilter::new_value(float value) {
 // OffsetFilter
 OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
 
-optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
-
 // MultiplyFilter
 MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
 
-optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
-
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
 
@@ -218,6 +608,19 @@ optional<float> OrFilter::new_value(float value) {
 
   return {};
 }
+size_t OrFilter::PhiNode::new_values(float *values, size_t n, uint32_t period_us) {
+  this->or_parent_->output_values(values, n, period_us);
+
+  return 0;
+}
+size_t OrFilter::new_values(float *values, size_t n, uint32_t period_us) {
+  for (Filter *filter : this->filters_) {
+    this->values_.assign(values, values + n);
+    filter->input_values(this->values_.data(), n, period_us);
+  }
+
+  return 0;
+}
 void OrFilter::initialize(Sensor *parent, Filter *next) {
   Filter::initialize(parent, next);
   for (Filter *filter : this->filters_) {
@@ -236,7 +639,10 @@ uint32_t OrFilter::expected_interval(uint32_t input) {
 }
 // DebounceFilter
 optional<float> DebounceFilter::new_value(float value) {
-  this->set_timeout("debounce", this->time_period_, [this, value]() { this->output(value); });
+  this->set_timeout(fnv1_hash_static("debounce"), this->time_period_, [this, value]() {
+    this->parent_->internal_set_sample_time(millis());
+    this->output(value);
+  });
 
   return {};
 }
@@ -256,18 +662,18 @@ optional<float> HeartbeatFilter::new_value(float value) {
 }
 uint32_t HeartbeatFilter::expected_interval(uint32_t input) { return this->time_period_; }
 void HeartbeatFilter::setup() {
-  this->set_interval("heartbeat", this->time_period_, [this]() {
+  this->set_interval(fnv1_hash_static("heartbeat"), this->time_period_, [this]() {
     ESP_LOGVV(TAG, "HeartbeatFilter(%p)::interval(has_value=%s, last_input=%f)", this, YESNO(this->has_value_),
               this->last_input_);
     if (!this->has_value_)
       return;
 
+    this->parent_->internal_set_sample_time(millis());
     this->output(this->last_input_);
   });
 }
 float HeartbeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
-optional<float> CalibrateLinearFilter::new_value(float value) { return value * this->slope_ + this->bias_; }
 CalibrateLinearFilter::CalibrateLinearFilter(float slope, float bias) : slope_(slope), bias_(bias) {}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
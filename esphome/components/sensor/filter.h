@@ -1,6 +1,7 @@
 #pragma once
 
-#include <queue>
+#include <tuple>
+#include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
@@ -27,10 +28,24 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** This will be called with a block of values from Sensor::publish_samples().
+   *
+   * The output values are written back to the start of values, which lets filters that aggregate (averages,
+   * min/max) reduce the block to a few values. The result must be the same as calling new_value() for each value
+   * in order (up to rounding for filters that sum values), which is what the default implementation does.
+   *
+   * @param values The new values, overwritten with the output values.
+   * @param n The number of new values.
+   * @param period_us The time between two consecutive values in microseconds.
+   * @return The number of output values.
+   */
+  virtual size_t new_values(float *values, size_t n, uint32_t period_us);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
   void input(float value);
+  void input_values(float *values, size_t n, uint32_t period_us);
 
   /// Return the amount of time that this filter is expected to take based on the input time interval.
   virtual uint32_t expected_interval(uint32_t input);
@@ -38,31 +53,172 @@ class Filter {
   uint32_t calculate_remaining_interval(uint32_t input);
 
   void output(float value);
+  /// Pass a block of values down the chain, only the last value of it reaches the sensor.
+  void output_values(float *values, size_t n, uint32_t period_us);
 
  protected:
   friend Sensor;
 
+  /// The average period of the output values if n input values with period_us resulted in out values.
+  static uint32_t output_period_(uint32_t period_us, size_t n, size_t out) {
+    return out == 0 ? period_us : static_cast<uint32_t>(static_cast<uint64_t>(period_us) * n / out);
+  }
+
   Filter *next_{nullptr};
   Sensor *parent_{nullptr};
 };
 
-/** Simple median filter.
+/** Block kernels for Filter::new_values().
+ *
+ * Plain loops over contiguous values with four independent accumulators, so the compiler can keep them in
+ * registers and vectorize them on targets that support it. The values must not contain NaN.
+ */
+float sum_values(const float *values, size_t n);
+float sum_squares(const float *values, size_t n);
+/// Smallest and largest of n values, both NaN if n is 0.
+void min_max(const float *values, size_t n, float *min, float *max);
+
+/** Fixed-capacity ring buffer for the windows of filters.
+ *
+ * The storage is allocated exactly once with the window size from the configuration, unlike std::deque which
+ * allocates chunks as the window fills and fragments the heap when many sensors are filtered.
+ */
+template<typename T> class FixedRingBuffer {
+ public:
+  explicit FixedRingBuffer(size_t capacity) { this->allocate_(capacity); }
+  FixedRingBuffer(const FixedRingBuffer &) = delete;
+  FixedRingBuffer &operator=(const FixedRingBuffer &) = delete;
+  ~FixedRingBuffer() { delete[] this->data_; }
+
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  /// The i-th oldest value, 0 is the oldest. Must be less than size().
+  T &operator[](size_t i) { return this->data_[this->index_(i)]; }
+  const T &operator[](size_t i) const { return this->data_[this->index_(i)]; }
+  T &front() { return this->data_[this->head_]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+
+  /// Append a value. If the buffer is full the oldest value is overwritten.
+  void push(const T &value) {
+    if (this->capacity_ == 0)
+      return;
+    if (this->full()) {
+      this->data_[this->head_] = value;
+      this->head_ = this->index_(1);
+    } else {
+      this->data_[this->index_(this->size_)] = value;
+      this->size_++;
+    }
+  }
+  /// Remove the oldest value. Must not be empty.
+  void pop() {
+    this->head_ = this->index_(1);
+    this->size_--;
+  }
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  /// Reallocate the storage, keeping the newest values that fit.
+  void set_capacity(size_t capacity) {
+    T *old_data = this->data_;
+    const size_t old_capacity = this->capacity_, old_head = this->head_, old_size = this->size_;
+    this->allocate_(capacity);
+    const size_t keep = old_size < capacity ? old_size : capacity;
+    for (size_t i = old_size - keep; i < old_size; i++)
+      this->data_[this->size_++] = old_data[(old_head + i) % old_capacity];
+    delete[] old_data;
+  }
+
+ protected:
+  void allocate_(size_t capacity) {
+    this->data_ = capacity == 0 ? nullptr : new T[capacity];
+    this->capacity_ = capacity;
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+  size_t index_(size_t i) const {
+    const size_t index = this->head_ + i;
+    return index >= this->capacity_ ? index - this->capacity_ : index;
+  }
+
+  T *data_;
+  size_t capacity_;
+  size_t head_;
+  size_t size_;
+};
+
+/** The last window_size values of a sensor, additionally kept in sorted order.
  *
- * Takes the median of the last <send_every> values and pushes it out every <send_every>.
+ * A new value replaces the oldest one: both positions are found with a binary search and only the values in
+ * between are shifted, so order statistics like the median, quantiles, minimum and maximum can be read directly
+ * instead of sorting a copy of the window for every output. All storage is allocated once up front.
  */
-class MedianFilter : public Filter {
+class SortedWindow {
  public:
-  /** Construct a MedianFilter.
+  explicit SortedWindow(size_t window_size);
+
+  /// Add a value, evicting the oldest one if the window is full.
+  void push(float value);
+  /** Add n values in order.
+   *
+   * A block that replaces the whole window is stored without sorting it, it is only sorted once a single value is
+   * pushed or a statistic other than the minimum and maximum is read.
+   */
+  void push_values(const float *values, size_t n);
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+
+  size_t size() const { return this->ring_.size(); }
+  bool empty() const { return this->ring_.empty(); }
+
+  /// The value with the given rank, 0 is the smallest. Must be less than size().
+  float at_rank(size_t rank) const {
+    this->sort_();
+    return this->sorted_[rank];
+  }
+  float min() const;
+  float max() const;
+  /// The q-quantile (0 to 1), linearly interpolated between the two closest ranks. Must not be empty.
+  float quantile(float q) const;
+  /// Sum of the values with ranks from begin (inclusive) to end (exclusive).
+  float sum(size_t begin, size_t end) const;
+
+ protected:
+  /// Sort sorted_ if it was filled by push_values().
+  void sort_() const;
+
+  /// Values in insertion order.
+  FixedRingBuffer<float> ring_;
+  /// The same values in ascending order, only the first ring_.size() entries are used.
+  mutable std::vector<float> sorted_;
+  /// Whether sorted_ is actually sorted, see push_values().
+  mutable bool is_sorted_{true};
+};
+
+/** Base class for filters that output a statistic of a sliding window of values.
+ *
+ * NaN values are not added to the window. An empty window outputs NaN.
+ */
+class SortedWindowFilter : public Filter {
+ public:
+  /** Construct a SortedWindowFilter.
    *
-   * @param window_size The number of values that should be used in median calculation.
+   * @param window_size The number of values that should be used in the calculation.
    * @param send_every After how many sensor values should a new one be pushed out.
    * @param send_first_at After how many values to forward the very first value. Defaults to the first value
    *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
    *   send_every.
    */
-  explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
+  SortedWindowFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t n, uint32_t period_us) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
@@ -70,16 +226,77 @@ class MedianFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  /// Calculate the output from the (non-empty) window.
+  virtual float compute_() const = 0;
+
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
+};
+
+/** Simple median filter.
+ *
+ * Takes the median of the last <window_size> values and pushes it out every <send_every>.
+ */
+class MedianFilter : public SortedWindowFilter {
+ public:
+  using SortedWindowFilter::SortedWindowFilter;
+
+ protected:
+  float compute_() const override;
+};
+
+/// Pushes out the given quantile (0 to 1) of the last <window_size> values every <send_every>.
+class QuantileFilter : public SortedWindowFilter {
+ public:
+  QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
+
+ protected:
+  float compute_() const override;
+
+  float quantile_;
+};
+
+/// Pushes out the smallest of the last <window_size> values every <send_every>.
+class MinFilter : public SortedWindowFilter {
+ public:
+  using SortedWindowFilter::SortedWindowFilter;
+
+ protected:
+  float compute_() const override;
+};
+
+/// Pushes out the largest of the last <window_size> values every <send_every>.
+class MaxFilter : public SortedWindowFilter {
+ public:
+  using SortedWindowFilter::SortedWindowFilter;
+
+ protected:
+  float compute_() const override;
+};
+
+/** Trimmed mean filter.
+ *
+ * Drops the lowest and highest <trim> fraction of the last <window_size> values and pushes out the average of the
+ * remaining ones every <send_every>. At least one value is always kept.
+ */
+class TrimmedMeanFilter : public SortedWindowFilter {
+ public:
+  TrimmedMeanFilter(size_t window_size, size_t send_every, size_t send_first_at, float trim);
+
+ protected:
+  float compute_() const override;
+
+  float trim_;
 };
 
 /** Simple sliding window moving average filter.
  *
  * Essentially just takes takes the average of the last window_size values and pushes them out
  * every send_every.
+ *
+ * The running sum is updated with Kahan summation and recalculated from the window every window_size values, so
+ * rounding errors can't accumulate on long-running nodes.
  */
 class SlidingWindowMovingAverageFilter : public Filter {
  public:
@@ -94,6 +311,7 @@ class SlidingWindowMovingAverageFilter : public Filter {
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t n, uint32_t period_us) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
@@ -101,11 +319,21 @@ class SlidingWindowMovingAverageFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  float sum_{0.0};
-  std::queue<float> queue_;
+  void push_value_(float value);
+  /// Add n values (without NaN) in order, a block that replaces the whole window is summed up directly.
+  void push_values_(const float *values, size_t n);
+  float average_() const;
+  void add_to_sum_(float value);
+  void recalculate_sum_();
+
+  float sum_{0.0f};
+  /// Low-order bits lost in sum_, see Kahan summation.
+  float sum_compensation_{0.0f};
+  /// Values removed from the window since the last recalculation of the sum.
+  size_t evicted_{0};
+  FixedRingBuffer<float> queue_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -132,6 +360,109 @@ class ExponentialMovingAverageFilter : public Filter {
   float alpha_;
 };
 
+/** A sliding window over the last window_ms milliseconds of sample time, made of a fixed number of buckets.
+ *
+ * Values are accounted to the bucket of their sample time and whole buckets expire as time passes. Updates are
+ * therefore O(1) amortized and the memory is constant no matter how many values arrive within the window, at the
+ * cost of the window covering between (TIME_WINDOW_BUCKETS - 1) / TIME_WINDOW_BUCKETS and all of window_ms.
+ */
+class TimeWindow {
+ public:
+  static const uint8_t TIME_WINDOW_BUCKETS = 10;
+
+  explicit TimeWindow(uint32_t window_ms);
+
+  /// Expire the buckets that are older than the window at time.
+  void advance(uint32_t time);
+  /// Add value as held from start to end, for time-weighted statistics. start must not be before the last time.
+  void add_held(float value, uint32_t start, uint32_t end);
+  /// Add a value sampled at time.
+  void add_sample(float value, uint32_t time);
+
+  /// Integral of the held values over the window, in value * milliseconds.
+  float get_integral() const;
+  /// Time covered by held values in the window in milliseconds.
+  uint32_t get_duration() const;
+  /// Largest sampled value in the window, NaN if there is none.
+  float get_max() const;
+
+ protected:
+  struct Bucket {
+    float integral;
+    uint32_t duration;
+    float max;
+  };
+
+  void clear_();
+  /// Start the next bucket.
+  void next_bucket_();
+
+  Bucket buckets_[TIME_WINDOW_BUCKETS];
+  uint8_t current_{0};
+  uint32_t bucket_width_;
+  uint32_t bucket_start_{0};
+  bool started_{false};
+};
+
+/** Base class for filters that output a statistic over a sliding time window.
+ *
+ * Values are placed in time with the sample time of the sensor (see Sensor::get_sample_time()), so they work with
+ * irregular update intervals. NaN values are ignored.
+ */
+class TimeWindowFilter : public Filter {
+ public:
+  TimeWindowFilter(uint32_t window_ms, size_t send_every);
+
+  optional<float> new_value(float value) override;
+
+  uint32_t expected_interval(uint32_t input) override;
+
+ protected:
+  /// Add the value sampled at time to the window and calculate the output.
+  virtual float compute_(float value, uint32_t time) = 0;
+
+  TimeWindow window_;
+  size_t send_every_;
+  size_t send_at_;
+};
+
+/** Time-weighted average over a sliding time window.
+ *
+ * Every value is weighted by how long it was the current value, so bursts of updates don't bias the average.
+ */
+class TimeWeightedAverageFilter : public TimeWindowFilter {
+ public:
+  using TimeWindowFilter::TimeWindowFilter;
+
+ protected:
+  float compute_(float value, uint32_t time) override;
+
+  float last_value_{NAN};
+  uint32_t last_time_{0};
+};
+
+/// Largest value within a sliding time window.
+class MaxInWindowFilter : public TimeWindowFilter {
+ public:
+  using TimeWindowFilter::TimeWindowFilter;
+
+ protected:
+  float compute_(float value, uint32_t time) override;
+};
+
+/// Change of the value per time_unit_ms milliseconds of sample time between two consecutive values.
+class RateOfChangeFilter : public Filter {
+ public:
+  explicit RateOfChangeFilter(uint32_t time_unit_ms);
+
+  optional<float> new_value(float value) override;
+
+ protected:
+  uint32_t time_unit_ms_;
+  float last_value_{NAN};
+  uint32_t last_time_{0};
+};
+
 using lambda_filter_t = std::function<optional<float>(float)>;
 
 /** This class allows for creation of simple template filters.
@@ -159,7 +490,12 @@ class OffsetFilter : public Filter {
  public:
   explicit OffsetFilter(float offset);
 
-  optional<float> new_value(float value) override;
+  optional<float> new_value(float value) override { return value + this->offset_; }
+  size_t new_values(float *values, size_t n, uint32_t period_us) override {
+    for (size_t i = 0; i < n; i++)
+      values[i] += this->offset_;
+    return n;
+  }
 
  protected:
   float offset_;
@@ -170,7 +506,12 @@ class MultiplyFilter : public Filter {
  public:
   explicit MultiplyFilter(float multiplier);
 
-  optional<float> new_value(float value) override;
+  optional<float> new_value(float value) override { return value * this->multiplier_; }
+  size_t new_values(float *values, size_t n, uint32_t period_us) override {
+    for (size_t i = 0; i < n; i++)
+      values[i] *= this->multiplier_;
+    return n;
+  }
 
  protected:
   float multiplier_;
@@ -248,12 +589,14 @@ class OrFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t n, uint32_t period_us) override;
 
  protected:
   class PhiNode : public Filter {
    public:
     PhiNode(OrFilter *or_parent);
     optional<float> new_value(float value) override;
+    size_t new_values(float *values, size_t n, uint32_t period_us) override;
 
    protected:
     OrFilter *or_parent_;
@@ -261,12 +604,19 @@ class OrFilter : public Filter {
 
   std::vector<Filter *> filters_;
   PhiNode phi_;
+  /// Copy of a block of values for each of the filters, as they modify the values in place.
+  std::vector<float> values_;
 };
 
 class CalibrateLinearFilter : public Filter {
  public:
   CalibrateLinearFilter(float slope, float bias);
-  optional<float> new_value(float value) override;
+  optional<float> new_value(float value) override { return value * this->slope_ + this->bias_; }
+  size_t new_values(float *values, size_t n, uint32_t period_us) override {
+    for (size_t i = 0; i < n; i++)
+      values[i] = values[i] * this->slope_ + this->bias_;
+    return n;
+  }
 
  protected:
   float slope_;
@@ -282,5 +632,72 @@ class CalibratePolynomialFilter : public Filter {
   std::vector<float> coefficients_;
 };
 
+/** A run of filters that is applied as a single filter.
+ *
+ * The filters are called through their concrete types instead of the virtual new_value() and the
+ * Filter::input()/output() calls between them, which lets the compiler inline the simple ones. Only filters that
+ * return their result from new_value() can be part of a chain; filters that call output() later on their own
+ * (debounce, heartbeat, or) and lambdas stay separate filters. The code generation fuses runs of the other filters
+ * into a chain automatically.
+ */
+template<typename... Ts> class FilterChain : public Filter {
+ public:
+  explicit FilterChain(Ts *... filters) : filters_(filters...) {}
+
+  void initialize(Sensor *parent, Filter *next) override {
+    Filter::initialize(parent, next);
+    this->initialize_<0>(parent);
+  }
+
+  optional<float> new_value(float value) override { return this->apply_<0>(value); }
+  size_t new_values(float *values, size_t n, uint32_t period_us) override {
+    return this->apply_values_<0>(values, n, period_us);
+  }
+
+  uint32_t expected_interval(uint32_t input) override { return this->expected_interval_<0>(input); }
+
+ protected:
+  template<size_t I> using filter_t = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+  template<size_t I> enable_if_t<(I < sizeof...(Ts)), optional<float>> apply_(float value) {
+    using T = filter_t<I>;
+    // qualified call, so it is not dispatched virtually
+    optional<float> out = std::get<I>(this->filters_)->T::new_value(value);
+    if (!out.has_value())
+      return {};
+    return this->apply_<I + 1>(*out);
+  }
+  template<size_t I> enable_if_t<(I == sizeof...(Ts)), optional<float>> apply_(float value) { return value; }
+
+  template<size_t I>
+  enable_if_t<(I < sizeof...(Ts)), size_t> apply_values_(float *values, size_t n, uint32_t period_us) {
+    using T = filter_t<I>;
+    const size_t out = std::get<I>(this->filters_)->T::new_values(values, n, period_us);
+    if (out == 0)
+      return 0;
+    return this->apply_values_<I + 1>(values, out, output_period_(period_us, n, out));
+  }
+  template<size_t I>
+  enable_if_t<(I == sizeof...(Ts)), size_t> apply_values_(float *values, size_t n, uint32_t period_us) {
+    return n;
+  }
+
+  template<size_t I> enable_if_t<(I < sizeof...(Ts))> initialize_(Sensor *parent) {
+    // stages never call output() themselves, they only need the parent (for example for the accuracy)
+    std::get<I>(this->filters_)->initialize(parent, nullptr);
+    this->initialize_<I + 1>(parent);
+  }
+  template<size_t I> enable_if_t<(I == sizeof...(Ts))> initialize_(Sensor *parent) {}
+
+  template<size_t I> enable_if_t<(I < sizeof...(Ts)), uint32_t> expected_interval_(uint32_t input) {
+    return this->expected_interval_<I + 1>(std::get<I>(this->filters_)->expected_interval(input));
+  }
+  template<size_t I> enable_if_t<(I == sizeof...(Ts)), uint32_t> expected_interval_(uint32_t input) {
+    return input;
+  }
+
+  std::tuple<Ts *...> filters_;
+};
+
 }  // namespace sensor
 }  // namespace esphome
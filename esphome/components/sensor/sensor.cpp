@@ -8,6 +8,7 @@ static const char *TAG = "sensor";
 
 void Sensor::publish_state(float state) {
   this->raw_state = state;
+  this->sample_time_ = millis();
   this->raw_callback_.call(state);
 
   ESP_LOGV(TAG, "'%s': Received new state %f", this->name_.c_str(), state);
@@ -18,6 +19,22 @@ void Sensor::publish_state(float state) {
     this->filter_list_->input(state);
   }
 }
+void Sensor::publish_samples(const float *samples, size_t n, uint32_t period_us) {
+  if (n == 0)
+    return;
+  this->raw_state = samples[n - 1];
+  this->sample_time_ = millis();
+  this->raw_callback_.call(this->raw_state);
+
+  ESP_LOGV(TAG, "'%s': Received %u samples, last %f", this->name_.c_str(), n, this->raw_state);
+
+  if (this->filter_list_ == nullptr) {
+    this->internal_send_state_to_frontend(this->raw_state);
+  } else {
+    this->samples_.assign(samples, samples + n);
+    this->filter_list_->input_values(this->samples_.data(), n, period_us);
+  }
+}
 void Sensor::push_new_value(float state) { this->publish_state(state); }
 std::string Sensor::unit_of_measurement() { return ""; }
 std::string Sensor::icon() { return ""; }
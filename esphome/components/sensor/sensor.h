@@ -100,6 +100,22 @@ class Sensor : public Nameable {
    */
   void publish_state(float state);
 
+  /** Publish a block of samples taken at a fixed rate.
+   *
+   * The whole block is passed through the filters at once, so filters can process it in bulk and only the last
+   * value that comes out of the filters (for example an average over the block) is published to the front-end.
+   * Without filters the last sample is published. The raw state is set to the last sample and raw callbacks are
+   * called once with it.
+   *
+   * The samples are copied into a block owned by the sensor for the filters to work on, so the caller's buffer
+   * is left unchanged.
+   *
+   * @param samples The samples, oldest first.
+   * @param n The number of samples.
+   * @param period_us The time between two consecutive samples in microseconds.
+   */
+  void publish_samples(const float *samples, size_t n, uint32_t period_us);
+
   /** Push a new value to the MQTT front-end.
    *
    * Note: deprecated, please use publish_state.
@@ -145,6 +161,15 @@ class Sensor : public Nameable {
 
   void internal_send_state_to_frontend(float state);
 
+  /** The millis() time the value that is currently passed through the filters was sampled at.
+   *
+   * This is the time of the publish_state() call, for blocks from publish_samples() the filters set it for every
+   * sample in the block based on the sample period, and filters that output values later (like debounce) set it to
+   * the time of their output.
+   */
+  uint32_t get_sample_time() const { return this->sample_time_; }
+  void internal_set_sample_time(uint32_t sample_time) { this->sample_time_ = sample_time; }
+
   bool get_force_update() const { return force_update_; }
   /** Set this sensor's force_update mode.
    *
@@ -185,6 +210,9 @@ class Sensor : public Nameable {
   /// Override the accuracy in decimals, otherwise the sensor's values will be used.
   optional<int8_t> accuracy_decimals_;
   Filter *filter_list_{nullptr};  ///< Store all active filters.
+  /// The block publish_samples() passes through the filters, which work on it in place.
+  std::vector<float> samples_;
+  uint32_t sample_time_{0};
   bool has_state_{false};
   bool force_update_{false};
 };
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
 #include <SPI.h>
+#include <algorithm>
 
 namespace esphome {
 namespace spi {
@@ -222,9 +223,47 @@ class SPIDevice {
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
 
+  /** Start writing rows of a buffer in chunks, for devices that send large buffers without blocking the loop.
+   *
+   * The rows are length bytes each, the first one at data and each one stride bytes after the previous one. They
+   * are sent by write_chunk() and must not change until has_chunked_write() is false.
+   */
+  void start_chunked_write(const uint8_t *data, size_t length, size_t rows, size_t stride) {
+    this->chunk_row_ = data;
+    this->chunk_length_ = length;
+    this->chunk_rows_ = length != 0 ? rows : 0;
+    this->chunk_stride_ = stride;
+    this->chunk_pos_ = 0;
+  }
+
+  /// Send up to max_length bytes of the chunked write, the device must be enabled. Returns true once it is complete.
+  bool write_chunk(size_t max_length) {
+    while (this->chunk_rows_ > 0 && max_length > 0) {
+      const size_t length = std::min(this->chunk_length_ - this->chunk_pos_, max_length);
+      this->write_array(this->chunk_row_ + this->chunk_pos_, length);
+      max_length -= length;
+      this->chunk_pos_ += length;
+      if (this->chunk_pos_ == this->chunk_length_) {
+        this->chunk_row_ += this->chunk_stride_;
+        this->chunk_rows_--;
+        this->chunk_pos_ = 0;
+      }
+    }
+    return this->chunk_rows_ == 0;
+  }
+
+  /// Whether a chunked write has been started and not completely sent yet.
+  bool has_chunked_write() const { return this->chunk_rows_ > 0; }
+
  protected:
   SPIComponent *parent_{nullptr};
   GPIOPin *cs_{nullptr};
+  /// The rest of the chunked write: rows of chunk_length_ bytes, the current one sent up to chunk_pos_.
+  const uint8_t *chunk_row_{nullptr};
+  size_t chunk_length_{0};
+  size_t chunk_rows_{0};
+  size_t chunk_stride_{0};
+  size_t chunk_pos_{0};
 };
 
 }  // namespace spi
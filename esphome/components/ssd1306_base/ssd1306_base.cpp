@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ssd1306_base {
 
@@ -107,30 +109,40 @@ void SSD1306::setup() {
   this->command(SSD1306_COMMAND_DISPLAY_ON);
 }
 void SSD1306::display() {
+  // only the window that changed since the last display() is sent
+  if (!this->update_dirty_window_())
+    return;
+  const int x1 = this->dirty_x_low_;
+  const int x2 = this->dirty_x_high_;
+  size_t offset, length, rows, stride;
+  this->get_buffer_window_internal(x1, this->dirty_y_low_, x2 - x1 + 1, this->dirty_y_high_ - this->dirty_y_low_ + 1,
+                                   &offset, &length, &rows, &stride);
+  const int page1 = this->dirty_y_low_ / 8;
+
   if (this->is_sh1106_()) {
-    this->write_display_data();
+    // no address window, each page is addressed separately; the visible columns start at column 2
+    const uint8_t column = x1 + 2;
+    for (size_t i = 0; i < rows; i++) {
+      this->command(0xB0 + page1 + i);        // row
+      this->command(0x00 | (column & 0x0F));  // lower column
+      this->command(0x10 | (column >> 4));    // higher column
+      this->write_display_data(this->buffer_ + offset + i * stride, length, 1, stride);
+    }
+    this->reset_dirty_();
     return;
   }
 
+  const uint8_t column_offset = this->model_ == SSD1306_MODEL_64_48 ? 0x20 : 0;
   this->command(SSD1306_COMMAND_COLUMN_ADDRESS);
-  switch (this->model_) {
-    case SSD1306_MODEL_64_48:
-      this->command(0x20);
-      this->command(0x20 + this->get_width_internal() - 1);
-      break;
-    default:
-      this->command(0);  // Page start address, 0
-      this->command(this->get_width_internal() - 1);
-      break;
-  }
+  this->command(column_offset + x1);
+  this->command(column_offset + x2);
 
   this->command(SSD1306_COMMAND_PAGE_ADDRESS);
-  // Page start address, 0
-  this->command(0);
-  // Page end address:
-  this->command((this->get_height_internal() / 8) - 1);
+  this->command(page1);
+  this->command(page1 + rows - 1);
 
-  this->write_display_data();
+  this->write_display_data(this->buffer_ + offset, length, rows, stride);
+  this->reset_dirty_();
 }
 bool SSD1306::is_sh1106_() const {
   return this->model_ == SH1106_MODEL_96_16 || this->model_ == SH1106_MODEL_128_32 ||
@@ -179,22 +191,34 @@ size_t SSD1306::get_buffer_length_() {
   return size_t(this->get_width_internal()) * size_t(this->get_height_internal()) / 8u;
 }
 
+bool SSD1306::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                         size_t *rows, size_t *stride) {
+  // pages of 8 rows, each byte is a column of 8 pixels
+  *stride = this->get_width_internal();
+  *offset = x1 + (y1 / 8) * *stride;
+  *length = width;
+  *rows = (y1 + height - 1) / 8 - y1 / 8 + 1;
+  return true;
+}
 void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
   uint16_t pos = x + (y / 8) * this->get_width_internal();
   uint8_t subpos = y & 0x07;
+  uint8_t value = this->buffer_[pos];
   if (color.is_on()) {
-    this->buffer_[pos] |= (1 << subpos);
+    value |= (1 << subpos);
   } else {
-    this->buffer_[pos] &= ~(1 << subpos);
+    value &= ~(1 << subpos);
   }
+  if (value == this->buffer_[pos])
+    return;
+  this->buffer_[pos] = value;
+  this->mark_dirty_(x, y);
 }
-void SSD1306::fill(Color color) {
-  uint8_t fill = color.is_on() ? 0xFF : 0x00;
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
-    this->buffer_[i] = fill;
+void HOT SSD1306::fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) {
+  this->fill_page_buffer_(x1, y1, width, height, color);
 }
 void SSD1306::init_reset_() {
   if (this->reset_pin_ != nullptr) {
@@ -22,6 +22,7 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
  public:
   void setup() override;
 
+  /// Send the part of the buffer that changed since the last call to the display.
   void display();
 
   void update() override;
@@ -32,20 +33,23 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
   void set_brightness(float brightness) { this->brightness_ = brightness; }
 
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
-  void fill(Color color) override;
 
  protected:
   virtual void command(uint8_t value) = 0;
-  virtual void write_display_data() = 0;
+  /// Write rows runs of length bytes of display data, each starting stride bytes after the previous one.
+  virtual void write_display_data(const uint8_t *data, size_t length, size_t rows, size_t stride) = 0;
   void init_reset_();
 
   bool is_sh1106_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
   size_t get_buffer_length_();
+  bool get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                  size_t *rows, size_t *stride) override;
   const char *model_str_();
 
   SSD1306Model model_{SSD1306_MODEL_128_64};
@@ -1,6 +1,8 @@
 #include "ssd1306_i2c.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ssd1306_i2c {
 
@@ -32,28 +34,10 @@ void I2CSSD1306::dump_config() {
   }
 }
 void I2CSSD1306::command(uint8_t value) { this->write_byte(0x00, value); }
-void HOT I2CSSD1306::write_display_data() {
-  if (this->is_sh1106_()) {
-    uint32_t i = 0;
-    for (uint8_t page = 0; page < this->get_height_internal() / 8; page++) {
-      this->command(0xB0 + page);  // row
-      this->command(0x02);         // lower column
-      this->command(0x10);         // higher column
-
-      for (uint8_t x = 0; x < this->get_width_internal() / 16; x++) {
-        uint8_t data[16];
-        for (uint8_t &j : data)
-          j = this->buffer_[i++];
-        this->write_bytes(0x40, data, sizeof(data));
-      }
-    }
-  } else {
-    for (uint32_t i = 0; i < this->get_buffer_length_();) {
-      uint8_t data[16];
-      for (uint8_t &j : data)
-        j = this->buffer_[i++];
-      this->write_bytes(0x40, data, sizeof(data));
-    }
+void HOT I2CSSD1306::write_display_data(const uint8_t *data, size_t length, size_t rows, size_t stride) {
+  for (size_t row = 0; row < rows; row++, data += stride) {
+    for (size_t i = 0; i < length; i += 16)
+      this->write_bytes(0x40, data + i, std::min<size_t>(16, length - i));
   }
 }
 
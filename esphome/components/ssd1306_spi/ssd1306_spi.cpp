@@ -1,6 +1,5 @@
 #include "ssd1306_spi.h"
 #include "esphome/core/log.h"
-#include "esphome/core/application.h"
 
 namespace esphome {
 namespace ssd1306_spi {
@@ -30,26 +29,12 @@ void SPISSD1306::command(uint8_t value) {
   this->write_byte(value);
   this->disable();
 }
-void HOT SPISSD1306::write_display_data() {
-  if (this->is_sh1106_()) {
-    for (uint8_t y = 0; y < this->get_height_internal() / 8; y++) {
-      this->command(0xB0 + y);
-      this->command(0x02);
-      this->command(0x10);
-      this->dc_pin_->digital_write(true);
-      for (uint8_t x = 0; x < this->get_width_internal(); x++) {
-        this->enable();
-        this->write_byte(this->buffer_[x + y * this->get_width_internal()]);
-        this->disable();
-        App.feed_wdt();
-      }
-    }
-  } else {
-    this->dc_pin_->digital_write(true);
-    this->enable();
-    this->write_array(this->buffer_, this->get_buffer_length_());
-    this->disable();
-  }
+void HOT SPISSD1306::write_display_data(const uint8_t *data, size_t length, size_t rows, size_t stride) {
+  this->dc_pin_->digital_write(true);
+  this->enable();
+  for (size_t row = 0; row < rows; row++, data += stride)
+    this->write_array(data, length);
+  this->disable();
 }
 
 }  // namespace ssd1306_spi
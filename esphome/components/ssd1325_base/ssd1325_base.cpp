@@ -119,17 +119,26 @@ void SSD1325::setup() {
   this->turn_on();    // display ON
 }
 void SSD1325::display() {
-  this->command(SSD1325_SETCOLADDR);  // set column address
-  this->command(0x00);                // set column start address
-  this->command(0x3F);                // set column end address
-  this->command(SSD1325_SETROWADDR);  // set row address
-  this->command(0x00);                // set row start address
-  if (this->model_ == SSD1327_MODEL_128_128)
-    this->command(127);  // set last row
-  else
-    this->command(63);  // set last row
+  // only the window that changed since the last display() is sent
+  if (!this->update_dirty_window_())
+    return;
+  const int x1 = this->dirty_x_low_;
+  const int y1 = this->dirty_y_low_;
+  const int y2 = this->dirty_y_high_;
+  size_t offset, length, rows, stride;
+  this->get_buffer_window_internal(x1, y1, this->dirty_x_high_ - x1 + 1, y2 - y1 + 1, &offset, &length, &rows,
+                                   &stride);
+
+  // columns are addressed in bytes
+  this->command(SSD1325_SETCOLADDR);                       // set column address
+  this->command(x1 / SSD1325_PIXELSPERBYTE);               // set column start address
+  this->command(x1 / SSD1325_PIXELSPERBYTE + length - 1);  // set column end address
+  this->command(SSD1325_SETROWADDR);                       // set row address
+  this->command(y1);                                       // set row start address
+  this->command(y2);                                       // set last row
 
-  this->write_display_data();
+  this->write_display_data(this->buffer_ + offset, length, rows, stride);
+  this->reset_dirty_();
 }
 void SSD1325::update() {
   this->do_update_();
@@ -189,6 +198,14 @@ int SSD1325::get_width_internal() {
 size_t SSD1325::get_buffer_length_() {
   return size_t(this->get_width_internal()) * size_t(this->get_height_internal()) / SSD1325_PIXELSPERBYTE;
 }
+bool SSD1325::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                         size_t *rows, size_t *stride) {
+  *stride = this->get_width_internal() / SSD1325_PIXELSPERBYTE;
+  *offset = y1 * *stride + x1 / SSD1325_PIXELSPERBYTE;
+  *length = (x1 + width - 1) / SSD1325_PIXELSPERBYTE - x1 / SSD1325_PIXELSPERBYTE + 1;
+  *rows = height;
+  return true;
+}
 void HOT SSD1325::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
@@ -199,15 +216,32 @@ void HOT SSD1325::draw_absolute_pixel_internal(int x, int y, Color color) {
   // ensure 'color4' is valid (only 4 bits aka 1 nibble) and shift the bits left when necessary
   color4 = (color4 & SSD1325_COLORMASK) << shift;
   // first mask off the nibble we must change...
-  this->buffer_[pos] &= (~SSD1325_COLORMASK >> shift);
+  uint8_t value = this->buffer_[pos] & (~SSD1325_COLORMASK >> shift);
   // ...then lay the new nibble back on top. done!
-  this->buffer_[pos] |= color4;
+  value |= color4;
+  if (value == this->buffer_[pos])
+    return;
+  this->buffer_[pos] = value;
+  this->mark_dirty_(x, y);
 }
 void SSD1325::fill(Color color) {
   const uint32_t color4 = color.to_grayscale4();
   uint8_t fill = (color4 & SSD1325_COLORMASK) | ((color4 & SSD1325_COLORMASK) << SSD1325_COLORSHIFT);
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
-    this->buffer_[i] = fill;
+  const int stride = this->get_width_internal() / SSD1325_PIXELSPERBYTE;
+  for (int y = 0; y < this->get_height_internal(); y++) {
+    uint8_t *row = this->buffer_ + y * stride;
+    int first = -1, last = -1;
+    for (int i = 0; i < stride; i++) {
+      if (row[i] == fill)
+        continue;
+      row[i] = fill;
+      if (first == -1)
+        first = i;
+      last = i;
+    }
+    if (first != -1)
+      this->mark_dirty_(first * SSD1325_PIXELSPERBYTE, y, (last - first + 1) * SSD1325_PIXELSPERBYTE, 1);
+  }
 }
 void SSD1325::init_reset_() {
   if (this->reset_pin_ != nullptr) {
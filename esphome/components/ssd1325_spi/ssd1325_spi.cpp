@@ -42,7 +42,7 @@ void SPISSD1325::command(uint8_t value) {
     this->cs_->digital_write(true);
   this->disable();
 }
-void HOT SPISSD1325::write_display_data() {
+void HOT SPISSD1325::write_display_data(const uint8_t *data, size_t length, size_t rows, size_t stride) {
   if (this->cs_)
     this->cs_->digital_write(true);
   this->dc_pin_->digital_write(true);
@@ -50,7 +50,8 @@ void HOT SPISSD1325::write_display_data() {
     this->cs_->digital_write(false);
   delay(1);
   this->enable();
-  this->write_array(this->buffer_, this->get_buffer_length_());
+  for (size_t row = 0; row < rows; row++, data += stride)
+    this->write_array(data, length);
   if (this->cs_)
     this->cs_->digital_write(true);
   this->disable();
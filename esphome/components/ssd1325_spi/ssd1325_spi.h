@@ -20,7 +20,7 @@ class SPISSD1325 : public ssd1325_base::SSD1325,
  protected:
   void command(uint8_t value) override;
 
-  void write_display_data() override;
+  void write_display_data(const uint8_t *data, size_t length, size_t rows, size_t stride) override;
 
   GPIOPin *dc_pin_;
 };
@@ -92,14 +92,25 @@ void SSD1351::setup() {
   this->turn_on();    // display ON
 }
 void SSD1351::display() {
+  // only the window that changed since the last display() is sent
+  if (!this->update_dirty_window_())
+    return;
+  const int x1 = this->dirty_x_low_;
+  const int x2 = this->dirty_x_high_;
+  const int y1 = this->dirty_y_low_;
+  const int y2 = this->dirty_y_high_;
+
   this->command(SSD1351_SETCOLUMN);  // set column address
-  this->data(0x00);                  // set column start address
-  this->data(0x7F);                  // set column end address
+  this->data(x1);                    // set column start address
+  this->data(x2);                    // set column end address
   this->command(SSD1351_SETROW);     // set row address
-  this->data(0x00);                  // set row start address
-  this->data(0x7F);                  // set last row
+  this->data(y1);                    // set row start address
+  this->data(y2);                    // set last row
   this->command(SSD1351_WRITERAM);
-  this->write_display_data();
+  size_t offset, length, rows, stride;
+  this->get_buffer_window_internal(x1, y1, x2 - x1 + 1, y2 - y1 + 1, &offset, &length, &rows, &stride);
+  this->write_display_data(this->buffer_ + offset, length, rows, stride);
+  this->reset_dirty_();
 }
 void SSD1351::update() {
   this->do_update_();
@@ -148,23 +159,33 @@ int SSD1351::get_width_internal() {
 size_t SSD1351::get_buffer_length_() {
   return size_t(this->get_width_internal()) * size_t(this->get_height_internal()) * size_t(SSD1351_BYTESPERPIXEL);
 }
+bool SSD1351::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                         size_t *rows, size_t *stride) {
+  *stride = this->get_width_internal() * SSD1351_BYTESPERPIXEL;
+  *offset = y1 * *stride + x1 * SSD1351_BYTESPERPIXEL;
+  *length = width * SSD1351_BYTESPERPIXEL;
+  *rows = height;
+  return true;
+}
 void HOT SSD1351::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
   const uint32_t color565 = color.to_rgb_565();
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
   // where should the bits go in the big buffer array? math...
   uint16_t pos = (x + y * this->get_width_internal()) * SSD1351_BYTESPERPIXEL;
-  this->buffer_[pos++] = (color565 >> 8) & 0xff;
-  this->buffer_[pos] = color565 & 0xff;
+  if (this->buffer_[pos] == high && this->buffer_[pos + 1] == low)
+    return;
+  this->buffer_[pos++] = high;
+  this->buffer_[pos] = low;
+  this->mark_dirty_(x, y);
 }
-void SSD1351::fill(Color color) {
-  const uint32_t color565 = color.to_rgb_565();
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
-    if (i & 1) {
-      this->buffer_[i] = color565 & 0xff;
-    } else {
-      this->buffer_[i] = (color565 >> 8) & 0xff;
-    }
+void HOT SSD1351::fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) {
+  this->fill_rgb565_buffer_(x1, y1, width, height, color);
+}
+void HOT SSD1351::draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data) {
+  this->draw_rgb565_buffer_run_(x1, y1, step_x, step_y, length, data);
 }
 void SSD1351::init_reset_() {
   if (this->reset_pin_ != nullptr) {
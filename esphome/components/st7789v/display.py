@@ -12,14 +12,26 @@ ST7789V = st7789v_ns.class_('ST7789V', cg.PollingComponent, spi.SPIDevice,
                             display.DisplayBuffer)
 ST7789VRef = ST7789V.operator('ref')
 
-CONFIG_SCHEMA = display.FULL_DISPLAY_SCHEMA.extend({
+CONF_ASYNC_FLUSH = 'async_flush'
+CONF_DOUBLE_BUFFER = 'double_buffer'
+
+
+def validate_double_buffer(config):
+    if config[CONF_DOUBLE_BUFFER] and not config[CONF_ASYNC_FLUSH]:
+        raise cv.Invalid(f"{CONF_DOUBLE_BUFFER} requires {CONF_ASYNC_FLUSH} to be enabled")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(display.FULL_DISPLAY_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(ST7789V),
     cv.Required(CONF_RESET_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_CS_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_BACKLIGHT_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_BRIGHTNESS, default=1.0): cv.percentage,
-}).extend(cv.polling_component_schema('5s')).extend(spi.spi_device_schema())
+    cv.Optional(CONF_ASYNC_FLUSH, default=False): cv.boolean,
+    cv.Optional(CONF_DOUBLE_BUFFER, default=False): cv.boolean,
+}).extend(cv.polling_component_schema('5s')).extend(spi.spi_device_schema()), validate_double_buffer)
 
 
 def to_code(config):
@@ -36,6 +48,9 @@ def to_code(config):
     bl = yield cg.gpio_pin_expression(config[CONF_BACKLIGHT_PIN])
     cg.add(var.set_backlight_pin(bl))
 
+    cg.add(var.set_async_flush(config[CONF_ASYNC_FLUSH]))
+    cg.add(var.set_double_buffer(config[CONF_DOUBLE_BUFFER]))
+
     if CONF_LAMBDA in config:
         lambda_ = yield cg.process_lambda(
             config[CONF_LAMBDA], [(display.DisplayBufferRef, 'it')], return_type=cg.void)
@@ -121,23 +121,55 @@ void ST7789V::dump_config() {
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  B/L Pin: ", this->backlight_pin_);
+  ESP_LOGCONFIG(TAG, "  Async Flush: %s", YESNO(this->async_flush_));
+  ESP_LOGCONFIG(TAG, "  Double Buffer: %s", YESNO(this->back_buffer_ != nullptr));
   LOG_UPDATE_INTERVAL(this);
 }
 
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
+  if (this->is_flushing() && this->back_buffer_ == nullptr) {
+    // the only buffer is still being sent, it can't be drawn into yet
+    this->finish_flush();
+  }
   this->do_update_();
+  if (this->is_flushing()) {
+    // drawn into the back buffer, it is sent once the current frame is complete
+    this->frame_pending_ = true;
+    return;
+  }
   this->write_display_data();
 }
 
-void ST7789V::loop() {}
+void ST7789V::loop() {
+  if (!this->is_flushing())
+    return;
+  this->enable();
+  this->dc_pin_->digital_write(true);
+  const bool complete = this->write_chunk(ST7789_FLUSH_CHUNK_SIZE);
+  this->disable();
+  if (!complete)
+    return;
+  this->high_freq_.stop();
+  if (this->frame_pending_) {
+    this->frame_pending_ = false;
+    this->write_display_data();
+  }
+}
 
 void ST7789V::write_display_data() {
-  uint16_t x1 = 52;   // _offsetx
-  uint16_t x2 = 186;  // _offsetx
-  uint16_t y1 = 40;   // _offsety
-  uint16_t y2 = 279;  // _offsety
+  this->finish_flush();
+  // only the window that changed since the last write is sent
+  if (!this->update_dirty_window_())
+    return;
+
+  uint16_t x_offset = 52;  // _offsetx
+  uint16_t y_offset = 40;  // _offsety
+  const int x1 = this->dirty_x_low_;
+  const int x2 = this->dirty_x_high_;
+  const int y1 = this->dirty_y_low_;
+  const int y2 = this->dirty_y_high_;
 
   this->enable();
 
@@ -145,20 +177,38 @@ void ST7789V::write_display_data() {
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_CASET);
   this->dc_pin_->digital_write(true);
-  this->write_addr_(x1, x2);
+  this->write_addr_(x_offset + x1, x_offset + x2);
   // set page(y) address
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_RASET);
   this->dc_pin_->digital_write(true);
-  this->write_addr_(y1, y2);
+  this->write_addr_(y_offset + y1, y_offset + y2);
   // write display memory
   this->dc_pin_->digital_write(false);
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
-  this->write_array(this->buffer_, this->get_buffer_length_());
+  size_t offset, length, rows, stride;
+  this->get_buffer_window_internal(x1, y1, x2 - x1 + 1, y2 - y1 + 1, &offset, &length, &rows, &stride);
+  this->start_chunked_write(this->swap_buffers_() + offset, length, rows, stride);
+  if (this->async_flush_) {
+    // the display keeps writing to its memory when it is selected again for the next chunk
+    this->disable();
+    this->high_freq_.start();
+    return;
+  }
+  this->write_chunk(SIZE_MAX);
+  this->disable();
+}
 
+void ST7789V::finish_flush() {
+  if (!this->is_flushing())
+    return;
+  this->enable();
+  this->dc_pin_->digital_write(true);
+  this->write_chunk(SIZE_MAX);
   this->disable();
+  this->high_freq_.stop();
 }
 
 void ST7789V::init_reset_() {
@@ -231,6 +281,15 @@ size_t ST7789V::get_buffer_length_() {
   return size_t(this->get_width_internal()) * size_t(this->get_height_internal()) * 2;
 }
 
+bool ST7789V::get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                         size_t *rows, size_t *stride) {
+  *stride = this->get_width_internal() * 2;
+  *offset = y1 * *stride + x1 * 2;
+  *length = width * 2;
+  *rows = height;
+  return true;
+}
+
 // Draw a filled rectangle
 // x1: Start X coordinate
 // y1: Start Y coordinate
@@ -264,10 +323,22 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
     return;
 
   auto color565 = color.to_rgb_565();
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
+
+  uint32_t pos = (x + y * this->get_width_internal()) * 2;
+  if (this->buffer_[pos] == high && this->buffer_[pos + 1] == low)
+    return;
+  this->buffer_[pos++] = high;
+  this->buffer_[pos] = low;
+  this->mark_dirty_(x, y);
+}
 
-  uint16_t pos = (x + y * this->get_width_internal()) * 2;
-  this->buffer_[pos++] = (color565 >> 8) & 0xff;
-  this->buffer_[pos] = color565 & 0xff;
+void HOT ST7789V::fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) {
+  this->fill_rgb565_buffer_(x1, y1, width, height, color);
+}
+void HOT ST7789V::draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data) {
+  this->draw_rgb565_buffer_run_(x1, y1, step_x, step_y, length, data);
 }
 
 }  // namespace st7789v
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
 
@@ -107,6 +108,9 @@ static const uint8_t ST7789_MADCTL_GS = 0x01;
 
 static const uint8_t ST7789_MADCTL_COLOR_ORDER = ST7789_MADCTL_BGR;
 
+/// Bytes sent per loop() iteration when flushing asynchronously, about 2ms at 8MHz.
+static const size_t ST7789_FLUSH_CHUNK_SIZE = 2048;
+
 class ST7789V : public PollingComponent,
                 public display::DisplayBuffer,
                 public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_HIGH, spi::CLOCK_PHASE_TRAILING,
@@ -115,6 +119,8 @@ class ST7789V : public PollingComponent,
   void set_dc_pin(GPIOPin *dc_pin) { this->dc_pin_ = dc_pin; }
   void set_reset_pin(GPIOPin *reset_pin) { this->reset_pin_ = reset_pin; }
   void set_backlight_pin(GPIOPin *backlight_pin) { this->backlight_pin_ = backlight_pin; }
+  /// Send the frame in chunks from loop() instead of blocking update() until all of it is sent.
+  void set_async_flush(bool async_flush) { this->async_flush_ = async_flush; }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -124,12 +130,22 @@ class ST7789V : public PollingComponent,
   void update() override;
   void loop() override;
 
+  /// Send the part of the buffer that changed since the last call to the display.
   void write_display_data();
+  /// Whether a frame is still being sent asynchronously.
+  bool is_flushing() const { return this->has_chunked_write(); }
+  /// Block until the frame being sent asynchronously is complete.
+  void finish_flush();
 
  protected:
   GPIOPin *dc_pin_;
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *backlight_pin_{nullptr};
+  bool async_flush_{false};
+
+  /// A frame was rendered into the back buffer while the previous one was being sent.
+  bool frame_pending_{false};
+  HighFrequencyLoopRequester high_freq_;
 
   void init_reset_();
   void backlight_(bool onoff);
@@ -141,10 +157,14 @@ class ST7789V : public PollingComponent,
   int get_height_internal() override;
   int get_width_internal() override;
   size_t get_buffer_length_();
+  bool get_buffer_window_internal(int x1, int y1, int width, int height, size_t *offset, size_t *length,
+                                  size_t *rows, size_t *stride) override;
 
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) override;
+  void draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data) override;
 };
 
 }  // namespace st7789v
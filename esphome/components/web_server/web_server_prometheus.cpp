@@ -55,6 +55,13 @@ void WebServerPrometheus::handle_request(AsyncWebServerRequest *request) {
     this->switch_row_(stream, obj);
 #endif
 
+#ifdef USE_COMPONENT_PROFILER
+  this->component_timing_type_(stream);
+  for (auto *obj : App.get_components())
+    this->component_timing_row_(stream, obj);
+  this->timing_summary_(stream, F("esphome_app_loop_time_us"), "app", App.get_loop_timing());
+#endif
+
   request->send(stream);
 }
 
@@ -340,5 +347,54 @@ void WebServerPrometheus::switch_row_(AsyncResponseStream *stream, switch_::Swit
 }
 #endif
 
+#ifdef USE_COMPONENT_PROFILER
+void WebServerPrometheus::component_timing_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_component_loop_time_us SUMMARY\n"));
+  stream->print(F("#TYPE esphome_component_scheduler_time_us SUMMARY\n"));
+  stream->print(F("#TYPE esphome_app_loop_time_us SUMMARY\n"));
+}
+void WebServerPrometheus::component_timing_row_(AsyncResponseStream *stream, Component *obj) {
+  this->timing_summary_(stream, F("esphome_component_loop_time_us"), obj->get_component_source(),
+                        obj->get_loop_timing());
+  this->timing_summary_(stream, F("esphome_component_scheduler_time_us"), obj->get_component_source(),
+                        obj->get_scheduler_timing());
+}
+void WebServerPrometheus::timing_summary_(AsyncResponseStream *stream, const __FlashStringHelper *metric,
+                                          const char *source, const TimingHistogram &histogram) {
+  if (histogram.get_count() == 0)
+    return;
+  // Quantiles are upper bounds of the histogram buckets, quantile 1 is the exact maximum
+  const float quantiles[] = {0.5f, 0.9f, 0.99f};
+  for (float quantile : quantiles) {
+    stream->print(metric);
+    stream->print(F("{id=\""));
+    stream->print(source);
+    stream->print(F("\",quantile=\""));
+    stream->print(quantile, 2);
+    stream->print(F("\"} "));
+    stream->print(histogram.get_percentile(quantile * 100.0f));
+    stream->print('\n');
+  }
+  stream->print(metric);
+  stream->print(F("{id=\""));
+  stream->print(source);
+  stream->print(F("\",quantile=\"1\"} "));
+  stream->print(histogram.get_max());
+  stream->print('\n');
+  stream->print(metric);
+  stream->print(F("_sum{id=\""));
+  stream->print(source);
+  stream->print(F("\"} "));
+  stream->print(double(histogram.get_total()), 0);
+  stream->print('\n');
+  stream->print(metric);
+  stream->print(F("_count{id=\""));
+  stream->print(source);
+  stream->print(F("\"} "));
+  stream->print(histogram.get_count());
+  stream->print('\n');
+}
+#endif
+
 }  // namespace web_server
 }  // namespace esphome
@@ -55,6 +55,16 @@ class WebServerPrometheus {
   /// Return the switch Values state as prometheus data point
   void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
 #endif
+
+#ifdef USE_COMPONENT_PROFILER
+  /// Return the type for prometheus
+  void component_timing_type_(AsyncResponseStream *stream);
+  /// Return the loop() and scheduler execution times of a component as prometheus summaries
+  void component_timing_row_(AsyncResponseStream *stream, Component *obj);
+  /// Return a single execution time summary
+  void timing_summary_(AsyncResponseStream *stream, const __FlashStringHelper *metric, const char *source,
+                       const TimingHistogram &histogram);
+#endif
 };
 
 }  // namespace web_server
@@ -26,6 +26,8 @@ namespace esphome {
 namespace wifi {
 
 static const char *TAG = "wifi";
+/// How often loop() polls the connection and ticks mDNS while there is nothing else to do.
+static const uint32_t WIFI_IDLE_POLL_INTERVAL = 100;
 
 float WiFiComponent::get_setup_priority() const { return setup_priority::WIFI; }
 
@@ -65,6 +67,10 @@ void WiFiComponent::setup() {
 #ifdef ARDUINO_ARCH_ESP32
   network_setup_mdns();
 #endif
+#ifdef USE_LOOP_SLEEP
+  // loop() disables itself while only polling is left to do
+  this->set_interval(fnv1_hash_static("idle_poll"), WIFI_IDLE_POLL_INTERVAL, [this]() { this->enable_loop(); });
+#endif
 }
 
 void WiFiComponent::loop() {
@@ -131,6 +137,13 @@ void WiFiComponent::loop() {
   }
 
   network_tick_mdns();
+
+#ifdef USE_LOOP_SLEEP
+  if (!this->has_sta() || this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTED) {
+    // Only polling is left to do until the poll interval, a disconnect event or set_sta() enable the loop again
+    this->disable_loop();
+  }
+#endif
 }
 
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
@@ -184,7 +197,10 @@ float WiFiComponent::get_loop_priority() const {
   return 10.0f;  // before other loop components
 }
 void WiFiComponent::set_ap(const WiFiAP &ap) { this->ap_ = ap; }
-void WiFiComponent::add_sta(const WiFiAP &ap) { this->sta_.push_back(ap); }
+void WiFiComponent::add_sta(const WiFiAP &ap) {
+  this->sta_.push_back(ap);
+  this->enable_loop();
+}
 void WiFiComponent::set_sta(const WiFiAP &ap) {
   this->sta_.clear();
   this->add_sta(ap);
@@ -435,6 +435,7 @@ void WiFiComponent::wifi_event_callback_(system_event_id_t event, system_event_i
   }
 
   if (event == SYSTEM_EVENT_STA_DISCONNECTED) {
+    this->enable_loop();
     uint8_t reason = info.disconnected.reason;
     if (reason == WIFI_REASON_AUTH_EXPIRE || reason == WIFI_REASON_BEACON_TIMEOUT ||
         reason == WIFI_REASON_NO_AP_FOUND || reason == WIFI_REASON_ASSOC_FAIL ||
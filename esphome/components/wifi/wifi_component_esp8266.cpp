@@ -446,6 +446,7 @@ void WiFiComponent::wifi_event_callback(System_Event_t *event) {
 
   if (event->event == EVENT_STAMODE_DISCONNECTED) {
     global_wifi_component->error_from_callback_ = true;
+    global_wifi_component->enable_loop();
   }
 
   WiFiMockClass::_event_callback(event);
@@ -41,7 +41,7 @@ bool XiaomiMUE4094RT::parse_device(const esp32_ble_tracker::ESPBTDevice &device)
     }
     if (res->has_motion.has_value()) {
       this->publish_state(*res->has_motion);
-      this->set_timeout("motion_timeout", timeout_, [this]() { this->publish_state(false); });
+      this->set_timeout(fnv1_hash_static("motion_timeout"), timeout_, [this]() { this->publish_state(false); });
     }
     success = true;
   }
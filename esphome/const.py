@@ -49,6 +49,7 @@ CONF_AVAILABILITY = 'availability'
 CONF_AWAY = 'away'
 CONF_AWAY_CONFIG = 'away_config'
 CONF_BACKLIGHT_PIN = 'backlight_pin'
+CONF_BATCH_DELAY = 'batch_delay'
 CONF_BATTERY_LEVEL = 'battery_level'
 CONF_BATTERY_VOLTAGE = 'battery_voltage'
 CONF_BAUD_RATE = 'baud_rate'
@@ -98,6 +99,7 @@ CONF_COMMAND = 'command'
 CONF_COMMAND_TOPIC = 'command_topic'
 CONF_COMMENT = 'comment'
 CONF_COMMIT = 'commit'
+CONF_COMPACT_LOGS = 'compact_logs'
 CONF_COMPONENT_ID = 'component_id'
 CONF_COMPONENTS = 'components'
 CONF_CONDITION = 'condition'
@@ -182,6 +184,8 @@ CONF_FILTER = 'filter'
 CONF_FILTER_OUT = 'filter_out'
 CONF_FILTERS = 'filters'
 CONF_FLASH_LENGTH = 'flash_length'
+CONF_FLASH_SECTORS = 'flash_sectors'
+CONF_FLASH_WRITE_INTERVAL = 'flash_write_interval'
 CONF_FOR = 'for'
 CONF_FORCE_UPDATE = 'force_update'
 CONF_FORMALDEHYDE = 'formaldehyde'
@@ -255,6 +259,7 @@ CONF_LOCAL = 'local'
 CONF_LOG_TOPIC = 'log_topic'
 CONF_LOGGER = 'logger'
 CONF_LOGS = 'logs'
+CONF_LOOP_MODE = 'loop_mode'
 CONF_LOW = 'low'
 CONF_LOW_VOLTAGE_REFERENCE = 'low_voltage_reference'
 CONF_MAC_ADDRESS = 'mac_address'
@@ -374,6 +379,7 @@ CONF_PMC_1_0 = 'pmc_1_0'
 CONF_PMC_10_0 = 'pmc_10_0'
 CONF_PMC_2_5 = 'pmc_2_5'
 CONF_PMC_4_0 = 'pmc_4_0'
+CONF_POOL_SIZE = 'pool_size'
 CONF_PORT = 'port'
 CONF_POSITION = 'position'
 CONF_POSITION_ACTION = 'position_action'
@@ -382,8 +388,10 @@ CONF_POWER_FACTOR = 'power_factor'
 CONF_POWER_ON_VALUE = 'power_on_value'
 CONF_POWER_SAVE_MODE = 'power_save_mode'
 CONF_POWER_SUPPLY = 'power_supply'
+CONF_PREFERENCES = 'preferences'
 CONF_PRESSURE = 'pressure'
 CONF_PRIORITY = 'priority'
+CONF_PROFILER = 'profiler'
 CONF_PROMETHEUS = 'prometheus'
 CONF_PROTOCOL = 'protocol'
 CONF_PULL_MODE = 'pull_mode'
@@ -428,6 +436,7 @@ CONF_RX_PIN = 'rx_pin'
 CONF_SAFE_MODE = 'safe_mode'
 CONF_SAMSUNG = 'samsung'
 CONF_SCAN = 'scan'
+CONF_SCHEDULER = 'scheduler'
 CONF_SCL = 'scl'
 CONF_SCL_PIN = 'scl_pin'
 CONF_SDA = 'sda'
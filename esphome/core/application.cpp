@@ -11,6 +11,11 @@ namespace esphome {
 
 static const char *TAG = "app";
 
+#ifdef USE_LOOP_SLEEP
+/// Longest time the loop sleeps without anything scheduled, so that the watchdog keeps being fed.
+static const uint32_t LOOP_SLEEP_MAX_DURATION = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +32,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#if defined(USE_LOOP_SLEEP) && defined(ARDUINO_ARCH_ESP32)
+  this->loop_task_ = xTaskGetCurrentTaskHandle();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -66,16 +74,29 @@ void Application::setup() {
 void Application::loop() {
   uint32_t new_app_state = 0;
   const uint32_t start = millis();
+#ifdef USE_COMPONENT_PROFILER
+  const uint32_t start_us = micros();
+#endif
 
   this->scheduler.call();
+  bool any_looping = false;
   for (Component *component : this->looping_components_) {
-    component->call();
+    if (!component->is_loop_disabled()) {
+      any_looping = true;
+      component->call();
+      this->feed_wdt();
+    }
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
-    this->feed_wdt();
   }
   this->app_state_ = new_app_state;
+  // components with a disabled loop() don't feed the watchdog
+  this->feed_wdt();
+  global_preferences.loop();
 
+#ifdef USE_COMPONENT_PROFILER
+  this->loop_timing_.record(micros() - start_us);
+#endif
   const uint32_t end = millis();
   if (end - start > 200) {
     ESP_LOGV(TAG, "A component took a long time in a loop() cycle (%.2f s).", (end - start) / 1e3f);
@@ -84,8 +105,15 @@ void Application::loop() {
 
   const uint32_t now = millis();
 
+  const bool dumping_config = this->dump_config_at_ >= 0 && this->dump_config_at_ < this->components_.size();
   if (HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
+#ifdef USE_LOOP_SLEEP
+  } else if (!any_looping && !dumping_config) {
+    // No component needs its loop() called, sleep until the next scheduled item or a wake up
+    uint32_t delay_time = this->scheduler.next_schedule_in().value_or(LOOP_SLEEP_MAX_DURATION);
+    this->sleep_(std::min(delay_time, LOOP_SLEEP_MAX_DURATION));
+#endif
   } else {
     uint32_t delay_time = this->loop_interval_;
     if (now - this->last_loop_ < this->loop_interval_)
@@ -96,11 +124,11 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->sleep_(delay_time);
   }
   this->last_loop_ = now;
 
-  if (this->dump_config_at_ >= 0 && this->dump_config_at_ < this->components_.size()) {
+  if (dumping_config) {
     if (this->dump_config_at_ == 0) {
       ESP_LOGI(TAG, "ESPHome version " ESPHOME_VERSION " compiled on %s", this->compilation_time_.c_str());
     }
@@ -110,6 +138,52 @@ void Application::loop() {
   }
 }
 
+void Application::sleep_(uint32_t duration) {
+#ifdef USE_LOOP_SLEEP
+  this->loop_sleeping_ = true;
+  // a wake up between here and the wait below is not lost: on the ESP8266 esp_schedule() resumes the
+  // loop right after delay() yields, on the ESP32 the task notification stays pending
+  if (!this->wake_requested_) {
+#ifdef ARDUINO_ARCH_ESP32
+    if (duration == 0) {
+      delay(0);
+    } else {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(duration));
+    }
+#else
+    delay(duration);
+#endif
+  }
+  this->loop_sleeping_ = false;
+  this->wake_requested_ = false;
+#else
+  delay(duration);
+#endif
+}
+
+void ICACHE_RAM_ATTR Application::wake_loop() {
+#ifdef USE_LOOP_SLEEP
+  this->wake_requested_ = true;
+  if (!this->loop_sleeping_)
+    return;
+#ifdef ARDUINO_ARCH_ESP8266
+  esp_schedule();
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->loop_task_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->loop_task_, &higher_priority_task_woken);
+    if (higher_priority_task_woken)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(this->loop_task_);
+  }
+#endif
+#endif
+}
+
 void ICACHE_RAM_ATTR HOT Application::feed_wdt() {
   static uint32_t LAST_FEED = 0;
   uint32_t now = millis();
@@ -132,6 +206,7 @@ void Application::reboot() {
   ESP_LOGI(TAG, "Forcing a reboot...");
   for (auto *comp : this->components_)
     comp->on_shutdown();
+  global_preferences.sync();
   ESP.restart();
   // restart() doesn't always end execution
   while (true) {
@@ -144,6 +219,7 @@ void Application::safe_reboot() {
     comp->on_safe_shutdown();
   for (auto *comp : this->components_)
     comp->on_shutdown();
+  global_preferences.sync();
   ESP.restart();
   // restart() doesn't always end execution
   while (true) {
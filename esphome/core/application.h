@@ -8,6 +8,11 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/scheduler.h"
 
+#if defined(USE_LOOP_SLEEP) && defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -110,6 +115,14 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Wake up the loop if it is sleeping, safe to call from interrupts and other tasks/threads.
+   *
+   * With the sleep loop mode (USE_LOOP_SLEEP), loop() sleeps until the next scheduled item while no component
+   * needs its loop() called, and the delay between loop iterations ends early on a wake up. Without it, this
+   * does nothing.
+   */
+  void wake_loop();
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -125,10 +138,18 @@ class Application {
     for (auto *comp : this->components_) {
       comp->on_shutdown();
     }
+    global_preferences.sync();
   }
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
+#ifdef USE_COMPONENT_PROFILER
+  /// Execution times of whole App.loop() iterations (scheduler and all looping components, without the idle delay).
+  TimingHistogram &get_loop_timing() { return this->loop_timing_; }
+#endif
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
@@ -210,9 +231,14 @@ class Application {
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  /// Wait for at most duration ms, returning early on wake_loop() in the sleep loop mode.
+  void sleep_(uint32_t duration);
 
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
+#ifdef USE_COMPONENT_PROFILER
+  TimingHistogram loop_timing_;
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -245,6 +271,13 @@ class Application {
   uint32_t loop_interval_{16};
   int dump_config_at_{-1};
   uint32_t app_state_{0};
+#ifdef USE_LOOP_SLEEP
+  volatile bool loop_sleeping_{false};
+  volatile bool wake_requested_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t loop_task_{nullptr};
+#endif
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
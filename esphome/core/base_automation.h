@@ -118,7 +118,7 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override { this->cancel_timeout(fnv1_hash_static("")); }
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -50,6 +50,14 @@ bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+void Component::set_interval(uint32_t name_hash, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, name_hash, interval, std::move(f));
+}
+
+bool Component::cancel_interval(uint32_t name_hash) {  // NOLINT
+  return App.scheduler.cancel_interval(this, name_hash);
+}
+
 void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   return App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
@@ -58,6 +66,14 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+void Component::set_timeout(uint32_t name_hash, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, name_hash, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(uint32_t name_hash) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name_hash);
+}
+
 void Component::call_loop() { this->loop(); }
 
 void Component::call_setup() { this->setup(); }
@@ -77,10 +93,19 @@ void Component::call() {
       this->component_state_ |= COMPONENT_STATE_LOOP;
       this->call_loop();
       break;
-    case COMPONENT_STATE_LOOP:
-      // State loop: Call loop
+    case COMPONENT_STATE_LOOP: {
+      // State loop: Call loop, unless the component has nothing to do
+      if (this->loop_disabled_)
+        break;
+#ifdef USE_COMPONENT_PROFILER
+      const uint32_t start = micros();
+      this->call_loop();
+      this->loop_timing_.record(micros() - start);
+#else
       this->call_loop();
+#endif
       break;
+    }
     case COMPONENT_STATE_FAILED:
       // State failed: Do nothing
       break;
@@ -95,7 +120,7 @@ void Component::mark_failed() {
   this->status_set_error();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+  App.scheduler.set_timeout(this, SCHEDULER_EMPTY_NAME, 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
@@ -103,11 +128,23 @@ bool Component::cancel_defer(const std::string &name) {  // NOLINT
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
+bool Component::cancel_defer(uint32_t name_hash) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name_hash);
+}
+void Component::defer(uint32_t name_hash, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, name_hash, 0, std::move(f));
+}
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+  App.scheduler.set_timeout(this, SCHEDULER_EMPTY_NAME, timeout, std::move(f));
 }
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+  App.scheduler.set_interval(this, SCHEDULER_EMPTY_NAME, interval, std::move(f));
+}
+void ICACHE_RAM_ATTR Component::enable_loop() {
+  if (!this->loop_disabled_)
+    return;
+  this->loop_disabled_ = false;
+  App.wake_loop();
 }
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::can_proceed() { return true; }
@@ -160,7 +197,7 @@ void PollingComponent::call_setup() {
   this->setup();
 
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval(fnv1_hash_static("update"), this->get_update_interval(), [this]() { this->update(); });
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
@@ -5,6 +5,8 @@
 #include "Arduino.h"
 
 #include "esphome/core/optional.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/profiler.h"
 
 namespace esphome {
 
@@ -128,6 +130,31 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() until enable_loop() is called.
+   *
+   * For components whose loop() only has work to do after some event, like an interrupt or a network
+   * callback. Timeouts and intervals keep running.
+   */
+  void disable_loop() { this->loop_disabled_ = true; }
+
+  /** Resume calling loop().
+   *
+   * Safe to call from interrupts and other tasks/threads, and wakes up the application loop if it is sleeping.
+   */
+  void enable_loop();
+
+  bool is_loop_disabled() const { return this->loop_disabled_; }
+
+#ifdef USE_COMPONENT_PROFILER
+  /// Set the name (the ID from the configuration) that identifies this component in timing statistics.
+  void set_component_source(const char *source) { this->component_source_ = source; }
+  const char *get_component_source() const { return this->component_source_; }
+  /// Execution times of this component's loop() calls.
+  TimingHistogram &get_loop_timing() { return this->loop_timing_; }
+  /// Execution times of this component's timeouts/intervals.
+  TimingHistogram &get_scheduler_timing() { return this->scheduler_timing_; }
+#endif
+
  protected:
   virtual void call_loop();
   virtual void call_setup();
@@ -140,6 +167,9 @@ class Component {
    * loop() and therefore can be significantly delay. If you need exact timing please
    * use hardware timers.
    *
+   * Names are only compared by their 32-bit FNV-1 hash, two names of one component with the same hash
+   * are treated as the same name. An empty name means no cancelling possible.
+   *
    * @param name The identifier for this interval function.
    * @param interval The interval in ms.
    * @param f The function (or lambda) that should be called
@@ -148,6 +178,9 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /// Same as set_interval() with a name, but with a name hashed with fnv1_hash_static() at compile time.
+  void set_interval(uint32_t name_hash, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -156,12 +189,14 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(uint32_t name_hash);       // NOLINT
 
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Set a timeout function with a unique name.
    *
-   * Similar to javascript's setTimeout(). Empty name means no cancelling possible.
+   * Similar to javascript's setTimeout(). Empty name means no cancelling possible. Names are only compared
+   * by their 32-bit FNV-1 hash, two names of one component with the same hash are treated as the same name.
    *
    * IMPORTANT: Do not rely on this having correct timing. This is only called from
    * loop() and therefore can be significantly delay. If you need exact timing please
@@ -175,12 +210,16 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Same as set_timeout() with a name, but with a name hashed with fnv1_hash_static() at compile time.
+  void set_timeout(uint32_t name_hash, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   /** Cancel a timeout function.
    *
    * @param name The identifier for this timeout function.
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(uint32_t name_hash);       // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -190,15 +229,23 @@ class Component {
    * @param f The callback.
    */
   void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
+  void defer(uint32_t name_hash, std::function<void()> &&f);       // NOLINT
 
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(uint32_t name_hash);       // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
+  volatile bool loop_disabled_{false};
   float setup_priority_override_{NAN};
+#ifdef USE_COMPONENT_PROFILER
+  const char *component_source_{"<unknown>"};
+  TimingHistogram loop_timing_;
+  TimingHistogram scheduler_timing_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -3,6 +3,7 @@
 
 #define USE_API
 #define USE_LOGGER
+#define USE_LOGGER_ASYNC
 #define USE_BINARY_SENSOR
 #define USE_SENSOR
 #define USE_SWITCH
@@ -23,3 +24,5 @@
 #define USE_TIME
 #define USE_DEEP_SLEEP
 #define USE_CAPTIVE_PORTAL
+#define USE_COMPONENT_PROFILER
+#define USE_LOOP_SLEEP
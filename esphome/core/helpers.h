@@ -315,4 +315,13 @@ template<typename T> class Parented {
 
 uint32_t fnv1_hash(const std::string &str);
 
+/** Compile-time version of fnv1_hash(), for names that are string literals.
+ *
+ * Called with a literal, the hash is folded by the compiler, for example
+ * `this->set_timeout(fnv1_hash_static("update"), 100, ...)` does not hash anything at run time.
+ */
+constexpr uint32_t fnv1_hash_static(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == '\0' ? hash : fnv1_hash_static(str + 1, (hash * 16777619UL) ^ uint32_t(*str));
+}
+
 }  // namespace esphome
@@ -0,0 +1,246 @@
+#include "esphome/core/preference_journal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+
+static const char *TAG = "preferences";
+
+static const uint32_t JOURNAL_MAGIC = 0x50524A31UL;  // "PRJ1"
+/// Sector header: magic, sequence number, inverted sequence number.
+static const uint32_t JOURNAL_HEADER_WORDS = 3;
+/// Record header: offset << 16 | length, checksum.
+static const uint32_t JOURNAL_RECORD_WORDS = 2;
+static const uint32_t JOURNAL_ERASED = 0xFFFFFFFFUL;
+
+PreferenceJournal::PreferenceJournal(PreferenceFlash *flash, uint32_t *image, uint32_t image_words)
+    : flash_(flash), image_(image), image_words_(image_words) {
+  uint32_t dirty_size = (image_words + 31) / 32;
+  this->dirty_words_ = new uint32_t[dirty_size];
+  for (uint32_t i = 0; i < dirty_size; i++)
+    this->dirty_words_[i] = 0;
+  this->record_ = new uint32_t[JOURNAL_RECORD_WORDS + image_words];
+}
+
+bool PreferenceJournal::load() {
+  // replay the newest valid sector, falling back to older ones if its snapshot is damaged
+  bool has_limit = false;
+  uint32_t limit = 0;
+  uint32_t max_sequence = 0;
+  while (true) {
+    int32_t best = -1;
+    uint32_t best_sequence = 0;
+    for (uint32_t sector = 0; sector < this->flash_->get_sector_count(); sector++) {
+      uint32_t header[JOURNAL_HEADER_WORDS];
+      if (!this->flash_->read(sector, 0, header, JOURNAL_HEADER_WORDS))
+        continue;
+      if (header[0] != JOURNAL_MAGIC || header[1] != ~header[2])
+        continue;
+      max_sequence = std::max(max_sequence, header[1]);
+      if (has_limit && header[1] >= limit)
+        continue;
+      if (best == -1 || header[1] > best_sequence) {
+        best = sector;
+        best_sequence = header[1];
+      }
+    }
+    // new sectors must be numbered above every existing one, including damaged ones
+    this->sequence_ = max_sequence;
+    this->active_sector_ = best;
+    if (best == -1)
+      return false;
+    if (this->replay_())
+      return true;
+    has_limit = true;
+    limit = best_sequence;
+  }
+}
+
+bool PreferenceJournal::replay_() {
+  const uint32_t sector = this->active_sector_;
+  const uint32_t sector_words = this->flash_->get_sector_words();
+  uint32_t offset = JOURNAL_HEADER_WORDS;
+  bool applied = false;
+  this->tail_clean_ = true;
+
+  while (offset + JOURNAL_RECORD_WORDS <= sector_words) {
+    uint32_t *record = this->record_;
+    if (!this->flash_->read(sector, offset, record, JOURNAL_RECORD_WORDS)) {
+      this->tail_clean_ = false;
+      break;
+    }
+    if (record[0] == JOURNAL_ERASED && record[1] == JOURNAL_ERASED) {
+      // end of log, the rest of the sector must be erased too for appending to be possible
+      for (uint32_t i = offset; i < sector_words && this->tail_clean_; i += this->image_words_) {
+        uint32_t len = std::min(this->image_words_, sector_words - i);
+        if (!this->flash_->read(sector, i, record, len)) {
+          this->tail_clean_ = false;
+          break;
+        }
+        for (uint32_t j = 0; j < len; j++) {
+          if (record[j] != JOURNAL_ERASED) {
+            this->tail_clean_ = false;
+            break;
+          }
+        }
+      }
+      break;
+    }
+
+    const uint32_t header = record[0];
+    const uint32_t checksum = record[1];
+    const uint32_t start = header >> 16;
+    const uint32_t len = header & 0xFFFF;
+    uint32_t *data = record + JOURNAL_RECORD_WORDS;
+    if (len == 0 || start + len > this->image_words_ || offset + JOURNAL_RECORD_WORDS + len > sector_words ||
+        !this->flash_->read(sector, offset + JOURNAL_RECORD_WORDS, data, len) ||
+        this->checksum_(header, data, len) != checksum) {
+      ESP_LOGV(TAG, "Damaged preference record at sector %u offset %u, ignoring the rest of the sector", sector,
+               offset);
+      this->tail_clean_ = false;
+      break;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+      this->image_[start + i] = data[i];
+    applied = true;
+    offset += JOURNAL_RECORD_WORDS + len;
+  }
+
+  this->write_offset_ = offset;
+  if (!applied) {
+    // not even the snapshot is readable
+    this->active_sector_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void PreferenceJournal::write(uint32_t offset, const uint32_t *data, uint32_t words) {
+  words = std::min(words, this->image_words_ - std::min(offset, this->image_words_));
+  bool changed = false;
+  for (uint32_t i = 0; i < words; i++) {
+    if (this->image_[offset + i] != data[i]) {
+      this->image_[offset + i] = data[i];
+      changed = true;
+    }
+  }
+  if (!changed)
+    return;
+  // mark the whole range so that it ends up in a single record and can't be torn by a power loss
+  for (uint32_t i = offset; i < offset + words; i++)
+    this->dirty_words_[i / 32] |= 1UL << (i % 32);
+  this->dirty_ = true;
+}
+
+uint32_t PreferenceJournal::get_free_words() const {
+  if (this->active_sector_ == -1 || !this->tail_clean_)
+    return 0;
+  return this->flash_->get_sector_words() - this->write_offset_;
+}
+
+bool PreferenceJournal::next_dirty_run_(uint32_t from, uint32_t *start, uint32_t *end) const {
+  uint32_t i = from;
+  while (i < this->image_words_ && !this->is_word_dirty_(i))
+    i++;
+  if (i == this->image_words_)
+    return false;
+  *start = i;
+  while (i < this->image_words_ && this->is_word_dirty_(i))
+    i++;
+  *end = i;
+  return true;
+}
+
+bool PreferenceJournal::flush() {
+  if (!this->dirty_)
+    return true;
+  if (this->active_sector_ == -1 || !this->tail_clean_)
+    return this->compact_();
+
+  // either all runs fit as records or a snapshot is written instead
+  uint32_t needed = 0;
+  uint32_t start, end = 0;
+  while (this->next_dirty_run_(end, &start, &end))
+    needed += JOURNAL_RECORD_WORDS + (end - start);
+  if (needed > this->get_free_words())
+    return this->compact_();
+
+  end = 0;
+  while (this->next_dirty_run_(end, &start, &end)) {
+    if (!this->append_run_(start, end - start)) {
+      // the record may be partially written, continue in the next sector with the next flush
+      this->tail_clean_ = false;
+      return false;
+    }
+  }
+  this->clear_dirty_();
+  return true;
+}
+
+bool PreferenceJournal::append_run_(uint32_t offset, uint32_t words) {
+  uint32_t *record = this->record_;
+  record[0] = (offset << 16) | words;
+  for (uint32_t i = 0; i < words; i++)
+    record[JOURNAL_RECORD_WORDS + i] = this->image_[offset + i];
+  record[1] = this->checksum_(record[0], record + JOURNAL_RECORD_WORDS, words);
+
+  const uint32_t len = JOURNAL_RECORD_WORDS + words;
+  if (!this->flash_->write(this->active_sector_, this->write_offset_, record, len)) {
+    ESP_LOGV(TAG, "Writing preference record failed!");
+    return false;
+  }
+  this->write_offset_ += len;
+  return true;
+}
+
+bool PreferenceJournal::compact_() {
+  const int32_t previous = this->active_sector_;
+  const uint32_t sector = previous == -1 ? 0 : (previous + 1) % this->flash_->get_sector_count();
+  const uint32_t sequence = this->sequence_ + 1;
+  ESP_LOGV(TAG, "Compacting preferences into sector %u (sequence %u)", sector, sequence);
+
+  if (!this->flash_->erase_sector(sector)) {
+    ESP_LOGV(TAG, "Erasing preference sector %u failed!", sector);
+    return false;
+  }
+  this->active_sector_ = sector;
+  this->write_offset_ = JOURNAL_HEADER_WORDS;
+  // only once the header is written after the snapshot the sector becomes valid
+  const uint32_t header[JOURNAL_HEADER_WORDS] = {JOURNAL_MAGIC, sequence, ~sequence};
+  bool success = this->append_run_(0, this->image_words_);
+  if (success && !this->flash_->write(sector, 0, header, JOURNAL_HEADER_WORDS)) {
+    ESP_LOGV(TAG, "Writing preference sector header failed!");
+    success = false;
+  }
+  if (!success) {
+    // retry the same sector next time, the previous one is still the valid one
+    this->active_sector_ = previous;
+    this->tail_clean_ = false;
+    return false;
+  }
+  this->tail_clean_ = true;
+  this->sequence_ = sequence;
+  this->clear_dirty_();
+  return true;
+}
+
+uint32_t PreferenceJournal::checksum_(uint32_t header, const uint32_t *data, uint32_t words) const {
+  // FNV-1a over words
+  uint32_t hash = 2166136261UL ^ header;
+  hash *= 16777619UL;
+  for (uint32_t i = 0; i < words; i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+void PreferenceJournal::clear_dirty_() {
+  for (uint32_t i = 0; i < (this->image_words_ + 31) / 32; i++)
+    this->dirty_words_[i] = 0;
+  this->dirty_ = false;
+}
+
+}  // namespace esphome
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+
+/// Sector-erasable flash storage used by PreferenceJournal. Offsets and lengths are in 32-bit words.
+class PreferenceFlash {
+ public:
+  virtual uint32_t get_sector_count() const = 0;
+  virtual uint32_t get_sector_words() const = 0;
+  virtual bool erase_sector(uint32_t sector) = 0;
+  virtual bool read(uint32_t sector, uint32_t offset, uint32_t *data, uint32_t words) = 0;
+  /// Program words that have been erased before, flash can only clear bits.
+  virtual bool write(uint32_t sector, uint32_t offset, const uint32_t *data, uint32_t words) = 0;
+};
+
+/** Log-structured store for a RAM image of preference words.
+ *
+ * Changed words are appended as records (offset, length, checksum, data) to the active sector instead of
+ * erasing and rewriting the sector on every change. When the active sector is full, the next sector in
+ * round-robin order is erased and a snapshot of the whole image is written to it, which spreads erases
+ * evenly over all sectors.
+ *
+ * A sector only becomes valid once its header is written after the snapshot. Records are checksummed and
+ * replay stops at the first damaged record, so a power loss during a write loses at most that write.
+ */
+class PreferenceJournal {
+ public:
+  /// image must hold image_words words and outlive the journal.
+  PreferenceJournal(PreferenceFlash *flash, uint32_t *image, uint32_t image_words);
+
+  /// Restore the image from the newest valid sector, returns false (and leaves the image untouched) if none exists.
+  bool load();
+
+  /// Update a range of the image, if anything in it changed the range is written with the next flush().
+  void write(uint32_t offset, const uint32_t *data, uint32_t words);
+  bool is_dirty() const { return this->dirty_; }
+
+  /// Append all changed words to flash, compacting into the next sector if needed.
+  bool flush();
+
+  /// The sector currently written to, -1 if there is no valid sector yet.
+  int32_t get_active_sector() const { return this->active_sector_; }
+  uint32_t get_sequence() const { return this->sequence_; }
+  /// Number of words that can still be appended to the active sector.
+  uint32_t get_free_words() const;
+
+ protected:
+  bool is_word_dirty_(uint32_t i) const { return this->dirty_words_[i / 32] & (1UL << (i % 32)); }
+  /// Find the first run of dirty words at or after from, returns false if there is none.
+  bool next_dirty_run_(uint32_t from, uint32_t *start, uint32_t *end) const;
+  bool append_run_(uint32_t offset, uint32_t words);
+  bool compact_();
+  bool replay_();
+  uint32_t checksum_(uint32_t header, const uint32_t *data, uint32_t words) const;
+  void clear_dirty_();
+
+  PreferenceFlash *flash_;
+  uint32_t *image_;
+  uint32_t image_words_;
+  /// One bit per image word.
+  uint32_t *dirty_words_;
+  /// Scratch space for one record, header and checksum followed by up to image_words_ data words.
+  uint32_t *record_;
+  bool dirty_{false};
+  int32_t active_sector_{-1};
+  uint32_t sequence_{0};
+  uint32_t write_offset_{0};
+  /// false if the active sector contains data after the last valid record, appending there is not possible.
+  bool tail_clean_{true};
+};
+
+}  // namespace esphome
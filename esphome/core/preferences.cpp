@@ -3,6 +3,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+
 #ifdef ARDUINO_ARCH_ESP8266
 extern "C" {
 #include "spi_flash.h"
@@ -17,6 +19,9 @@ namespace esphome {
 
 static const char *TAG = "preferences";
 
+/// Don't retry writing to flash in every loop iteration if it failed.
+static const uint32_t PREFERENCES_SYNC_RETRY_INTERVAL = 1000;
+
 ESPPreferenceObject::ESPPreferenceObject() : offset_(0), length_words_(0), type_(0), data_(nullptr) {}
 ESPPreferenceObject::ESPPreferenceObject(size_t offset, size_t length, uint32_t type)
     : offset_(offset), length_words_(length), type_(type) {
@@ -65,6 +70,18 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+/** Number of flash sectors the preferences journal rotates through.
+ *
+ * With a single sector (the default) the journal is not used: there would be no other sector to compact into, so
+ * the sector is erased and rewritten on every sync like before. More sectors are taken from the end of the SPIFFS
+ * area, see `esphome: preferences: flash_sectors`.
+ */
+#ifdef ESPHOME_PREFERENCES_FLASH_SECTORS
+static const uint32_t ESP8266_FLASH_SECTORS = ESPHOME_PREFERENCES_FLASH_SECTORS;
+#else
+static const uint32_t ESP8266_FLASH_SECTORS = 1;
+#endif
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -73,8 +90,6 @@ static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   return true;
 }
 
-static bool esp8266_flash_dirty = false;
-
 static inline bool esp_rtc_user_mem_write(uint32_t index, uint32_t value) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -88,56 +103,72 @@ static inline bool esp_rtc_user_mem_write(uint32_t index, uint32_t value) {
   return true;
 }
 
+extern "C" uint32_t _SPIFFS_start;
 extern "C" uint32_t _SPIFFS_end;
 
-static const uint32_t get_esp8266_flash_sector() {
+static uint32_t get_esp8266_sector(uint32_t *symbol) {
   union {
     uint32_t *ptr;
     uint32_t uint;
   } data{};
-  data.ptr = &_SPIFFS_end;
+  data.ptr = symbol;
   return (data.uint - 0x40200000) / SPI_FLASH_SEC_SIZE;
 }
-static const uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
-
-void ESPPreferences::save_esp8266_flash_() {
-  if (!esp8266_flash_dirty)
-    return;
-
-  ESP_LOGVV(TAG, "Saving preferences to flash...");
-  SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
-  {
+/// The sector used by previous versions to store all preferences, and the last sector of the journal.
+static uint32_t get_esp8266_flash_sector() { return get_esp8266_sector(&_SPIFFS_end); }
+static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
+
+/// Flash sectors directly before (and including) the legacy preferences sector, taken from the end of SPIFFS.
+class ESP8266PreferenceFlash : public PreferenceFlash {
+ public:
+  ESP8266PreferenceFlash(uint32_t first_sector, uint32_t sector_count)
+      : first_sector_(first_sector), sector_count_(sector_count) {}
+  uint32_t get_sector_count() const override { return this->sector_count_; }
+  uint32_t get_sector_words() const override { return SPI_FLASH_SEC_SIZE / 4; }
+  bool erase_sector(uint32_t sector) override {
     InterruptLock lock;
-    erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-    if (erase_res == SPI_FLASH_RESULT_OK) {
-      write_res = spi_flash_write(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
-    }
+    return spi_flash_erase_sector(this->first_sector_ + sector) == SPI_FLASH_RESULT_OK;
   }
-  if (erase_res != SPI_FLASH_RESULT_OK) {
-    ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
-    return;
+  bool read(uint32_t sector, uint32_t offset, uint32_t *data, uint32_t words) override {
+    InterruptLock lock;
+    return spi_flash_read(this->address_(sector, offset), data, words * 4) == SPI_FLASH_RESULT_OK;
   }
-  if (write_res != SPI_FLASH_RESULT_OK) {
-    ESP_LOGV(TAG, "Write ESP8266 flash failed!");
-    return;
+  bool write(uint32_t sector, uint32_t offset, const uint32_t *data, uint32_t words) override {
+    InterruptLock lock;
+    // the SDK does not modify the data, but takes a non-const pointer
+    return spi_flash_write(this->address_(sector, offset), const_cast<uint32_t *>(data), words * 4) ==
+           SPI_FLASH_RESULT_OK;
   }
 
-  esp8266_flash_dirty = false;
-}
+ protected:
+  uint32_t address_(uint32_t sector, uint32_t offset) const {
+    return (this->first_sector_ + sector) * SPI_FLASH_SEC_SIZE + offset * 4;
+  }
+
+  uint32_t first_sector_;
+  uint32_t sector_count_;
+};
 
 bool ESPPreferenceObject::save_internal_() {
   if (this->in_flash_) {
+    if (this->offset_ + this->length_words_ >= ESP8266_FLASH_STORAGE_SIZE)
+      return false;
+    if (global_preferences.flash_journal_ != nullptr) {
+      global_preferences.flash_journal_->write(this->offset_, this->data_, this->length_words_ + 1);
+      if (global_preferences.flash_journal_->is_dirty())
+        global_preferences.mark_pending_();
+      return true;
+    }
+
+    uint32_t *storage = global_preferences.flash_storage_ + this->offset_;
     for (uint32_t i = 0; i <= this->length_words_; i++) {
-      uint32_t j = this->offset_ + i;
-      if (j >= ESP8266_FLASH_STORAGE_SIZE)
-        return false;
-      uint32_t v = this->data_[i];
-      uint32_t *ptr = &global_preferences.flash_storage_[j];
-      if (*ptr != v)
-        esp8266_flash_dirty = true;
-      *ptr = v;
+      if (storage[i] != this->data_[i]) {
+        storage[i] = this->data_[i];
+        global_preferences.flash_dirty_ = true;
+      }
     }
-    global_preferences.save_esp8266_flash_();
+    if (global_preferences.flash_dirty_)
+      global_preferences.mark_pending_();
     return true;
   }
 
@@ -176,7 +207,21 @@ void ESPPreferences::begin() {
   this->flash_storage_ = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];
   ESP_LOGVV(TAG, "Loading preferences from flash...");
 
-  {
+  if (ESP8266_FLASH_SECTORS >= 2) {
+    // the journal ends at the legacy sector, the sectors before it are the last ones of the SPIFFS area
+    const uint32_t last_sector = get_esp8266_flash_sector();
+    const uint32_t spiffs_sectors = last_sector - get_esp8266_sector(&_SPIFFS_start);
+    if (ESP8266_FLASH_SECTORS - 1 <= spiffs_sectors) {
+      auto *flash = new ESP8266PreferenceFlash(last_sector - (ESP8266_FLASH_SECTORS - 1), ESP8266_FLASH_SECTORS);
+      this->flash_journal_ = new PreferenceJournal(flash, this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE);
+    } else {
+      ESP_LOGW(TAG, "The SPIFFS area only has room for %u preference sectors, using a single sector!",
+               spiffs_sectors + 1);
+    }
+  }
+
+  if (this->flash_journal_ == nullptr || !this->flash_journal_->load()) {
+    // No journal yet, start with the preferences written by previous versions
     InterruptLock lock;
     spi_flash_read(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
   }
@@ -224,6 +269,47 @@ ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type
 }
 void ESPPreferences::prevent_write(bool prevent) { this->prevent_write_ = prevent; }
 bool ESPPreferences::is_prevent_write() { return this->prevent_write_; }
+bool ESPPreferences::sync() {
+  if (this->prevent_write_) {
+    // an OTA upload is writing to flash, keep the changes pending
+    return false;
+  }
+  if (this->flash_journal_ == nullptr) {
+    if (!this->flash_dirty_) {
+      this->pending_ = false;
+      return true;
+    }
+
+    ESP_LOGVV(TAG, "Saving preferences to flash...");
+    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
+    {
+      InterruptLock lock;
+      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+      if (erase_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+    }
+    if (erase_res != SPI_FLASH_RESULT_OK || write_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGV(TAG, "Writing preferences to flash failed!");
+      return false;
+    }
+    this->flash_dirty_ = false;
+    this->pending_ = false;
+    return true;
+  }
+
+  if (!this->flash_journal_->is_dirty()) {
+    this->pending_ = false;
+    return true;
+  }
+
+  ESP_LOGVV(TAG, "Saving preferences to flash...");
+  if (!this->flash_journal_->flush()) {
+    ESP_LOGV(TAG, "Writing preferences to flash failed!");
+    return false;
+  }
+  this->pending_ = false;
+  return true;
+}
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -231,25 +317,31 @@ bool ESPPreferenceObject::save_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
-  char key[32];
-  sprintf(key, "%u", this->offset_);
-  uint32_t len = (this->length_words_ + 1) * 4;
-  esp_err_t err = nvs_set_blob(global_preferences.nvs_handle_, key, this->data_, len);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
-    return false;
-  }
-  err = nvs_commit(global_preferences.nvs_handle_);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_commit('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
-    return false;
-  }
+  // Only queue the data, ESPPreferences::sync() writes all pending saves with a single commit
+  auto &pending = global_preferences.nvs_pending_;
+  auto it = pending.begin();
+  while (it != pending.end() && it->key != this->offset_)
+    it++;
+  if (it == pending.end())
+    it = pending.insert(pending.end(), {});
+  it->key = this->offset_;
+  it->data.assign(this->data_, this->data_ + this->length_words_ + 1);
+  global_preferences.mark_pending_();
   return true;
 }
 bool ESPPreferenceObject::load_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
+  for (auto &save : global_preferences.nvs_pending_) {
+    if (save.key != this->offset_)
+      continue;
+    if (save.data.size() != this->length_words_ + 1)
+      return false;
+    std::copy(save.data.begin(), save.data.end(), this->data_);
+    return true;
+  }
+
   char key[32];
   sprintf(key, "%u", this->offset_);
   uint32_t len = (this->length_words_ + 1) * 4;
@@ -293,7 +385,74 @@ ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type
   this->current_offset_++;
   return pref;
 }
+bool ESPPreferences::sync() {
+  if (this->nvs_pending_.empty()) {
+    this->pending_ = false;
+    return true;
+  }
+
+  ESP_LOGVV(TAG, "Saving %u preferences to NVS...", this->nvs_pending_.size());
+  bool success = true;
+  bool changed = false;
+  std::vector<uint32_t> stored;
+  for (auto &save : this->nvs_pending_) {
+    char key[32];
+    sprintf(key, "%u", save.key);
+    size_t len = save.data.size() * 4;
+
+    // NVS appends a new entry even for an unchanged value, skip those
+    size_t actual_len;
+    if (nvs_get_blob(this->nvs_handle_, key, nullptr, &actual_len) == ESP_OK && actual_len == len) {
+      stored.resize(save.data.size());
+      if (nvs_get_blob(this->nvs_handle_, key, stored.data(), &actual_len) == ESP_OK && stored == save.data)
+        continue;
+    }
+
+    esp_err_t err = nvs_set_blob(this->nvs_handle_, key, save.data.data(), len);
+    if (err) {
+      ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
+      success = false;
+      continue;
+    }
+    changed = true;
+  }
+  this->nvs_pending_.clear();
+  this->pending_ = false;
+
+  if (changed) {
+    esp_err_t err = nvs_commit(this->nvs_handle_);
+    if (err) {
+      ESP_LOGV(TAG, "nvs_commit() failed: %s", esp_err_to_name(err));
+      return false;
+    }
+  }
+  return success;
+}
+#endif
+void ESPPreferences::mark_pending_() {
+  if (this->pending_)
+    return;
+  this->pending_ = true;
+  this->pending_since_ = millis();
+}
+void ESPPreferences::loop() {
+  if (!this->pending_)
+    return;
+#ifdef ARDUINO_ARCH_ESP8266
+  if (this->prevent_write_)
+    return;
 #endif
+  const uint32_t now = millis();
+  uint32_t interval = this->flash_write_interval_;
+  if (this->sync_failed_)
+    interval = std::max(interval, PREFERENCES_SYNC_RETRY_INTERVAL);
+  if (now - this->pending_since_ < interval)
+    return;
+
+  this->sync_failed_ = !this->sync();
+  if (this->sync_failed_)
+    this->pending_since_ = now;
+}
 uint32_t ESPPreferenceObject::calculate_crc_() const {
   uint32_t crc = this->type_;
   for (size_t i = 0; i < this->length_words_; i++) {
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "esphome/core/esphal.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/preference_journal.h"
 
 namespace esphome {
 
@@ -56,12 +58,27 @@ class ESPPreferences {
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash = DEFAULT_IN_FLASH);
   template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = DEFAULT_IN_FLASH);
 
+  /** Set how long saves to flash may be held back so that they can be written together.
+   *
+   * Saving a preference stored in flash only updates a copy in RAM. Pending changes are written once the
+   * oldest one is older than this interval, and in any case before a reboot or deep sleep. With 0 they are
+   * written at the end of the loop iteration in which they were made.
+   */
+  void set_flash_write_interval(uint32_t flash_write_interval) { this->flash_write_interval_ = flash_write_interval; }
+  /// Write all pending changes to flash now.
+  bool sync();
+  /// Called by the application after each loop iteration, writes pending changes when they are due.
+  void loop();
+
 #ifdef ARDUINO_ARCH_ESP8266
   /** On the ESP8266, we can't override the first 128 bytes during OTA uploads
    * as the eboot parameters are stored there. Writing there during an OTA upload
    * would invalidate applying the new firmware. During normal operation, we use
    * this part of the RTC user memory, but stop writing to it during OTA uploads.
    *
+   * Pending changes of the preferences in flash are not written either until writing is allowed again,
+   * so sync() should be called before.
+   *
    * @param prevent Whether to prevent writing to the first 32 words of RTC user memory.
    */
   void prevent_write(bool prevent);
@@ -71,15 +88,32 @@ class ESPPreferences {
  protected:
   friend ESPPreferenceObject;
 
+  void mark_pending_();
+
   uint32_t current_offset_;
+  uint32_t flash_write_interval_{0};
+  bool pending_{false};
+  bool sync_failed_{false};
+  /// Time of the oldest change that has not been written yet.
+  uint32_t pending_since_{0};
 #ifdef ARDUINO_ARCH_ESP32
+  struct NVSPendingSave {
+    uint32_t key;
+    std::vector<uint32_t> data;
+  };
+
   uint32_t nvs_handle_;
+  std::vector<NVSPendingSave> nvs_pending_;
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
-  void save_esp8266_flash_();
   bool prevent_write_{false};
+  /// RAM copy of the preferences stored in flash.
   uint32_t *flash_storage_;
   uint32_t current_flash_offset_;
+  /// Only used with more than one flash sector, otherwise flash_storage_ is written as a whole.
+  PreferenceJournal *flash_journal_{nullptr};
+  /// flash_storage_ has unwritten changes (single sector store).
+  bool flash_dirty_{false};
 #endif
 };
 
@@ -0,0 +1,68 @@
+#include "esphome/core/profiler.h"
+
+#ifdef USE_COMPONENT_PROFILER
+
+#include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+
+void HOT TimingHistogram::record(uint32_t duration_us) {
+  uint8_t index = 0;
+  if (duration_us >= 16) {
+    index = 32 - __builtin_clz(duration_us >> 4);
+    if (index >= BUCKET_COUNT)
+      index = BUCKET_COUNT - 1;
+  }
+
+  if (this->buckets_[index] == UINT16_MAX) {
+    for (auto &bucket : this->buckets_)
+      bucket >>= 1;
+  }
+  this->buckets_[index]++;
+
+  if (this->count_ == 0 || duration_us < this->min_)
+    this->min_ = duration_us;
+  if (duration_us > this->max_)
+    this->max_ = duration_us;
+  if (this->count_ != UINT32_MAX)
+    this->count_++;
+  this->total_ += duration_us;
+}
+void TimingHistogram::reset() {
+  for (auto &bucket : this->buckets_)
+    bucket = 0;
+  this->count_ = 0;
+  this->min_ = 0;
+  this->max_ = 0;
+  this->total_ = 0;
+}
+float TimingHistogram::get_mean() const {
+  if (this->count_ == 0)
+    return 0.0f;
+  return float(this->total_) / float(this->count_);
+}
+uint32_t TimingHistogram::get_percentile(float percentile) const {
+  uint32_t total = 0;
+  for (auto bucket : this->buckets_)
+    total += bucket;
+  if (total == 0)
+    return 0;
+
+  // rank of the requested sample, 1-based
+  auto rank = uint32_t(ceilf(total * percentile / 100.0f));
+  if (rank == 0)
+    rank = 1;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i + 1 < BUCKET_COUNT; i++) {
+    seen += this->buckets_[i];
+    if (seen >= rank)
+      return std::min(get_bucket_upper_bound(i), this->max_);
+  }
+  return this->max_;
+}
+
+}  // namespace esphome
+
+#endif  // USE_COMPONENT_PROFILER
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include "esphome/core/defines.h"
+
+#ifdef USE_COMPONENT_PROFILER
+
+namespace esphome {
+
+/** A fixed-size log2 histogram of execution times in microseconds.
+ *
+ * Bucket i holds durations below 16us << i, the last bucket is open-ended. Recording is O(1) and never
+ * allocates, so it can be used in the hot paths of Application::loop() and the Scheduler. When a bucket
+ * would overflow, all buckets are halved so that the distribution stays intact.
+ */
+class TimingHistogram {
+ public:
+  static const uint8_t BUCKET_COUNT = 16;
+
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count() const { return this->count_; }
+  uint32_t get_min() const { return this->count_ == 0 ? 0 : this->min_; }
+  uint32_t get_max() const { return this->max_; }
+  /// Get the sum of all recorded durations in microseconds.
+  uint64_t get_total() const { return this->total_; }
+  float get_mean() const;
+  /** Get an upper bound for the given percentile (0-100) in microseconds.
+   *
+   * This is the upper bound of the bucket the percentile falls into, or the maximum if it is in the last bucket.
+   */
+  uint32_t get_percentile(float percentile) const;
+  uint16_t get_bucket(uint8_t i) const { return this->buckets_[i]; }
+  /// Get the exclusive upper bound of bucket i in microseconds, 0 for the last (open-ended) bucket.
+  static uint32_t get_bucket_upper_bound(uint8_t i) { return i + 1 < BUCKET_COUNT ? 16UL << i : 0; }
+
+ protected:
+  uint16_t buckets_[BUCKET_COUNT]{};
+  uint32_t count_{0};
+  uint32_t min_{0};
+  uint32_t max_{0};
+  uint64_t total_{0};
+};
+
+}  // namespace esphome
+
+#endif  // USE_COMPONENT_PROFILER
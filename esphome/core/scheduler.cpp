@@ -3,6 +3,8 @@
 #include "esphome/core/helpers.h"
 #include <algorithm>
 
+#ifndef USE_SCHEDULER_TIMER_WHEEL
+
 namespace esphome {
 
 static const char *TAG = "scheduler";
@@ -14,19 +16,33 @@ static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> &&func) {
+  this->set_timeout(component, fnv1_hash(name), timeout, std::move(func));
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, fnv1_hash(name), SchedulerItem::TIMEOUT);
+}
+void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                 std::function<void()> &&func) {
+  this->set_interval(component, fnv1_hash(name), interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, fnv1_hash(name), SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t name_hash, uint32_t timeout,
+                                std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (name_hash != SCHEDULER_EMPTY_NAME)
+    this->cancel_timeout(component, name_hash);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(name=0x%08X, timeout=%u)", name_hash, timeout);
 
   auto item = make_unique<SchedulerItem>();
   item->component = component;
-  item->name = name;
+  item->name_hash = name_hash;
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
@@ -35,15 +51,15 @@ void HOT Scheduler::set_timeout(Component *component, const std::string &name, u
   item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t name_hash) {
+  return this->cancel_item_(component, name_hash, SchedulerItem::TIMEOUT);
 }
-void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+void HOT Scheduler::set_interval(Component *component, uint32_t name_hash, uint32_t interval,
                                  std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name_hash != SCHEDULER_EMPTY_NAME)
+    this->cancel_interval(component, name_hash);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -53,11 +69,11 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(name=0x%08X, interval=%u, offset=%u)", name_hash, interval, offset);
 
   auto item = make_unique<SchedulerItem>();
   item->component = component;
-  item->name = name;
+  item->name_hash = name_hash;
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
@@ -68,10 +84,12 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   item->remove = false;
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t name_hash) {
+  return this->cancel_item_(component, name_hash, SchedulerItem::INTERVAL);
 }
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  // Items added since the last call() are not in the heap yet
+  this->process_to_add();
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
@@ -95,7 +113,7 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
     while (!this->empty_()) {
       auto item = std::move(this->items_[0]);
       const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
-      ESP_LOGVV(TAG, "  %s '%s' interval=%u last_execution=%u (%u) next=%u (%u)", type, item->name.c_str(),
+      ESP_LOGVV(TAG, "  %s 0x%08X interval=%u last_execution=%u (%u) next=%u (%u)", type, item->name_hash,
                 item->interval, item->last_execution, item->last_execution_major, item->next_execution(),
                 item->next_execution_major());
 
@@ -127,14 +145,22 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
       const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%u last_execution=%u (now=%u)", type, item->name.c_str(),
+      ESP_LOGVV(TAG, "Running %s 0x%08X with interval=%u last_execution=%u (now=%u)", type, item->name_hash,
                 item->interval, item->last_execution, now);
 #endif
 
       // Warning: During f(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
+#ifdef USE_COMPONENT_PROFILER
+      Component *component = item->component;
+      const uint32_t start = micros();
+      item->f();
+      if (component != nullptr)
+        component->get_scheduler_timing().record(micros() - start);
+#else
       item->f();
+#endif
     }
 
     {
@@ -190,15 +216,18 @@ void HOT Scheduler::pop_raw_() {
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, Scheduler::SchedulerItem::Type type) {
+  // unnamed items can't be cancelled, like in the timer wheel
+  if (name_hash == SCHEDULER_EMPTY_NAME)
+    return false;
   bool ret = false;
   for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type) {
       it->remove = true;
       ret = true;
     }
   for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type) {
       it->remove = true;
       ret = true;
     }
@@ -245,3 +274,5 @@ bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
 }
 
 }  // namespace esphome
+
+#endif  // USE_SCHEDULER_TIMER_WHEEL
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include <vector>
 #include <memory>
 
@@ -8,12 +10,29 @@ namespace esphome {
 
 class Component;
 
+/// fnv1_hash("") - unnamed items are never cancelled implicitly by a new set_timeout()/set_interval().
+static const uint32_t SCHEDULER_EMPTY_NAME = fnv1_hash_static("");
+
+/** The scheduler behind Component::set_timeout()/set_interval().
+ *
+ * Names are only stored as their FNV-1 hash. Callers with a literal name pass fnv1_hash_static("name") to the
+ * uint32_t overloads so nothing is hashed at run time, the std::string overloads hash the name on every call.
+ *
+ * By default items are heap-allocated and kept in a binary min-heap. With USE_SCHEDULER_TIMER_WHEEL
+ * (`esphome: scheduler: mode: timer_wheel`) items instead come from a preallocated pool and are kept in a
+ * hierarchical timer wheel with 1ms resolution, so inserting and cancelling items is O(1) and does not touch
+ * the heap.
+ */
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
   bool cancel_timeout(Component *component, const std::string &name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
   bool cancel_interval(Component *component, const std::string &name);
+  void set_timeout(Component *component, uint32_t name_hash, uint32_t timeout, std::function<void()> &&func);
+  bool cancel_timeout(Component *component, uint32_t name_hash);
+  void set_interval(Component *component, uint32_t name_hash, uint32_t interval, std::function<void()> &&func);
+  bool cancel_interval(Component *component, uint32_t name_hash);
 
   optional<uint32_t> next_schedule_in();
 
@@ -21,10 +40,11 @@ class Scheduler {
 
   void process_to_add();
 
+#ifndef USE_SCHEDULER_TIMER_WHEEL
  protected:
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    uint32_t name_hash;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -51,7 +71,7 @@ class Scheduler {
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  bool cancel_item_(Component *component, uint32_t name_hash, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -61,6 +81,76 @@ class Scheduler {
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
+#else
+ protected:
+#ifdef ESPHOME_SCHEDULER_POOL_SIZE
+  static const uint16_t POOL_SIZE = ESPHOME_SCHEDULER_POOL_SIZE;
+#else
+  static const uint16_t POOL_SIZE = 32;
+#endif
+  /// Number of bits per wheel level, each level has 2^WHEEL_BITS slots.
+  static const uint8_t WHEEL_BITS = 6;
+  static const uint8_t WHEEL_SIZE = 1 << WHEEL_BITS;
+  static const uint8_t WHEEL_MASK = WHEEL_SIZE - 1;
+  /// Number of wheel levels, together they cover 2^24 ms (~4.6h). Longer delays are re-cascaded.
+  static const uint8_t WHEEL_LEVELS = 4;
+  /// Number of buckets of the (component, name, type) lookup table used for cancelling.
+  static const uint8_t LOOKUP_SIZE = 32;
+
+  struct SchedulerItem {
+    enum Type : uint8_t { TIMEOUT, INTERVAL };
+    /// Where the item is currently linked.
+    enum Location : uint8_t { FREE, PENDING, WHEEL, EXPIRED };
+
+    Component *component;
+    uint32_t name_hash;
+    uint32_t interval;
+    /// Absolute time in ms (including rollovers) this item should run at.
+    uint64_t next_execution;
+    std::function<void()> f;
+    /// Intrusive list of the pending/wheel slot/expired/free list this item is in.
+    SchedulerItem *next;
+    SchedulerItem **pprev;
+    /// Intrusive chain of the lookup table bucket.
+    SchedulerItem *lookup_next;
+    Type type;
+    Location location;
+    uint8_t level;
+    uint8_t slot;
+    bool remove;
+  };
+
+  uint32_t millis_();
+  uint64_t now_();
+  void set_item_(Component *component, uint32_t name_hash, SchedulerItem::Type type, uint32_t delay, uint64_t first,
+                 std::function<void()> &&func);
+  bool cancel_item_(Component *component, uint32_t name_hash, SchedulerItem::Type type);
+  SchedulerItem *alloc_();
+  void free_(SchedulerItem *item);
+  void link_(SchedulerItem *item, SchedulerItem **head, SchedulerItem::Location location);
+  void unlink_(SchedulerItem *item);
+  void wheel_insert_(SchedulerItem *item);
+  void cascade_(uint8_t level);
+  void lookup_insert_(SchedulerItem *item);
+  void lookup_remove_(SchedulerItem *item);
+  static uint8_t lookup_bucket_(Component *component, uint32_t name_hash);
+
+  SchedulerItem pool_[POOL_SIZE];
+  SchedulerItem *free_list_{nullptr};
+  SchedulerItem *pending_{nullptr};
+  SchedulerItem *expired_{nullptr};
+  /// The item whose callback is currently running, it must not be freed by a cancel.
+  SchedulerItem *running_{nullptr};
+  SchedulerItem *wheel_[WHEEL_LEVELS][WHEEL_SIZE]{};
+  /// Bitmask of non-empty slots per level.
+  uint64_t occupied_[WHEEL_LEVELS]{};
+  SchedulerItem *lookup_[LOOKUP_SIZE]{};
+  /// The next tick (absolute ms) that has not been processed yet.
+  uint64_t current_tick_{0};
+  bool initialized_{false};
+  uint32_t last_millis_{0};
+  uint8_t millis_major_{0};
+#endif
 };
 
 }  // namespace esphome
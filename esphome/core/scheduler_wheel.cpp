@@ -0,0 +1,368 @@
+#include "scheduler.h"
+
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+static const char *TAG = "scheduler";
+
+static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
+
+void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                std::function<void()> &&func) {
+  this->set_timeout(component, fnv1_hash(name), timeout, std::move(func));
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, fnv1_hash(name), SchedulerItem::TIMEOUT);
+}
+void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                 std::function<void()> &&func) {
+  this->set_interval(component, fnv1_hash(name), interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, fnv1_hash(name), SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t name_hash, uint32_t timeout,
+                                std::function<void()> &&func) {
+  const uint64_t now = this->now_();
+
+  if (name_hash != SCHEDULER_EMPTY_NAME)
+    this->cancel_item_(component, name_hash, SchedulerItem::TIMEOUT);
+
+  if (timeout == SCHEDULER_DONT_RUN)
+    return;
+
+  ESP_LOGVV(TAG, "set_timeout(name=0x%08X, timeout=%u)", name_hash, timeout);
+
+  this->set_item_(component, name_hash, SchedulerItem::TIMEOUT, timeout, now + timeout, std::move(func));
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t name_hash) {
+  return this->cancel_item_(component, name_hash, SchedulerItem::TIMEOUT);
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t name_hash, uint32_t interval,
+                                 std::function<void()> &&func) {
+  const uint64_t now = this->now_();
+
+  if (name_hash != SCHEDULER_EMPTY_NAME)
+    this->cancel_item_(component, name_hash, SchedulerItem::INTERVAL);
+
+  if (interval == SCHEDULER_DONT_RUN)
+    return;
+
+  // only put offset in lower half
+  uint32_t offset = 0;
+  if (interval != 0)
+    offset = (random_uint32() % interval) / 2;
+
+  ESP_LOGVV(TAG, "set_interval(name=0x%08X, interval=%u, offset=%u)", name_hash, interval, offset);
+
+  // Like the heap scheduler, the first execution is due immediately
+  const uint64_t first = now > offset ? now - offset : 0;
+  this->set_item_(component, name_hash, SchedulerItem::INTERVAL, interval, first, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t name_hash) {
+  return this->cancel_item_(component, name_hash, SchedulerItem::INTERVAL);
+}
+optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  if (!this->initialized_)
+    return {};
+
+  const uint64_t now = this->now_();
+  const uint64_t tick = this->current_tick_;
+  bool found = false;
+  uint64_t next = 0;
+
+  // Items added since the last call() are not in the wheel yet
+  for (SchedulerItem *item = this->pending_; item != nullptr; item = item->next) {
+    if (!found || item->next_execution < next) {
+      next = item->next_execution;
+      found = true;
+    }
+  }
+  if (this->occupied_[0] != 0) {
+    // Level 0 slots are exact: rotate the bitmask so that the current slot is bit 0
+    const uint8_t index = tick & WHEEL_MASK;
+    uint64_t rotated = this->occupied_[0] >> index;
+    if (index != 0)
+      rotated |= this->occupied_[0] << (WHEEL_SIZE - index);
+    const uint64_t slot_next = tick + __builtin_ctzll(rotated);
+    if (!found || slot_next < next) {
+      next = slot_next;
+      found = true;
+    }
+  }
+  for (uint8_t level = 1; level < WHEEL_LEVELS; level++) {
+    if (this->occupied_[level] == 0)
+      continue;
+    // Items of higher levels can not run before that level is cascaded the next time
+    const uint64_t granularity = 1ULL << (WHEEL_BITS * level);
+    const uint64_t cascade = (tick + granularity - 1) & ~(granularity - 1);
+    if (!found || cascade < next) {
+      next = cascade;
+      found = true;
+    }
+  }
+
+  if (!found)
+    return {};
+  if (next <= now)
+    return 0;
+  return next - now;
+}
+void ICACHE_RAM_ATTR HOT Scheduler::call() {
+  if (!this->initialized_)
+    return;
+
+  const uint64_t now = this->now_();
+  this->process_to_add();
+
+  while (this->current_tick_ <= now) {
+    const uint8_t index = this->current_tick_ & WHEEL_MASK;
+    if (index == 0) {
+      // Crossed a level 0 boundary, move items of the now current slot of higher levels down
+      for (uint8_t level = 1; level < WHEEL_LEVELS; level++) {
+        this->cascade_(level);
+        if (((this->current_tick_ >> (WHEEL_BITS * level)) & WHEEL_MASK) != 0)
+          break;
+      }
+    }
+
+    SchedulerItem *head = this->wheel_[0][index];
+    if (head != nullptr) {
+      // Move the whole slot to the expired list, callbacks may cancel items that are still in there
+      this->wheel_[0][index] = nullptr;
+      this->occupied_[0] &= ~(1ULL << index);
+      this->expired_ = head;
+      head->pprev = &this->expired_;
+      for (SchedulerItem *it = head; it != nullptr; it = it->next)
+        it->location = SchedulerItem::EXPIRED;
+
+      while (this->expired_ != nullptr) {
+        SchedulerItem *item = this->expired_;
+        this->unlink_(item);
+
+        // Don't run on failed components
+        if (item->remove || (item->component != nullptr && item->component->is_failed())) {
+          this->lookup_remove_(item);
+          this->free_(item);
+          continue;
+        }
+
+        ESP_LOGVV(TAG, "Running %s 0x%08X with interval=%u (now=%u)",
+                  item->type == SchedulerItem::INTERVAL ? "interval" : "timeout", item->name_hash, item->interval,
+                  uint32_t(now));
+
+        // Warning: During f(), timeouts/intervals (including this one) can get added and cancelled.
+        // New items only go to the pending list, cancelling this item only flags it.
+        this->running_ = item;
+#ifdef USE_COMPONENT_PROFILER
+        const uint32_t start = micros();
+        item->f();
+        if (item->component != nullptr)
+          item->component->get_scheduler_timing().record(micros() - start);
+#else
+        item->f();
+#endif
+        this->running_ = nullptr;
+
+        if (item->remove || item->type != SchedulerItem::INTERVAL) {
+          this->lookup_remove_(item);
+          this->free_(item);
+          continue;
+        }
+
+        if (item->interval != 0) {
+          uint64_t last = item->next_execution - item->interval;
+          const uint32_t amount = uint32_t(now - last) / item->interval;
+          last += uint64_t(amount) * item->interval;
+          item->next_execution = last + item->interval;
+        } else {
+          item->next_execution = now;
+        }
+        this->link_(item, &this->pending_, SchedulerItem::PENDING);
+      }
+    }
+
+    this->current_tick_++;
+    // Skip over empty level 0 slots, but never past a level 0 boundary (cascades) or past now
+    const uint8_t next_index = this->current_tick_ & WHEEL_MASK;
+    if (next_index != 0) {
+      const uint64_t ahead = this->occupied_[0] >> next_index;
+      uint64_t next_tick;
+      if (ahead == 0) {
+        next_tick = (this->current_tick_ | WHEEL_MASK) + 1;
+      } else {
+        next_tick = this->current_tick_ + __builtin_ctzll(ahead);
+      }
+      if (next_tick > now + 1)
+        next_tick = now + 1;
+      this->current_tick_ = next_tick;
+    }
+  }
+
+  this->process_to_add();
+}
+void HOT Scheduler::process_to_add() {
+  while (this->pending_ != nullptr) {
+    SchedulerItem *item = this->pending_;
+    this->unlink_(item);
+    this->wheel_insert_(item);
+  }
+}
+uint32_t Scheduler::millis_() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_) {
+    ESP_LOGD(TAG, "Incrementing scheduler major");
+    this->millis_major_++;
+  }
+  this->last_millis_ = now;
+  return now;
+}
+uint64_t Scheduler::now_() {
+  const uint32_t now = this->millis_();
+  return (uint64_t(this->millis_major_) << 32) | now;
+}
+void HOT Scheduler::set_item_(Component *component, uint32_t name_hash, SchedulerItem::Type type, uint32_t delay,
+                              uint64_t first, std::function<void()> &&func) {
+  SchedulerItem *item = this->alloc_();
+  item->component = component;
+  item->name_hash = name_hash;
+  item->type = type;
+  item->interval = delay;
+  item->next_execution = first;
+  item->f = std::move(func);
+  item->remove = false;
+  if (name_hash != SCHEDULER_EMPTY_NAME)
+    this->lookup_insert_(item);
+  this->link_(item, &this->pending_, SchedulerItem::PENDING);
+}
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, SchedulerItem::Type type) {
+  // unnamed items are not in the lookup table, they can't be cancelled
+  if (name_hash == SCHEDULER_EMPTY_NAME)
+    return false;
+  bool ret = false;
+  SchedulerItem **it = &this->lookup_[lookup_bucket_(component, name_hash)];
+  while (*it != nullptr) {
+    SchedulerItem *item = *it;
+    if (item->component != component || item->name_hash != name_hash || item->type != type) {
+      it = &item->lookup_next;
+      continue;
+    }
+
+    ret = true;
+    if (item == this->running_) {
+      // Still executing, call() frees it once the callback returns
+      item->remove = true;
+      it = &item->lookup_next;
+      continue;
+    }
+
+    *it = item->lookup_next;
+    this->unlink_(item);
+    this->free_(item);
+  }
+  return ret;
+}
+Scheduler::SchedulerItem *Scheduler::alloc_() {
+  if (!this->initialized_) {
+    for (auto &item : this->pool_)
+      this->free_(&item);
+    this->current_tick_ = this->now_();
+    this->initialized_ = true;
+  }
+
+  if (this->free_list_ == nullptr) {
+    // Pool exhausted. The item is never deleted but returned to the free list, so the pool only ever grows
+    ESP_LOGW(TAG, "Scheduler item pool exhausted (size %u), allocating an item on the heap!", POOL_SIZE);
+    return new SchedulerItem();
+  }
+
+  SchedulerItem *item = this->free_list_;
+  this->unlink_(item);
+  return item;
+}
+void Scheduler::free_(SchedulerItem *item) {
+  // Release captured state of the callback right away
+  item->f = nullptr;
+  item->remove = false;
+  this->link_(item, &this->free_list_, SchedulerItem::FREE);
+}
+void HOT Scheduler::link_(SchedulerItem *item, SchedulerItem **head, SchedulerItem::Location location) {
+  item->next = *head;
+  if (item->next != nullptr)
+    item->next->pprev = &item->next;
+  *head = item;
+  item->pprev = head;
+  item->location = location;
+}
+void HOT Scheduler::unlink_(SchedulerItem *item) {
+  *item->pprev = item->next;
+  if (item->next != nullptr)
+    item->next->pprev = item->pprev;
+  if (item->location == SchedulerItem::WHEEL && this->wheel_[item->level][item->slot] == nullptr)
+    this->occupied_[item->level] &= ~(1ULL << item->slot);
+  item->next = nullptr;
+  item->pprev = nullptr;
+}
+void HOT Scheduler::wheel_insert_(SchedulerItem *item) {
+  uint64_t expires = item->next_execution;
+  if (expires < this->current_tick_)
+    expires = this->current_tick_;
+
+  // Delays longer than the wheel covers are parked in the furthest slot and re-cascaded from there
+  const uint64_t max_delta = (1ULL << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+  uint64_t delta = expires - this->current_tick_;
+  if (delta > max_delta) {
+    delta = max_delta;
+    expires = this->current_tick_ + max_delta;
+  }
+
+  uint8_t level = 0;
+  while (level < WHEEL_LEVELS - 1 && delta >= (1ULL << (WHEEL_BITS * (level + 1))))
+    level++;
+  const uint8_t slot = (expires >> (WHEEL_BITS * level)) & WHEEL_MASK;
+
+  item->level = level;
+  item->slot = slot;
+  this->link_(item, &this->wheel_[level][slot], SchedulerItem::WHEEL);
+  this->occupied_[level] |= 1ULL << slot;
+}
+void HOT Scheduler::cascade_(uint8_t level) {
+  const uint8_t slot = (this->current_tick_ >> (WHEEL_BITS * level)) & WHEEL_MASK;
+  SchedulerItem *item = this->wheel_[level][slot];
+  this->wheel_[level][slot] = nullptr;
+  this->occupied_[level] &= ~(1ULL << slot);
+  while (item != nullptr) {
+    SchedulerItem *next = item->next;
+    this->wheel_insert_(item);
+    item = next;
+  }
+}
+void Scheduler::lookup_insert_(SchedulerItem *item) {
+  SchedulerItem **bucket = &this->lookup_[lookup_bucket_(item->component, item->name_hash)];
+  item->lookup_next = *bucket;
+  *bucket = item;
+}
+void Scheduler::lookup_remove_(SchedulerItem *item) {
+  if (item->name_hash == SCHEDULER_EMPTY_NAME)
+    return;
+  SchedulerItem **it = &this->lookup_[lookup_bucket_(item->component, item->name_hash)];
+  while (*it != nullptr) {
+    if (*it == item) {
+      *it = item->lookup_next;
+      return;
+    }
+    it = &(*it)->lookup_next;
+  }
+}
+uint8_t Scheduler::lookup_bucket_(Component *component, uint32_t name_hash) {
+  const uint32_t ptr = reinterpret_cast<uintptr_t>(component);
+  return ((ptr >> 2) ^ name_hash) % LOOKUP_SIZE;
+}
+
+}  // namespace esphome
+
+#endif  // USE_SCHEDULER_TIMER_WHEEL
@@ -10,7 +10,9 @@ from esphome.const import ARDUINO_VERSION_ESP32_DEV, ARDUINO_VERSION_ESP8266_DEV
     CONF_COMMENT, CONF_ESPHOME, CONF_INCLUDES, CONF_LIBRARIES, \
     CONF_NAME, CONF_ON_BOOT, CONF_ON_LOOP, CONF_ON_SHUTDOWN, CONF_PLATFORM, \
     CONF_PLATFORMIO_OPTIONS, CONF_PRIORITY, CONF_TRIGGER_ID, \
-    CONF_ESP8266_RESTORE_FROM_FLASH, ARDUINO_VERSION_ESP8266_2_3_0, \
+    CONF_ESP8266_RESTORE_FROM_FLASH, CONF_MODE, CONF_POOL_SIZE, CONF_PROFILER, \
+    CONF_SCHEDULER, CONF_LOOP_MODE, CONF_PREFERENCES, CONF_FLASH_WRITE_INTERVAL, CONF_FLASH_SECTORS, \
+    ARDUINO_VERSION_ESP8266_2_3_0, \
     ARDUINO_VERSION_ESP8266_2_5_0, ARDUINO_VERSION_ESP8266_2_5_1, ARDUINO_VERSION_ESP8266_2_5_2, \
     ESP_PLATFORMS
 from esphome.core import CORE, coroutine_with_priority
@@ -26,6 +28,12 @@ ShutdownTrigger = cg.esphome_ns.class_('ShutdownTrigger', cg.Component,
 LoopTrigger = cg.esphome_ns.class_('LoopTrigger', cg.Component,
                                    automation.Trigger.template())
 
+SCHEDULER_MODE_HEAP = 'heap'
+SCHEDULER_MODE_TIMER_WHEEL = 'timer_wheel'
+
+LOOP_MODE_INTERVAL = 'interval'
+LOOP_MODE_SLEEP = 'sleep'
+
 VERSION_REGEX = re.compile(r'^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$')
 
 
@@ -143,6 +151,21 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_ON_LOOP): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(LoopTrigger),
     }),
+    cv.Optional(CONF_SCHEDULER, default={}): cv.Schema({
+        cv.Optional(CONF_MODE, default=SCHEDULER_MODE_HEAP): cv.one_of(
+            SCHEDULER_MODE_HEAP, SCHEDULER_MODE_TIMER_WHEEL, lower=True),
+        cv.Optional(CONF_POOL_SIZE, default=32): cv.int_range(min=4, max=1024),
+    }),
+    cv.Optional(CONF_LOOP_MODE, default=LOOP_MODE_INTERVAL): cv.one_of(
+        LOOP_MODE_INTERVAL, LOOP_MODE_SLEEP, lower=True),
+    cv.Optional(CONF_PREFERENCES, default={}): cv.Schema({
+        cv.Optional(CONF_FLASH_WRITE_INTERVAL, default='0s'): cv.positive_time_period_milliseconds,
+        # More than one sector enables the wear-levelled journal. The additional sectors are taken from the
+        # end of the SPIFFS area, which must then not be used for anything else.
+        cv.SplitDefault(CONF_FLASH_SECTORS, esp8266=1): cv.All(cv.only_on_esp8266,
+                                                               cv.int_range(min=1, max=16)),
+    }),
+    cv.Optional(CONF_PROFILER, default=False): cv.boolean,
     cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
     cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
 
@@ -208,6 +231,14 @@ def add_includes(includes):
             include_file(path, basename)
 
 
+@coroutine_with_priority(-1000.0)
+def add_component_sources():
+    # Run at the very end so that all components have been declared
+    for id_, var in CORE.variables.items():
+        if isinstance(id_.type, cg.MockObjClass) and id_.type.inherits_from(cg.Component):
+            cg.add(var.set_component_source(id_.id))
+
+
 @coroutine_with_priority(100.0)
 def to_code(config):
     cg.add_global(cg.global_ns.namespace('esphome').using)
@@ -267,5 +298,24 @@ def to_code(config):
     if config.get(CONF_ESP8266_RESTORE_FROM_FLASH, False):
         cg.add_define('USE_ESP8266_PREFERENCES_FLASH')
 
+    scheduler = config[CONF_SCHEDULER]
+    if scheduler[CONF_MODE] == SCHEDULER_MODE_TIMER_WHEEL:
+        cg.add_define('USE_SCHEDULER_TIMER_WHEEL')
+        cg.add_define('ESPHOME_SCHEDULER_POOL_SIZE', scheduler[CONF_POOL_SIZE])
+
+    if config[CONF_LOOP_MODE] == LOOP_MODE_SLEEP:
+        cg.add_define('USE_LOOP_SLEEP')
+
+    preferences = config[CONF_PREFERENCES]
+    if preferences[CONF_FLASH_WRITE_INTERVAL].total_milliseconds != 0:
+        cg.add(cg.esphome_ns.global_preferences.set_flash_write_interval(
+            preferences[CONF_FLASH_WRITE_INTERVAL]))
+    if preferences.get(CONF_FLASH_SECTORS, 1) > 1:
+        cg.add_define('ESPHOME_PREFERENCES_FLASH_SECTORS', preferences[CONF_FLASH_SECTORS])
+
+    if config[CONF_PROFILER]:
+        cg.add_define('USE_COMPONENT_PROFILER')
+        CORE.add_job(add_component_sources)
+
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
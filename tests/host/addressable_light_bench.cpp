@@ -0,0 +1,274 @@
+// Host test/benchmark of the addressable light bulk operations, built by script/host-test.
+//
+// Two lights with the same LEDs, one registers its pixel buffer and uses the bulk operations, the other does not
+// and falls back to one ESPColorView per LED. Random fills, channel sets, fades, blends and color lists on random
+// ranges must leave both with the same bytes, for RGB and RGBW, several sizes around the lookup table threshold and
+// with color correction and brightness. Shifts must move the raw bytes. Then the frames/s of the operations and the
+// built-in effects are timed with and without the pixel buffer.
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/addressable_light_effect.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+static uint32_t g_millis = 0;
+uint32_t millis() { return g_millis; }
+uint32_t micros() { return g_millis * 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+static std::mt19937 g_rng(1);
+static uint16_t g_fast_random = 1;
+uint32_t random_uint32() { return g_rng(); }
+float random_float() { return (g_rng() & 0xFFFFFF) / float(0x1000000); }
+void fast_random_set_seed(uint32_t seed) { g_fast_random = seed; }
+uint8_t fast_random_8() {
+  g_fast_random = g_fast_random * 2053 + 13849;
+  return g_fast_random >> 8;
+}
+float gamma_correct(float value, float gamma) {
+  if (value <= 0.0f)
+    return 0.0f;
+  if (gamma <= 0.0f)
+    return value;
+  return powf(value, gamma);
+}
+float clamp(float val, float min, float max) { return val < min ? min : (val > max ? max : val); }
+
+// the effects are applied to the light directly, without a LightState
+namespace light {
+LightOutput *LightState::get_output() const { return nullptr; }
+}  // namespace light
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::light;
+
+/// LEDs in RAM in GRB(W) order, like a WS2812 strip.
+class HostLight : public AddressableLight {
+ public:
+  HostLight(int32_t size, uint8_t channels, bool bulk, uint8_t max_red)
+      : size_(size), channels_(channels), pixels_(size * channels), effect_data_(size) {
+    this->correction_.calculate_gamma_table(2.8f);
+    if (max_red != 255)
+      this->set_correction(max_red / 255.0f, 1.0f, 1.0f);
+    if (bulk)
+      this->set_pixel_buffer_(this->pixels_.data(), channels, this->offsets_, this->effect_data_.data());
+  }
+  int32_t size() const override { return this->size_; }
+  void clear_effect_data() override { std::fill(this->effect_data_.begin(), this->effect_data_.end(), 0); }
+  LightTraits get_traits() override { return {}; }
+  void loop() override {}
+  void set_brightness(uint8_t brightness) { this->correction_.set_local_brightness(brightness); }
+  bool is_any_on() { return this->is_any_on_(); }
+  bool same_as(const HostLight &other) const {
+    return this->pixels_ == other.pixels_ && this->effect_data_ == other.effect_data_;
+  }
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->pixels_.data()) + index * this->channels_;
+    uint8_t *white = this->channels_ == 4 ? base + this->offsets_[3] : nullptr;
+    return ESPColorView(base + this->offsets_[0], base + this->offsets_[1], base + this->offsets_[2], white,
+                        const_cast<uint8_t *>(this->effect_data_.data()) + index, &this->correction_);
+  }
+
+  int32_t size_;
+  uint8_t channels_;
+  uint8_t offsets_[4]{1, 0, 2, 3};
+};
+
+static bool check_operations(int32_t size, uint8_t channels, uint8_t max_red, uint8_t brightness) {
+  HostLight bulk(size, channels, true, max_red), views(size, channels, false, max_red);
+  bulk.set_brightness(brightness);
+  views.set_brightness(brightness);
+  std::mt19937 rng(size + channels);
+  for (int round = 0; round < 40; round++) {
+    const int32_t from = rng() % size, to = from + rng() % (size - from + 1);
+    const uint8_t value = rng();
+    const ESPColor color(rng(), rng(), rng(), rng());
+    std::vector<ESPColor> colors(to - from);
+    for (ESPColor &c : colors)
+      c = ESPColor(rng(), rng(), rng(), rng());
+    const char *name;
+    std::function<void(HostLight &)> operation;
+    switch (round % 10) {
+      case 0:
+        name = "fill";
+        operation = [&](HostLight &light) { light.range(from, to) = color; };
+        break;
+      case 1:
+        name = "set_red/set_white";
+        operation = [&](HostLight &light) {
+          light.range(from, to).set_red(value);
+          light.range(from, to).set_white(value);
+        };
+        break;
+      case 2:
+        name = "fade_to_black";
+        operation = [&](HostLight &light) { light.range(from, to).fade_to_black(value); };
+        break;
+      case 3:
+        name = "fade_to_white";
+        operation = [&](HostLight &light) { light.range(from, to).fade_to_white(value); };
+        break;
+      case 4:
+        name = "lighten";
+        operation = [&](HostLight &light) { light.range(from, to).lighten(value); };
+        break;
+      case 5:
+        name = "darken";
+        operation = [&](HostLight &light) { light.range(from, to).darken(value); };
+        break;
+      case 6:
+        name = "blend";
+        operation = [&](HostLight &light) { light.blend(from, to, color, value); };
+        break;
+      case 7:
+        name = "set_effect_data";
+        operation = [&](HostLight &light) { light.range(from, to).set_effect_data(value); };
+        break;
+      case 8:
+        name = "set_colors";
+        operation = [&](HostLight &light) { light.set_colors(from, colors.data(), colors.size()); };
+        break;
+      default:
+        name = "per LED";
+        operation = [&](HostLight &light) {
+          for (int32_t i = 0; i < size; i++)
+            light[i] = ESPColor(i * 7, i * 13, i * 3, i);
+        };
+        break;
+    }
+    operation(bulk);
+    operation(views);
+    if (!bulk.same_as(views)) {
+      printf("%d LEDs, %u channels, max red %u, brightness %u: %s differs\n", size, channels, max_red, brightness,
+             name);
+      return false;
+    }
+
+    // blend() is the same as the per LED loop write_state() used for transitions
+    HostLight blended(size, channels, true, max_red);
+    blended.set_brightness(brightness);
+    blended.pixels_ = bulk.pixels_;
+    blended.blend(0, size, color, value);
+    const ESPColor add = color * value;
+    for (auto led : bulk)
+      led = add + led.get() * uint8_t(255 - value);
+    if (blended.pixels_ != bulk.pixels_) {
+      printf("%d LEDs, %u channels: blend() differs from the transition loop\n", size, channels);
+      return false;
+    }
+    views.pixels_ = bulk.pixels_;
+  }
+
+  // shifts move the raw bytes
+  for (int round = 0; round < 20; round++) {
+    const int32_t amount = rng() % size;
+    std::vector<uint8_t> expected = bulk.pixels_;
+    memmove(expected.data() + amount * channels, bulk.pixels_.data(), (size - amount) * channels);
+    bulk.shift_right(amount);
+    if (bulk.pixels_ != expected) {
+      printf("%d LEDs: shift_right(%d) differs from memmove\n", size, amount);
+      return false;
+    }
+    expected = bulk.pixels_;
+    memmove(expected.data(), bulk.pixels_.data() + amount * channels, (size - amount) * channels);
+    bulk.shift_left(amount);
+    if (bulk.pixels_ != expected) {
+      printf("%d LEDs: shift_left(%d) differs from memmove\n", size, amount);
+      return false;
+    }
+  }
+
+  bulk.range(0, size) = ESPColor::BLACK;
+  const bool black_on = bulk.is_any_on();
+  bulk.pixels_[size * channels - 1] = 1;
+  if (black_on || !bulk.is_any_on()) {
+    printf("%d LEDs: wrong is_any_on()\n", size);
+    return false;
+  }
+  // out of range spans are clamped
+  bulk.fill(-5, size + 5, ESPColor::WHITE);
+  bulk.copy(size - 1, 0, 10);
+  return true;
+}
+
+/// Frames/s of an operation with the views and with the pixel buffer.
+static void bench(int32_t size, const char *name, const std::function<void(HostLight &)> &frame) {
+  double fps[2];
+  for (int bulk = 0; bulk < 2; bulk++) {
+    HostLight light(size, 3, bulk, 255);
+    light.set_brightness(180);
+    for (int32_t i = 0; i < size; i++)
+      light[i] = ESPColor(i * 7, i * 13, i * 3);
+    int frames = 0;
+    double seconds = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds < 0.05) {
+      g_millis += 17;
+      frame(light);
+      frames++;
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    fps[bulk] = frames / seconds;
+  }
+  printf("  %-22s %10.0f -> %10.0f (x%.1f)\n", name, fps[0], fps[1], fps[1] / fps[0]);
+}
+
+int main() {
+  // 256 LEDs and more go through the lookup tables
+  for (int32_t size : {1, 3, 100, 255, 256, 257, 1000, 1500}) {
+    for (uint8_t channels : {3, 4}) {
+      const uint8_t settings[][2] = {{255, 255}, {255, 100}, {180, 255}, {180, 20}, {0, 0}};
+      for (const auto &setting : settings) {
+        if (!check_operations(size, channels, setting[0], setting[1]))
+          return 1;
+      }
+    }
+  }
+  printf("bulk operations match the views\n");
+
+  const ESPColor color(200, 120, 40, 0);
+  for (int32_t size : {1000, 10000}) {
+    printf("%d LEDs, RGB, frames/s views -> bulk:\n", size);
+    bench(size, "fill", [&](HostLight &light) { light.all() = color; });
+    bench(size, "fade_to_black", [&](HostLight &light) { light.all().fade_to_black(250); });
+    bench(size, "fade_to_white", [&](HostLight &light) { light.all().fade_to_white(250); });
+    bench(size, "lighten", [&](HostLight &light) { light.all().lighten(1); });
+    bench(size, "darken", [&](HostLight &light) { light.all().darken(1); });
+    bench(size, "blend (transition)", [&](HostLight &light) { light.blend(0, light.size(), color, 10); });
+    bench(size, "shift_right", [&](HostLight &light) { light.shift_right(1); });
+
+    AddressableRainbowLightEffect rainbow("rainbow");
+    bench(size, "rainbow", [&](HostLight &light) { rainbow.apply(light, color); });
+    AddressableColorWipeEffect color_wipe("color_wipe");
+    color_wipe.set_colors({{255, 0, 0, 0, false, 10}, {0, 255, 0, 0, true, 10}});
+    bench(size, "color_wipe", [&](HostLight &light) { color_wipe.apply(light, color); });
+    AddressableScanEffect scan("scan");
+    scan.set_scan_width(10);
+    bench(size, "scan", [&](HostLight &light) { scan.apply(light, color); });
+    AddressableTwinkleEffect twinkle("twinkle");
+    bench(size, "twinkle", [&](HostLight &light) { twinkle.apply(light, color); });
+    AddressableRandomTwinkleEffect random_twinkle("random_twinkle");
+    random_twinkle.set_progress_interval(32);
+    random_twinkle.set_twinkle_probability(0.05f);
+    bench(size, "random_twinkle", [&](HostLight &light) { random_twinkle.apply(light, color); });
+    AddressableFireworksEffect fireworks("fireworks");
+    fireworks.set_fade_out_rate(120);
+    fireworks.set_spark_probability(0.1f);
+    bench(size, "fireworks", [&](HostLight &light) { fireworks.apply(light, color); });
+    AddressableFlickerEffect flicker("flicker");
+    bench(size, "flicker", [&](HostLight &light) { flicker.apply(light, color); });
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+// Host test of the API receive path, built by script/host-test.
+//
+// Feeds frames through the real APIConnection, split into TCP segments of random sizes and interleaved with loop()
+// calls. A small receive buffer makes frames wrap around the end of the ring buffer, go through the backlog and grow
+// the buffer. Every ping must be answered in order and all data must be acknowledged. Afterwards random frames of
+// every message type and random bytes are fuzzed through read_message(), which must not crash (run with ASan).
+
+#include "esphome/components/api/api_connection.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static uint32_t g_millis = 0;
+uint32_t millis() { return g_millis; }
+uint32_t micros() { return g_millis * 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+Application App;
+void Application::feed_wdt() {}
+void Application::reboot() {}
+std::string get_mac_address_pretty() { return "00:00:00:00:00:00"; }
+bool network_is_connected() { return true; }
+std::string network_get_address() { return "127.0.0.1"; }
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::api;
+
+static const uint32_t HELLO_REQUEST = 1;
+static const uint32_t CONNECT_REQUEST = 3;
+static const uint32_t PING_REQUEST = 7;
+static const uint32_t PING_RESPONSE = 8;
+/// All message types read_message() decodes, with the options of this build.
+static const uint32_t MESSAGE_TYPES[] = {1,  3,  5,  6,  7,  8,  9,  11, 20, 28, 30, 31,
+                                         32, 33, 34, 36, 37, 38, 40, 42, 45, 48, 49};
+
+static void append_varint(std::vector<uint8_t> &out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(value | 0x80);
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+static void append_frame(std::vector<uint8_t> &out, uint32_t type, const std::vector<uint8_t> &payload) {
+  out.push_back(0x00);
+  append_varint(out, payload.size());
+  append_varint(out, type);
+  out.insert(out.end(), payload.begin(), payload.end());
+}
+
+/// The types of the frames sent to the client, or false if they are malformed.
+static bool sent_types(const std::vector<uint8_t> &sent, std::vector<uint32_t> *types) {
+  size_t i = 0;
+  while (i < sent.size()) {
+    if (sent[i++] != 0x00)
+      return false;
+    uint32_t consumed;
+    auto size = ProtoVarInt::parse(&sent[i], sent.size() - i, &consumed);
+    if (!size.has_value())
+      return false;
+    i += consumed;
+    auto type = ProtoVarInt::parse(&sent[i], sent.size() - i, &consumed);
+    if (!type.has_value())
+      return false;
+    i += consumed + size->as_uint32();
+    types->push_back(type->as_uint32());
+  }
+  return i == sent.size();
+}
+
+/// Deliver the stream in segments of random sizes, with a random number of loop() calls in between.
+static void deliver(APIConnection &connection, AsyncClient *client, const std::vector<uint8_t> &stream,
+                    std::mt19937 &rng, size_t max_segment) {
+  size_t pos = 0;
+  while (pos < stream.size() && !client->closed) {
+    const size_t len = std::min<size_t>(1 + rng() % max_segment, stream.size() - pos);
+    client->receive(&stream[pos], len);
+    pos += len;
+    const int loops = rng() % 3;
+    for (int i = 0; i < loops; i++)
+      connection.loop();
+  }
+  for (int i = 0; i < 100; i++)
+    connection.loop();
+}
+
+static std::vector<uint8_t> handshake() {
+  std::vector<uint8_t> stream;
+  append_frame(stream, HELLO_REQUEST, {});
+  append_frame(stream, CONNECT_REQUEST, {});
+  return stream;
+}
+
+static int run_pings(APIServer &server, size_t max_segment, std::mt19937 &rng) {
+  auto *client = new AsyncClient();
+  APIConnection connection(client, &server);
+  std::vector<uint8_t> stream = handshake();
+  int pings = 0;
+  for (int i = 0; i < 2000; i++) {
+    // an unknown length delimited field of random size, some frames are larger than the initial buffer
+    std::vector<uint8_t> payload;
+    const uint32_t len = rng() % 8 == 0 ? rng() % 3000 : rng() % 100;
+    payload.push_back(15 << 3 | 2);
+    append_varint(payload, len);
+    for (uint32_t j = 0; j < len; j++)
+      payload.push_back(rng());
+    append_frame(stream, PING_REQUEST, payload);
+    pings++;
+  }
+  deliver(connection, client, stream, rng, max_segment);
+
+  std::vector<uint32_t> types;
+  if (client->closed || !sent_types(client->sent, &types)) {
+    printf("segments <= %zu: connection closed or malformed response\n", max_segment);
+    return 1;
+  }
+  int pongs = 0;
+  for (uint32_t type : types)
+    pongs += type == PING_RESPONSE;
+  if (pongs != pings || client->acked != stream.size() || client->late_acks == 0) {
+    printf("segments <= %zu: %d of %d pings answered, %zu of %zu bytes acknowledged\n", max_segment, pongs, pings,
+           client->acked, stream.size());
+    return 1;
+  }
+  printf("segments <= %4zu: %d pings answered, %zu bytes acknowledged, %zu late\n", max_segment, pongs, client->acked,
+         client->late_acks);
+  return 0;
+}
+
+static void fuzz(APIServer &server, bool valid_frames, std::mt19937 &rng) {
+  for (int connections = 0; connections < 300; connections++) {
+    auto *client = new AsyncClient();
+    APIConnection connection(client, &server);
+    std::vector<uint8_t> stream = handshake();
+    for (int i = 0; i < 200; i++) {
+      std::vector<uint8_t> payload(rng() % 64);
+      for (auto &b : payload)
+        b = rng();
+      if (valid_frames) {
+        append_frame(stream, MESSAGE_TYPES[rng() % (sizeof(MESSAGE_TYPES) / sizeof(MESSAGE_TYPES[0]))], payload);
+      } else {
+        stream.insert(stream.end(), payload.begin(), payload.end());
+      }
+    }
+    deliver(connection, client, stream, rng, 200);
+  }
+}
+
+int main() {
+  APIServer server;
+  server.set_rx_buffer_size(64);
+  std::mt19937 rng(1);
+  for (size_t max_segment : {1, 7, 100, 1460, 5000}) {
+    if (run_pings(server, max_segment, rng) != 0)
+      return 1;
+  }
+  fuzz(server, true, rng);
+  fuzz(server, false, rng);
+  printf("fuzzed 600 connections\n");
+  return 0;
+}
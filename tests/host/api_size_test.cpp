@@ -0,0 +1,181 @@
+// Host test/benchmark of the API message encoding, built by script/host-test.
+//
+// Every generated message type is filled by decoding random wire data, so that all fields, nested and repeated
+// messages get random values. calculate_size() must match the length encode() writes, and the encoding must decode
+// to the same message again. Then encoding all message types into fresh buffers is timed, with and without
+// reserving calculate_size() first like send_message_(), counting the allocations per message.
+
+#include "esphome/components/api/api_pb2.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+static long g_allocations = 0;
+void *operator new(size_t size) {
+  g_allocations++;
+  void *ptr = malloc(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t size) noexcept { free(ptr); }
+
+using namespace esphome::api;
+
+static const int ITERATIONS = 500;
+
+/// All messages generated in api_pb2.h.
+#define API_MESSAGES(X) \
+    X(HelloRequest) X(HelloResponse) X(ConnectRequest) X(ConnectResponse) X(DisconnectRequest) X(DisconnectResponse) \
+    X(PingRequest) X(PingResponse) X(DeviceInfoRequest) X(DeviceInfoResponse) X(ListEntitiesRequest) \
+    X(ListEntitiesDoneResponse) X(SubscribeStatesRequest) X(ListEntitiesBinarySensorResponse) \
+    X(BinarySensorStateResponse) X(ListEntitiesCoverResponse) X(CoverStateResponse) X(CoverCommandRequest) \
+    X(ListEntitiesFanResponse) X(FanStateResponse) X(FanCommandRequest) X(ListEntitiesLightResponse) \
+    X(LightStateResponse) X(LightCommandRequest) X(ListEntitiesSensorResponse) X(SensorStateResponse) \
+    X(ListEntitiesSwitchResponse) X(SwitchStateResponse) X(SwitchCommandRequest) X(ListEntitiesTextSensorResponse) \
+    X(TextSensorStateResponse) X(SubscribeLogsRequest) X(SubscribeLogsResponse) X(SubscribeLogsCompactResponse) \
+    X(SubscribeHomeassistantServicesRequest) X(HomeassistantServiceMap) X(HomeassistantServiceResponse) \
+    X(SubscribeHomeAssistantStatesRequest) X(SubscribeHomeAssistantStateResponse) X(HomeAssistantStateResponse) \
+    X(GetTimeRequest) X(GetTimeResponse) X(ListEntitiesServicesArgument) X(ListEntitiesServicesResponse) \
+    X(ExecuteServiceArgument) X(ExecuteServiceRequest) X(ListEntitiesCameraResponse) X(CameraImageResponse) \
+    X(CameraImageRequest) X(ListEntitiesClimateResponse) X(ClimateStateResponse) X(ClimateCommandRequest) \
+    X(ComponentTimingsRequest) X(ComponentTimingStats) X(ComponentTimingResponse)
+
+static void append_varint(std::vector<uint8_t> &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(value | 0x80);
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+/// Random fields of all wire types, length delimited fields are random bytes or nested wire data.
+static void random_fields(std::vector<uint8_t> &out, std::mt19937 &rng, int depth) {
+  const int count = rng() % 10;
+  for (int i = 0; i < count; i++) {
+    const uint32_t field_id = 1 + rng() % 16;
+    switch (rng() % 3) {
+      case 0: {
+        append_varint(out, field_id << 3 | 0);
+        const uint64_t values[] = {0, 1, rng() % 300, rng(), uint64_t(-int64_t(rng() % 1000))};
+        append_varint(out, values[rng() % 5]);
+        break;
+      }
+      case 1: {
+        append_varint(out, field_id << 3 | 2);
+        std::vector<uint8_t> value;
+        if (depth < 2 && rng() % 2 == 0) {
+          random_fields(value, rng, depth + 1);
+        } else {
+          value.resize(rng() % 40);
+          for (auto &b : value)
+            b = rng();
+        }
+        append_varint(out, value.size());
+        out.insert(out.end(), value.begin(), value.end());
+        break;
+      }
+      default: {
+        append_varint(out, field_id << 3 | 5);
+        const uint32_t value = rng() % 4 == 0 ? 0 : rng();
+        for (int b = 0; b < 4; b++)
+          out.push_back(value >> (b * 8));
+        break;
+      }
+    }
+  }
+}
+
+static std::vector<uint8_t> encode(const ProtoMessage &msg) {
+  std::vector<uint8_t> buffer;
+  msg.encode(ProtoWriteBuffer(&buffer));
+  return buffer;
+}
+
+template<class T> static bool check(const char *name, std::mt19937 &rng, std::vector<T> *samples) {
+  for (int i = 0; i < ITERATIONS; i++) {
+    std::vector<uint8_t> wire;
+    random_fields(wire, rng, 0);
+    T msg;
+    msg.decode(wire.data(), wire.size());
+    const std::vector<uint8_t> encoded = encode(msg);
+    uint32_t size = 0;
+    msg.calculate_size(size);
+    if (size != encoded.size()) {
+      printf("%s: calculate_size() %u, encode() wrote %zu bytes\n", name, size, encoded.size());
+      return false;
+    }
+    T decoded;
+    decoded.decode(encoded.data(), encoded.size());
+    if (encode(decoded) != encoded) {
+      printf("%s: the encoding does not decode to the same message\n", name);
+      return false;
+    }
+    if (i % 10 == 0)
+      samples->push_back(msg);
+  }
+  return true;
+}
+
+struct Samples {
+#define SAMPLES(T) std::vector<T> T##_;
+  API_MESSAGES(SAMPLES)
+#undef SAMPLES
+};
+
+template<class T> static void encode_all(const std::vector<T> &msgs, bool reserve, long *bytes) {
+  for (const T &msg : msgs) {
+    std::vector<uint8_t> buffer;
+    if (reserve) {
+      uint32_t size = 0;
+      msg.calculate_size(size);
+      buffer.reserve(size);
+    }
+    msg.encode(ProtoWriteBuffer(&buffer));
+    *bytes += buffer.size();
+  }
+}
+
+static void bench(const Samples &samples, bool reserve, const char *name) {
+  const int rounds = 200;
+  long bytes = 0, messages = 0;
+  const long allocations = g_allocations;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+#define ENCODE_ALL(T) \
+  encode_all(samples.T##_, reserve, &bytes); \
+  messages += samples.T##_.size();
+    API_MESSAGES(ENCODE_ALL)
+#undef ENCODE_ALL
+  }
+  auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  printf("%-16s %6.1f ns/message, %6.1f MB/s, %.2f allocations/message\n", name, seconds * 1e9 / messages,
+         bytes / seconds / 1e6, double(g_allocations - allocations) / messages);
+}
+
+int main() {
+  std::mt19937 rng(1);
+  Samples samples;
+  int types = 0;
+#define CHECK(T) \
+  if (!check<T>(#T, rng, &samples.T##_)) \
+    return 1; \
+  types++;
+  API_MESSAGES(CHECK)
+#undef CHECK
+  printf("checked %d message types\n", types);
+
+  bench(samples, false, "encode()");
+  bench(samples, true, "reserve+encode()");
+  return 0;
+}
@@ -0,0 +1,276 @@
+// Host test/benchmark of the display drawing fast paths, built by script/host-test.
+//
+// Two host framebuffer drivers like the real ones: an RGB565 buffer like ST7789V and SSD1351, and a 1-bit page buffer
+// like SSD1306 and PCD8544, both filling rectangles and copying RGB565 runs through the DisplayBuffer buffer helpers.
+// A scene of rectangles, lines, circles, clipped text with plain and anti-aliased fonts and images of all types is
+// drawn in all four rotations. Every pixel must be the same as on a reference display with the rotated size that
+// draws everything pixel by pixel without rotation. Then the fast paths are timed against the reference.
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/application.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+Application App;
+void Application::feed_wdt() {}
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::display;
+
+static const DisplayRotation ROTATIONS[] = {DISPLAY_ROTATION_0_DEGREES, DISPLAY_ROTATION_90_DEGREES,
+                                            DISPLAY_ROTATION_180_DEGREES, DISPLAY_ROTATION_270_DEGREES};
+
+/// A driver with a buffer in RAM. Without the fast paths it draws everything through draw_absolute_pixel_internal().
+class HostDisplay : public DisplayBuffer {
+ public:
+  HostDisplay(int width, int height, bool paged, bool fast)
+      : width_(width), height_(height), paged_(paged), fast_(fast) {
+    this->init_internal_(paged ? width * ((height + 7) / 8) : width * height * 2);
+  }
+  ~HostDisplay() { delete[] this->buffer_; }
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+  void rotate(DisplayRotation rotation) { this->set_rotation(rotation); }
+  bool bounds_ok() const { return this->bounds_ok_; }
+
+  /// The pixel at [x,y] in the orientation of the display itself, as RGB565 or 0/1 for the page buffer.
+  uint16_t get_pixel(int x, int y) const {
+    if (this->paged_)
+      return (this->buffer_[x + (y / 8) * this->width_] >> (y % 8)) & 1;
+    const uint8_t *pos = this->buffer_ + (x + y * this->width_) * 2;
+    return pos[0] << 8 | pos[1];
+  }
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x >= this->width_ || x < 0 || y >= this->height_ || y < 0)
+      return;
+    if (this->paged_) {
+      uint8_t &column = this->buffer_[x + (y / 8) * this->width_];
+      column = color.is_on() ? (column | 1 << (y % 8)) : (column & ~(1 << (y % 8)));
+      return;
+    }
+    const uint16_t color565 = color.to_rgb_565();
+    this->buffer_[(x + y * this->width_) * 2] = color565 >> 8;
+    this->buffer_[(x + y * this->width_) * 2 + 1] = color565;
+  }
+  void fill_absolute_rectangle_internal(int x1, int y1, int width, int height, Color color) override {
+    if (x1 < 0 || y1 < 0 || width <= 0 || height <= 0 || x1 + width > this->width_ || y1 + height > this->height_)
+      this->bounds_ok_ = false;
+    if (!this->fast_ || !this->bounds_ok_)
+      DisplayBuffer::fill_absolute_rectangle_internal(x1, y1, width, height, color);
+    else if (this->paged_)
+      this->fill_page_buffer_(x1, y1, width, height, color);
+    else
+      this->fill_rgb565_buffer_(x1, y1, width, height, color);
+  }
+  void draw_rgb565_run_internal(int x1, int y1, int step_x, int step_y, int length, const uint8_t *data) override {
+    const int x2 = x1 + step_x * (length - 1), y2 = y1 + step_y * (length - 1);
+    if (std::min(x1, x2) < 0 || std::min(y1, y2) < 0 || std::max(x1, x2) >= this->width_ ||
+        std::max(y1, y2) >= this->height_)
+      this->bounds_ok_ = false;
+    if (!this->fast_ || this->paged_ || !this->bounds_ok_)
+      DisplayBuffer::draw_rgb565_run_internal(x1, y1, step_x, step_y, length, data);
+    else
+      this->draw_rgb565_buffer_run_(x1, y1, step_x, step_y, length, data);
+  }
+
+  int width_;
+  int height_;
+  bool paged_;
+  bool fast_;
+  bool bounds_ok_{true};
+};
+
+/// Glyphs of random runs of pixels, with bpp bits of alpha per pixel.
+class HostFont {
+ public:
+  HostFont(uint8_t bpp, uint32_t seed) : data_(8192) {
+    std::mt19937 rng(seed);
+    const char *chars = " 0123456789:ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    for (const char *c = chars; *c != '\0'; c++)
+      this->chars_.push_back(std::string(1, *c));
+    std::vector<Glyph> glyphs;
+    uint32_t offset = 0;
+    for (const std::string &chr : this->chars_) {
+      const int width = 5 + rng() % 9, height = 10 + rng() % 8;
+      const int stride = (width * bpp + 7) / 8;
+      for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+          if (rng() % 4 == 0 || (x + y) % 5 == 0)
+            continue;
+          const int bit = x * bpp;
+          this->data_[offset + y * stride + bit / 8] |= (rng() & ((1 << bpp) - 1)) << (8 - bpp - bit % 8);
+        }
+      }
+      glyphs.emplace_back(chr.c_str(), this->data_.data(), offset, rng() % 3, 2 + rng() % 4, width, height, bpp);
+      offset += stride * height;
+    }
+    this->font_ = new Font(std::move(glyphs), 16, 22);
+  }
+  ~HostFont() { delete this->font_; }
+  Font *get() { return this->font_; }
+
+ protected:
+  std::vector<std::string> chars_;
+  std::vector<uint8_t> data_;
+  Font *font_;
+};
+
+struct Images {
+  static const int WIDTH = 50;
+  static const int HEIGHT = 37;
+
+  std::vector<uint8_t> binary_data, grayscale_data, rgb_data, rgb565_data;
+  Image binary, grayscale, rgb, rgb565;
+
+  explicit Images(std::mt19937 &&rng)
+      : binary_data(random_bytes(rng, (WIDTH + 7) / 8 * HEIGHT)),
+        grayscale_data(random_bytes(rng, WIDTH * HEIGHT)),
+        rgb_data(random_bytes(rng, WIDTH * HEIGHT * 3)),
+        rgb565_data(random_bytes(rng, WIDTH * HEIGHT * 2)),
+        binary(binary_data.data(), WIDTH, HEIGHT),
+        grayscale(grayscale_data.data(), WIDTH, HEIGHT, GRAYSCALE),
+        rgb(rgb_data.data(), WIDTH, HEIGHT, RGB),
+        rgb565(rgb565_data.data(), WIDTH, HEIGHT, RGB565) {}
+
+  static std::vector<uint8_t> random_bytes(std::mt19937 &rng, size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (uint8_t &byte : bytes)
+      byte = rng();
+    return bytes;
+  }
+};
+
+static void draw_scene(DisplayBuffer &it, Font *font, Font *smooth_font, Images &images) {
+  const Color background(0x102030);
+  it.fill(background);
+  it.filled_rectangle(-10, -5, 60, 40, Color(0xFF0000));
+  it.filled_rectangle(200, 220, 100, 100, Color(0x00FF00));
+  it.horizontal_line(-5, 100, 400, Color(0x0000FF));
+  it.vertical_line(120, -5, 400, Color(0xFFFFFF));
+  it.fill_span(7, 13, 300, Color(0xFF00FF));
+  it.rectangle(30, 30, 100, 50, Color(0xFFFF00));
+  it.filled_circle(120, 120, 40, Color(0x00FFFF));
+  it.circle(10, 200, 30, Color(0xFF00FF));
+  it.line(0, 0, 239, 180, Color(0x808080));
+  it.print(5, 5, font, Color(0xFFFFFF), "Hello World 12:34");
+  it.print(120, 120, font, Color(0xFF8000), TextAlign::CENTER, "Temperature 21C");
+  it.print(235, 235, font, Color(0x00FF80), TextAlign::BOTTOM_RIGHT, "Bottom right clipped text");
+  it.print(-20, 60, font, Color(0x8080FF), "offscreen left");
+  it.print(10, 150, smooth_font, Color(0xFFFFFF), background, TextAlign::TOP_LEFT, "Smooth 21.5C");
+  it.print(-7, 290, smooth_font, Color(0x00FF00), background, TextAlign::TOP_LEFT, "clipped bottom left");
+  it.image(-8, 150, &images.binary);
+  it.image(180, 10, Color(0x00FF00), &images.binary, true);
+  it.image(100, 180, &images.grayscale);
+  it.image(-15, -15, &images.rgb);
+  it.image(200, 200, &images.rgb);
+  it.image(210, -20, &images.rgb565);
+  it.image(60, 260, &images.rgb565);
+}
+
+/// The pixel of the reference at the rotated [x,y], with the mapping of DisplayBuffer::draw_pixel_at().
+static bool matches_reference(HostDisplay &display, HostDisplay &reference, DisplayRotation rotation) {
+  const int width = display.get_width_internal(), height = display.get_height_internal();
+  for (int y = 0; y < reference.get_height_internal(); y++) {
+    for (int x = 0; x < reference.get_width_internal(); x++) {
+      int native_x = x, native_y = y;
+      if (rotation == DISPLAY_ROTATION_90_DEGREES) {
+        native_x = width - y - 1;
+        native_y = x;
+      } else if (rotation == DISPLAY_ROTATION_180_DEGREES) {
+        native_x = width - x - 1;
+        native_y = height - y - 1;
+      } else if (rotation == DISPLAY_ROTATION_270_DEGREES) {
+        native_x = y;
+        native_y = height - x - 1;
+      }
+      if (display.get_pixel(native_x, native_y) != reference.get_pixel(x, y)) {
+        printf("pixel [%d,%d] differs\n", x, y);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static int check_rotations(bool paged, int width, int height) {
+  HostFont font(1, 5), smooth_font(4, 6);
+  Images images(std::mt19937(9));
+  for (DisplayRotation rotation : ROTATIONS) {
+    HostDisplay display(width, height, paged, true);
+    display.rotate(rotation);
+    HostDisplay reference(display.get_width(), display.get_height(), paged, false);
+    draw_scene(display, font.get(), smooth_font.get(), images);
+    draw_scene(reference, font.get(), smooth_font.get(), images);
+    if (!display.bounds_ok()) {
+      printf("%s %dx%d rotation %d: a fast path got coordinates outside the display\n", paged ? "paged" : "RGB565",
+             width, height, int(rotation));
+      return 1;
+    }
+    if (!matches_reference(display, reference, rotation)) {
+      printf("%s %dx%d rotation %d: differs from the reference\n", paged ? "paged" : "RGB565", width, height,
+             int(rotation));
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/// The best of 7 runs of the average time of f in microseconds.
+static double best_us(int iterations, const std::function<void()> &f) {
+  double best = 1e9;
+  for (int run = 0; run < 7; run++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+      f();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count() / iterations);
+  }
+  return best;
+}
+
+static void bench(bool paged, int width, int height) {
+  HostFont font(1, 5), smooth_font(4, 6);
+  Images images(std::mt19937(9));
+  HostDisplay fast(width, height, paged, true), pixels(width, height, paged, false);
+  printf("%dx%d %s, per pixel -> fast path:\n", width, height, paged ? "paged" : "RGB565");
+  const int iterations = paged ? 200 : 20;
+  const std::pair<const char *, std::function<void(DisplayBuffer &)>> operations[] = {
+      {"fill", [](DisplayBuffer &it) { it.fill(Color(0x123456)); }},
+      {"clear", [](DisplayBuffer &it) { it.clear(); }},
+      {"filled_rectangle 50x50", [](DisplayBuffer &it) { it.filled_rectangle(10, 10, 50, 50, Color(0xFF0000)); }},
+      {"print", [&](DisplayBuffer &it) { it.print(0, 0, font.get(), Color(0xFFFFFF), "Hello World 12:34"); }},
+      {"image binary", [&](DisplayBuffer &it) { it.image(10, 10, &images.binary); }},
+      {"image rgb565", [&](DisplayBuffer &it) { it.image(10, 10, &images.rgb565); }},
+      {"scene", [&](DisplayBuffer &it) { draw_scene(it, font.get(), smooth_font.get(), images); }},
+  };
+  for (const auto &operation : operations) {
+    const double pixels_us = best_us(iterations, [&]() { operation.second(pixels); });
+    const double fast_us = best_us(iterations, [&]() { operation.second(fast); });
+    printf("  %-24s %9.1f us -> %8.1f us\n", operation.first, pixels_us, fast_us);
+  }
+}
+
+int main() {
+  // not square, so that mixing up width and height shows
+  if (check_rotations(false, 240, 320) != 0 || check_rotations(true, 128, 64) != 0 ||
+      check_rotations(true, 84, 48) != 0)
+    return 1;
+  printf("all rotations match the reference\n");
+  bench(false, 240, 320);
+  bench(true, 128, 64);
+  return 0;
+}
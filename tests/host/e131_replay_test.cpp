@@ -0,0 +1,306 @@
+// Host test/benchmark of the E1.31 (sACN) receiver, built by script/host-test.
+//
+// Replays synthesized captures of a wall of 20 RGB universes (3400 LEDs) through the stubbed UDP socket into an
+// addressable light effect. Checks that truncated packets are dropped, that synchronized data is held until the
+// synchronization packet for its address, that data is applied immediately once synchronization packets stop for
+// the timeout, and that universes far apart only join their multicast groups once and leave them again. Then the
+// packets/s of the replay are timed, with and without synchronization.
+
+#include "esphome/components/e131/e131.h"
+#include "esphome/components/e131/e131_addressable_light_effect.h"
+#include "esphome/components/light/addressable_light.h"
+#include "lwip/igmp.h"
+#include <WiFiUdp.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static uint32_t g_millis = 1000;
+uint32_t millis() { return g_millis; }
+uint32_t micros() { return g_millis * 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+float clamp(float val, float min, float max) { return val < min ? min : (val > max ? max : val); }
+float lerp(float completion, float start, float end) { return start + (end - start) * completion; }
+float gamma_correct(float value, float gamma) { return value; }
+
+// the effects only need the output of their light state
+namespace light {
+static LightOutput *g_output = nullptr;
+LightOutput *LightState::get_output() const { return g_output; }
+}  // namespace light
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::light;
+
+typedef std::vector<std::vector<uint8_t>> Datagrams;
+
+static const int UNIVERSES = 20;
+static const int LEDS = UNIVERSES * 170;
+static const int SYNC_ADDRESS = 7000;
+
+/// RGB LEDs in RAM without color correction, so the pixels are the received values.
+class HostLight : public AddressableLight {
+ public:
+  explicit HostLight(int32_t size) : size_(size), pixels_(size * 3), effect_data_(size) {
+    this->correction_.calculate_gamma_table(1.0f);
+    this->set_pixel_buffer_(this->pixels_.data(), 3, this->offsets_, this->effect_data_.data());
+  }
+  int32_t size() const override { return this->size_; }
+  void clear_effect_data() override {}
+  LightTraits get_traits() override { return {}; }
+  void loop() override {}
+
+  std::vector<uint8_t> pixels_;
+  std::vector<uint8_t> effect_data_;
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *base = const_cast<uint8_t *>(this->pixels_.data()) + index * 3;
+    return ESPColorView(base, base + 1, base + 2, nullptr, const_cast<uint8_t *>(this->effect_data_.data()) + index,
+                        &this->correction_);
+  }
+
+  int32_t size_;
+  const uint8_t offsets_[4] = {0, 1, 2, 0};
+};
+
+static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+
+static void put16(uint8_t *data, uint16_t value) {
+  data[0] = value >> 8;
+  data[1] = value;
+}
+static void put32(uint8_t *data, uint32_t value) {
+  put16(data, value >> 16);
+  put16(data + 2, value);
+}
+
+static std::vector<uint8_t> data_packet(int universe, const uint8_t *values, int count, int sync_address) {
+  std::vector<uint8_t> packet(126 + count, 0);
+  put16(&packet[0], 0x10);
+  memcpy(&packet[4], ACN_ID, sizeof(ACN_ID));
+  put32(&packet[18], 0x04);  // root vector data
+  put32(&packet[40], 0x02);  // frame vector data
+  packet[108] = 100;         // priority
+  put16(&packet[109], sync_address);
+  put16(&packet[113], universe);
+  packet[117] = 0x02;  // DMP vector
+  packet[118] = 0xA1;
+  put16(&packet[121], 1);
+  put16(&packet[123], count + 1);
+  packet[125] = 0;  // start code
+  memcpy(&packet[126], values, count);
+  return packet;
+}
+
+static std::vector<uint8_t> sync_packet(int sync_address) {
+  std::vector<uint8_t> packet(49, 0);
+  put16(&packet[0], 0x10);
+  memcpy(&packet[4], ACN_ID, sizeof(ACN_ID));
+  put32(&packet[18], 0x08);  // root vector extended
+  put32(&packet[40], 0x01);  // frame vector sync
+  put16(&packet[45], sync_address);
+  return packet;
+}
+
+static std::vector<uint8_t> frame_values(int frame) {
+  std::vector<uint8_t> values(LEDS * 3);
+  for (size_t i = 0; i < values.size(); i++)
+    values[i] = uint8_t(i * 7 + frame * 13 + (i >> 9));
+  return values;
+}
+
+/// One frame of the wall, the universes start at first_universe.
+static Datagrams frame_packets(int frame, int sync_address, bool send_sync, int first_universe = 1) {
+  const std::vector<uint8_t> values = frame_values(frame);
+  Datagrams packets;
+  for (int u = 0; u < UNIVERSES; u++)
+    packets.push_back(data_packet(first_universe + u, &values[u * 510], 510, sync_address));
+  if (send_sync)
+    packets.push_back(sync_packet(sync_address));
+  return packets;
+}
+
+class Replay {
+ public:
+  Replay() : light_(LEDS), effect_("e131") {
+    g_output = &this->light_;
+    this->add_effect(&this->effect_, 1);
+    this->component_.setup();
+    this->effect_.start();
+  }
+
+  void add_effect(e131::E131AddressableLightEffect *effect, int first_universe) {
+    effect->init_internal(this->state_());
+    effect->set_first_universe(first_universe);
+    effect->set_e131(&this->component_);
+  }
+  void receive(const Datagrams &datagrams) {
+    host_udp_receive(&datagrams);
+    this->component_.loop();
+  }
+  bool shows(int frame) const { return this->light_.pixels_ == frame_values(frame); }
+
+  e131::E131AddressableLightEffect &effect() { return this->effect_; }
+
+ protected:
+  /// The effects only call LightState::get_output(), which the test defines, so they get storage for a LightState.
+  LightState *state_() { return reinterpret_cast<LightState *>(this->state_storage_); }
+
+  HostLight light_;
+  e131::E131Component component_;
+  e131::E131AddressableLightEffect effect_;
+  alignas(8) uint8_t state_storage_[sizeof(LightState)] = {};
+};
+
+static int run_checks() {
+  Replay replay;
+  replay.receive(frame_packets(1, 0, false));
+  if (!replay.shows(1)) {
+    printf("plain frame not applied\n");
+    return 1;
+  }
+  if (host_igmp_groups().size() != UNIVERSES) {
+    printf("joined %zu multicast groups for %d universes\n", host_igmp_groups().size(), UNIVERSES);
+    return 1;
+  }
+
+  // 510 values announced, only 100 received
+  std::vector<uint8_t> truncated = data_packet(1, frame_values(2).data(), 510, 0);
+  truncated.resize(226);
+  replay.receive({truncated});
+  if (!replay.shows(1)) {
+    printf("truncated packet applied\n");
+    return 1;
+  }
+
+  // without a synchronization packet seen yet, synchronized data is applied immediately
+  replay.receive(frame_packets(2, SYNC_ADDRESS, true));
+  if (!replay.shows(2)) {
+    printf("first synchronized frame not applied\n");
+    return 1;
+  }
+  replay.receive(frame_packets(3, SYNC_ADDRESS, false));
+  if (!replay.shows(2)) {
+    printf("synchronized data applied before the synchronization packet\n");
+    return 1;
+  }
+  replay.receive({sync_packet(SYNC_ADDRESS + 1)});
+  if (!replay.shows(2)) {
+    printf("synchronization packet for another address applied the data\n");
+    return 1;
+  }
+  replay.receive({sync_packet(SYNC_ADDRESS)});
+  if (!replay.shows(3)) {
+    printf("synchronization packet did not apply the data\n");
+    return 1;
+  }
+  if (host_igmp_groups().size() != UNIVERSES + 1) {
+    printf("synchronization address did not join its multicast group\n");
+    return 1;
+  }
+
+  // synchronization packets stop, after the timeout data is applied immediately
+  g_millis += 3000;
+  replay.receive(frame_packets(4, SYNC_ADDRESS, false));
+  if (!replay.shows(4)) {
+    printf("synchronized data held after the timeout\n");
+    return 1;
+  }
+  // and data overwritten by an unsynchronized packet is not applied by a later synchronization packet
+  replay.receive({sync_packet(SYNC_ADDRESS)});
+  replay.receive(frame_packets(5, SYNC_ADDRESS, false));
+  replay.receive(frame_packets(6, 0, false));
+  replay.receive({sync_packet(SYNC_ADDRESS)});
+  if (!replay.shows(6)) {
+    printf("stale held data applied\n");
+    return 1;
+  }
+
+  // an effect far above the first one, then another one below it
+  e131::E131AddressableLightEffect high("high"), low("low");
+  replay.add_effect(&high, 60000);
+  high.start();
+  replay.receive(frame_packets(7, 0, false, 60000));
+  if (!replay.shows(7)) {
+    printf("high universes not applied\n");
+    return 1;
+  }
+  replay.receive(frame_packets(8, SYNC_ADDRESS, false, 60000));
+  replay.receive({sync_packet(SYNC_ADDRESS)});
+  if (!replay.shows(8)) {
+    printf("high universes not synchronized\n");
+    return 1;
+  }
+  replay.effect().stop();
+  replay.add_effect(&low, 2);
+  low.start();
+  replay.receive(frame_packets(9, 0, false, 2));
+  if (!replay.shows(9)) {
+    printf("low universes not applied\n");
+    return 1;
+  }
+  replay.receive(frame_packets(10, 0, false, 60000));
+  if (!replay.shows(10)) {
+    printf("high universes not applied after joining lower ones\n");
+    return 1;
+  }
+  low.stop();
+  high.stop();
+  // only the group of the synchronization address is left
+  if (host_igmp_groups().size() != 1) {
+    printf("%zu multicast groups still joined after all effects stopped\n", host_igmp_groups().size());
+    return 1;
+  }
+  replay.effect().start();
+  replay.receive(frame_packets(11, 0, false));
+  if (!replay.shows(11)) {
+    printf("universes not applied after joining them again\n");
+    return 1;
+  }
+  for (const auto &group : host_igmp_groups()) {
+    if (group.second != 1) {
+      printf("multicast group joined %d times\n", group.second);
+      return 1;
+    }
+  }
+  g_millis += 3000;
+  return 0;
+}
+
+static int run_bench(bool synchronized) {
+  Replay replay;
+  const int sync_address = synchronized ? SYNC_ADDRESS : 0;
+  if (synchronized)
+    replay.receive({sync_packet(sync_address)});
+  Datagrams capture;
+  for (int frame = 0; frame < 200; frame++) {
+    const Datagrams packets = frame_packets(frame, sync_address, synchronized);
+    capture.insert(capture.end(), packets.begin(), packets.end());
+  }
+  const int repeats = 10;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++)
+    replay.receive(capture);
+  auto end = std::chrono::steady_clock::now();
+  if (!replay.shows(199)) {
+    printf("%s replay did not show the last frame\n", synchronized ? "synchronized" : "unsynchronized");
+    return 1;
+  }
+  printf("%-14s %6.0fk packets/s\n", synchronized ? "synchronized" : "unsynchronized",
+         capture.size() * repeats / std::chrono::duration<double>(end - start).count() / 1e3);
+  return 0;
+}
+
+int main() {
+  if (run_checks() != 0)
+    return 1;
+  printf("replay checks passed\n");
+  if (run_bench(false) != 0 || run_bench(true) != 0)
+    return 1;
+  return 0;
+}
@@ -0,0 +1,165 @@
+// Host test/benchmark of fused sensor filters, built by script/host-test.
+//
+// Two sensors get the same filters, one as separate filters linked through next_ like before FilterChain, the other
+// fused into a FilterChain like the code generation does. Both must send the same states at the same times and
+// expect the same update interval. Then publishing through both is timed in samples/s. Also checks that blocks from
+// publish_samples() send the same last state as publishing the samples one by one, leaving the block unchanged.
+
+#include "esphome/components/sensor/sensor.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+static const int SAMPLES = 10000000;
+
+/// Publishes the same values to a sensor with linked filters and to one with the filters fused.
+struct Sensors {
+  Sensor linked{"linked"};
+  Sensor fused{"fused"};
+  long linked_states = 0;
+  long fused_states = 0;
+  double linked_sum = 0.0;
+  double fused_sum = 0.0;
+
+  Sensors() {
+    this->linked.add_on_state_callback([this](float state) {
+      this->linked_states++;
+      this->linked_sum += state;
+    });
+    this->fused.add_on_state_callback([this](float state) {
+      this->fused_states++;
+      this->fused_sum += state;
+    });
+  }
+
+  bool check(const char *name) {
+    for (int i = 0; i < 10000; i++) {
+      const float value = float(i % 1023) * 0.37f;
+      this->linked.publish_state(value);
+      this->fused.publish_state(value);
+      if (this->linked_states != this->fused_states || this->linked.state != this->fused.state) {
+        printf("%s: fused chain sent a different state at value %d\n", name, i);
+        return false;
+      }
+    }
+    if (this->linked.calculate_expected_filter_update_interval() !=
+        this->fused.calculate_expected_filter_update_interval()) {
+      printf("%s: fused chain expects a different update interval\n", name);
+      return false;
+    }
+    return true;
+  }
+
+  double samples_per_second(Sensor *sensor) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SAMPLES; i++)
+      sensor->publish_state(i & 1023);
+    auto end = std::chrono::steady_clock::now();
+    return SAMPLES / std::chrono::duration<double>(end - start).count();
+  }
+
+  bool bench(const char *name) {
+    const double linked = this->samples_per_second(&this->linked);
+    const double fused = this->samples_per_second(&this->fused);
+    if (this->linked_sum != this->fused_sum) {
+      printf("%s: fused chain sent different states\n", name);
+      return false;
+    }
+    printf("%-52s linked %6.1f M samples/s, fused %6.1f M samples/s\n", name, linked / 1e6, fused / 1e6);
+    return true;
+  }
+};
+
+static int run_scaling() {
+  Sensors sensors;
+  OffsetFilter offset1(1.0f), offset2(1.0f);
+  MultiplyFilter multiply1(2.0f), multiply2(2.0f);
+  sensors.linked.set_filters({&offset1, &multiply1});
+  FilterChain<OffsetFilter, MultiplyFilter> chain(&offset2, &multiply2);
+  sensors.fused.set_filters({&chain});
+  if (!sensors.check("offset+multiply") || !sensors.bench("offset+multiply"))
+    return 1;
+  return 0;
+}
+
+static int run_averaging() {
+  Sensors sensors;
+  OffsetFilter offset1(1.0f), offset2(1.0f);
+  MultiplyFilter multiply1(2.0f), multiply2(2.0f);
+  CalibrateLinearFilter calibrate1(0.5f, 3.0f), calibrate2(0.5f, 3.0f);
+  SlidingWindowMovingAverageFilter average1(10, 1, 1), average2(10, 1, 1);
+  sensors.linked.set_filters({&offset1, &multiply1, &calibrate1, &average1});
+  FilterChain<OffsetFilter, MultiplyFilter, CalibrateLinearFilter, SlidingWindowMovingAverageFilter> chain(
+      &offset2, &multiply2, &calibrate2, &average2);
+  sensors.fused.set_filters({&chain});
+  const char *name = "offset+multiply+calibrate_linear+sliding_window(10)";
+  if (!sensors.check(name) || !sensors.bench(name))
+    return 1;
+  return 0;
+}
+
+static int run_send_every() {
+  // a stage that holds values back stops the rest of the chain
+  Sensors sensors;
+  MedianFilter median1(5, 3, 1), median2(5, 3, 1);
+  MultiplyFilter multiply1(2.0f), multiply2(2.0f);
+  SlidingWindowMovingAverageFilter average1(4, 2, 1), average2(4, 2, 1);
+  sensors.linked.set_filters({&median1, &multiply1, &average1});
+  FilterChain<MedianFilter, MultiplyFilter, SlidingWindowMovingAverageFilter> chain(&median2, &multiply2, &average2);
+  sensors.fused.set_filters({&chain});
+  if (!sensors.check("median(send_every 3)+multiply+sliding_window(send_every 2)"))
+    return 1;
+  if (sensors.fused_states == 0 || sensors.fused_states > 10000 / 6 + 1) {
+    printf("send_every: fused chain sent %ld states\n", sensors.fused_states);
+    return 1;
+  }
+  return 0;
+}
+
+static int run_samples() {
+  Sensor single("single"), block("block");
+  OffsetFilter offset1(1.0f), offset2(1.0f);
+  SlidingWindowMovingAverageFilter average1(4, 3, 1), average2(4, 3, 1);
+  single.set_filters({&offset1, &average1});
+  FilterChain<OffsetFilter, SlidingWindowMovingAverageFilter> chain(&offset2, &average2);
+  block.set_filters({&chain});
+  std::vector<float> samples;
+  for (int i = 0; i < 100; i++) {
+    samples.assign(1 + i % 7, 0.0f);
+    for (size_t k = 0; k < samples.size(); k++)
+      samples[k] = float(i * 7 + k);
+    const std::vector<float> published = samples;
+    for (float sample : samples)
+      single.publish_state(sample);
+    block.publish_samples(samples.data(), samples.size(), 1000);
+    if (samples != published) {
+      printf("samples: publish_samples() changed the block\n");
+      return 1;
+    }
+    if (block.state != single.state) {
+      printf("samples: block %d sent %f, one by one %f\n", i, block.state, single.state);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main() {
+  if (run_samples() != 0)
+    return 1;
+  if (run_send_every() != 0)
+    return 1;
+  if (run_scaling() != 0)
+    return 1;
+  if (run_averaging() != 0)
+    return 1;
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Golden test of the fixed point light transitions, run by script/host-test.
+//
+// The transition values are compared against the same formulas evaluated in double precision: every 8-bit output
+// must be identical and every 16-bit value must be the correctly rounded one.
+
+#include "esphome/components/light/light_transformer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static uint32_t g_millis = 0;
+uint32_t millis() { return g_millis; }
+uint32_t micros() { return g_millis * 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+float clamp(float val, float min, float max) { return val < min ? min : (val > max ? max : val); }
+float lerp(float completion, float start, float end) { return start + (end - start) * completion; }
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::light;
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      if (failures++ < 10) \
+        printf(__VA_ARGS__); \
+    } \
+  } while (0)
+
+static double smoothed(double x) { return x * x * x * (x * (x * 6.0 - 15.0) + 10.0); }
+static uint8_t to_8bit(double q16) { return static_cast<uint8_t>(q16 / 257.0 + 0.5); }
+static uint8_t q16_to_8bit(uint16_t q16) { return (q16 + 128) / 257; }
+
+static void raw_channels(const LightColorValues &v, uint16_t *out) {
+  out[0] = v.get_state_raw();
+  out[1] = v.get_brightness_raw();
+  out[2] = v.get_red_raw();
+  out[3] = v.get_green_raw();
+  out[4] = v.get_blue_raw();
+  out[5] = v.get_white_raw();
+}
+
+int main() {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> value(0.0f, 1.0f);
+
+  // lerp_q16() is correctly rounded
+  for (int i = 0; i < 1000000; i++) {
+    const uint16_t a = rng(), b = rng(), c = rng();
+    LightColorValues start, end;
+    start.set_red(a / 65535.0f);
+    end.set_red(b / 65535.0f);
+    const uint16_t ra = start.get_red_raw(), rb = end.get_red_raw();
+    const uint64_t num = uint64_t(ra) * (65535 - c) + uint64_t(rb) * c;
+    const uint16_t expected = (num * 2 + 65535) / (2 * 65535);
+    const uint16_t got = LightColorValues::lerp_q16(start, end, c).get_red_raw();
+    EXPECT(got == expected, "lerp_q16(%u, %u, %u) = %u, expected %u\n", ra, rb, c, got, expected);
+  }
+
+  // get_progress16() is correctly rounded
+  for (int i = 0; i < 1000000; i++) {
+    const uint32_t length = 1 + rng() % 600000, elapsed = rng() % (length + 10), start = rng();
+    LightFlashTransformer transformer(start, length, LightColorValues(), LightColorValues());
+    g_millis = start + elapsed;
+    const double exact = elapsed >= length ? 65535.0 : 65535.0 * elapsed / length;
+    const uint16_t got = transformer.get_progress16();
+    EXPECT(fabs(got - exact) <= 0.5, "get_progress16() at %u / %u = %u, expected %f\n", elapsed, length, got, exact);
+  }
+
+  // smoothed_progress16() is within rounding of the exact curve
+  int smoothed_rounding = 0;
+  for (uint32_t x = 0; x <= 65535; x++) {
+    const double exact = 65535.0 * smoothed(x / 65535.0);
+    const uint16_t got = LightTransitionTransformer::smoothed_progress16(x);
+    EXPECT(fabs(got - exact) < 0.5 + 1e-3, "smoothed_progress16(%u) = %u, expected %f\n", x, got, exact);
+    smoothed_rounding += got != static_cast<uint16_t>(exact + 0.5);
+  }
+
+  // transitions: 8-bit outputs identical, 16-bit values correctly rounded
+  uint32_t outputs = 0, float32_differences = 0;
+  for (int trial = 0; trial < 2000; trial++) {
+    LightColorValues start_values(value(rng), value(rng), value(rng), value(rng), value(rng), value(rng));
+    LightColorValues target_values(value(rng), value(rng), value(rng), value(rng), value(rng), value(rng));
+    // keep the state on, otherwise the transformer replaces the start colors
+    start_values.set_state(true);
+    const uint32_t length = 1 + rng() % 20000, start = rng();
+    LightTransitionTransformer transformer(start, length, start_values, target_values);
+    uint16_t from[6], to[6], got[6];
+    raw_channels(start_values, from);
+    raw_channels(target_values, to);
+    for (uint32_t elapsed = 0; elapsed <= length; elapsed += 1 + length / 397) {
+      g_millis = start + elapsed;
+      raw_channels(transformer.get_values(), got);
+      const double s = smoothed(double(elapsed) / length);
+      const float s32 = LightTransitionTransformer::smoothed_progress(float(elapsed) / float(length));
+      for (int c = 0; c < 6; c++) {
+        const double exact = from[c] + s * (to[c] - from[c]);
+        EXPECT(q16_to_8bit(got[c]) == to_8bit(exact), "8-bit channel %d at %u / %u = %u, expected %u (%f)\n", c,
+               elapsed, length, q16_to_8bit(got[c]), to_8bit(exact), exact);
+        EXPECT(fabs(got[c] - exact) < 0.5 + 1e-3, "channel %d at %u / %u = %u, expected %f\n", c, elapsed, length,
+               got[c], exact);
+        const float float32 = from[c] + s32 * float(to[c] - from[c]);
+        float32_differences += to_8bit(float32) != to_8bit(exact);
+        outputs++;
+      }
+    }
+  }
+
+  printf("smoothed_progress16(): %d of 65536 values are not the nearest (all within 0.5 + 1e-3)\n",
+         smoothed_rounding);
+  printf("transitions: %u 8-bit outputs, the single precision float path differs from double on %u\n", outputs,
+         float32_differences);
+  if (failures != 0) {
+    printf("%d failures\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,169 @@
+// Host test/benchmark of the sorted window filters, built by script/host-test.
+//
+// Feeds random values with many duplicates and some NaN to the median, quantile, min, max and trimmed mean filters
+// and compares every output with a std::deque window that is copied and sorted for each output, like the median
+// filter did before SortedWindow. Then times the median filter against that reference for a few window sizes,
+// sending every value.
+
+#include "esphome/components/sensor/filter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+/// The median filter with a std::deque window that is sorted for every output.
+class DequeMedian {
+ public:
+  DequeMedian(size_t window_size, size_t send_every, size_t send_first_at)
+      : window_size_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
+  optional<float> new_value(float value) {
+    if (!std::isnan(value)) {
+      while (this->queue_.size() >= this->window_size_)
+        this->queue_.pop_front();
+      this->queue_.push_back(value);
+    }
+    if (++this->send_at_ < this->send_every_)
+      return {};
+    this->send_at_ = 0;
+    if (this->queue_.empty())
+      return NAN;
+    std::deque<float> sorted = this->queue_;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t n = sorted.size();
+    return n % 2 != 0 ? sorted[n / 2] : (sorted[n / 2] + sorted[n / 2 - 1]) / 2.0f;
+  }
+
+ protected:
+  std::deque<float> queue_;
+  size_t window_size_;
+  size_t send_every_;
+  size_t send_at_;
+};
+
+static bool close(float a, float b, float tolerance) { return std::fabs(a - b) <= tolerance; }
+
+static int check_filters(size_t window_size, size_t send_every) {
+  std::mt19937 rng(window_size * 10 + send_every);
+  DequeMedian reference(window_size, send_every, 1);
+  MedianFilter median(window_size, send_every, 1);
+  QuantileFilter quantile(window_size, send_every, 1, 0.9f);
+  MinFilter min(window_size, send_every, 1);
+  MaxFilter max(window_size, send_every, 1);
+  TrimmedMeanFilter trimmed(window_size, send_every, 1, 0.2f);
+  std::deque<float> window;
+  for (int i = 0; i < 5000; i++) {
+    // half steps from a small range, so the window has plenty of duplicates
+    const float value = i % 97 == 0 ? NAN : float(int(rng() % 101) - 50) / 2.0f;
+    if (!std::isnan(value)) {
+      window.push_back(value);
+      if (window.size() > window_size)
+        window.pop_front();
+    }
+    const optional<float> expected = reference.new_value(value);
+    const optional<float> outputs[] = {median.new_value(value), quantile.new_value(value), min.new_value(value),
+                                       max.new_value(value), trimmed.new_value(value)};
+    for (const optional<float> &output : outputs) {
+      if (output.has_value() != expected.has_value()) {
+        printf("window %zu/%zu: sent at a different value %d\n", window_size, send_every, i);
+        return 1;
+      }
+    }
+    if (!expected.has_value())
+      continue;
+    if (window.empty()) {
+      for (const optional<float> &output : outputs) {
+        if (!std::isnan(*output)) {
+          printf("window %zu/%zu: empty window did not output NaN\n", window_size, send_every);
+          return 1;
+        }
+      }
+      continue;
+    }
+
+    std::vector<float> sorted(window.begin(), window.end());
+    std::sort(sorted.begin(), sorted.end());
+    const float position = 0.9f * (sorted.size() - 1);
+    const size_t low = size_t(position), high = std::min(low + 1, sorted.size() - 1);
+    const float expected_quantile = sorted[low] + (sorted[high] - sorted[low]) * (position - low);
+    size_t trim = size_t(sorted.size() * 0.2f);
+    if (2 * trim >= sorted.size())
+      trim = (sorted.size() - 1) / 2;
+    float sum = 0.0f;
+    for (size_t k = trim; k < sorted.size() - trim; k++)
+      sum += sorted[k];
+    const float expected_trimmed = sum / (sorted.size() - 2 * trim);
+
+    if (*outputs[0] != *expected || !close(*outputs[1], expected_quantile, 1e-4f) || *outputs[2] != sorted.front() ||
+        *outputs[3] != sorted.back() || !close(*outputs[4], expected_trimmed, 1e-3f)) {
+      printf("window %zu/%zu: wrong output at value %d\n", window_size, send_every, i);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int check_resize() {
+  MaxFilter max(5, 1, 1);
+  for (float value : {9.0f, 1.0f, 2.0f, 3.0f, 4.0f})
+    max.new_value(value);
+  // shrinking keeps the newest values, growing keeps all of them
+  max.set_window_size(3);
+  if (*max.new_value(0.0f) != 4.0f) {
+    printf("resize: shrinking did not keep the newest values\n");
+    return 1;
+  }
+  max.set_window_size(10);
+  if (*max.new_value(0.0f) != 4.0f) {
+    printf("resize: growing lost values\n");
+    return 1;
+  }
+  return 0;
+}
+
+template<typename F> static double measure_ns(const std::vector<float> &values, F &&filter) {
+  volatile float sink;
+  auto start = std::chrono::steady_clock::now();
+  for (float value : values)
+    sink = *filter.new_value(value);
+  auto end = std::chrono::steady_clock::now();
+  (void) sink;
+  return std::chrono::duration<double, std::nano>(end - start).count() / values.size();
+}
+
+int main() {
+  for (size_t window_size : {1, 2, 3, 5, 8, 33}) {
+    for (size_t send_every : {1, 3}) {
+      if (check_filters(window_size, send_every) != 0)
+        return 1;
+    }
+  }
+  if (check_resize() != 0)
+    return 1;
+  printf("filters match the sorted deque\n");
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> adc(0.0f, 4095.0f);
+  std::vector<float> values(200000);
+  for (float &value : values)
+    value = adc(rng);
+  for (size_t window_size : {5, 15, 50, 200}) {
+    DequeMedian reference(window_size, 1, 1);
+    MedianFilter median(window_size, 1, 1);
+    const double reference_ns = measure_ns(values, reference);
+    const double median_ns = measure_ns(values, median);
+    printf("median window %3zu: sorted deque %8.1f ns/sample, SortedWindow %6.1f ns/sample (%.1fx)\n", window_size,
+           reference_ns, median_ns, reference_ns / median_ns);
+  }
+  return 0;
+}
@@ -0,0 +1,267 @@
+// Host test of the preference journal, built by script/host-test.
+//
+// Runs the journal on a simulated flash that loses power in the middle of writes, leaving the word being written
+// partially programmed, and whose erases fail. After every power loss the journal is loaded again and each
+// preference must have its last flushed value or the value being flushed. Sector sequence numbers must only
+// increase. Also checks that load() falls back to an older sector if the newest snapshot is damaged, and that a
+// sector with garbage after its last record is not appended to.
+
+#include "esphome/core/preference_journal.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace esphome;
+
+static const uint32_t IMAGE_WORDS = 128;
+static const uint32_t SECTOR_WORDS = 1024;
+static const uint32_t JOURNAL_MAGIC = 0x50524A31UL;
+static const uint32_t ERASED = 0xFFFFFFFFUL;
+
+struct PowerLoss {};
+
+/// NOR flash in RAM: erasing sets all bits, writing can only clear bits.
+class HostFlash : public PreferenceFlash {
+ public:
+  HostFlash(uint32_t sectors, std::mt19937 *rng) : sectors_(sectors), rng_(rng), memory_(sectors * SECTOR_WORDS, 0) {}
+  uint32_t get_sector_count() const override { return this->sectors_; }
+  uint32_t get_sector_words() const override { return SECTOR_WORDS; }
+  bool erase_sector(uint32_t sector) override {
+    if (this->fail_erases_ > 0) {
+      // a failed erase leaves the sector partially erased
+      this->fail_erases_--;
+      for (uint32_t i = 0; i < SECTOR_WORDS; i++) {
+        if ((*this->rng_)() % 2 == 0)
+          this->word(sector, i) = ERASED;
+      }
+      return false;
+    }
+    for (uint32_t i = 0; i < SECTOR_WORDS; i++)
+      this->word(sector, i) = ERASED;
+    return true;
+  }
+  bool read(uint32_t sector, uint32_t offset, uint32_t *data, uint32_t words) override {
+    for (uint32_t i = 0; i < words; i++)
+      data[i] = this->word(sector, offset + i);
+    return true;
+  }
+  bool write(uint32_t sector, uint32_t offset, const uint32_t *data, uint32_t words) override {
+    if (offset == 0)
+      this->check_sequence_(sector, data[1]);
+    for (uint32_t i = 0; i < words; i++) {
+      if (this->power_budget_ == 0) {
+        // the word being written when the power is lost has only some of its bits programmed
+        this->word(sector, offset + i) &= data[i] | (*this->rng_)();
+        throw PowerLoss();
+      }
+      if (this->power_budget_ > 0)
+        this->power_budget_--;
+      this->word(sector, offset + i) &= data[i];
+    }
+    return true;
+  }
+
+  /// Lose the power after this many written words, -1 for never.
+  void set_power_budget(long words) { this->power_budget_ = words; }
+  void set_fail_erases(int count) { this->fail_erases_ = count; }
+  uint32_t &word(uint32_t sector, uint32_t offset) { return this->memory_[sector * SECTOR_WORDS + offset]; }
+  const uint32_t &word(uint32_t sector, uint32_t offset) const {
+    return this->memory_[sector * SECTOR_WORDS + offset];
+  }
+  bool sequence_ok() const { return this->sequence_ok_; }
+
+ protected:
+  /// A new sector header must be numbered above every valid header on the flash.
+  void check_sequence_(uint32_t sector, uint32_t sequence) {
+    for (uint32_t s = 0; s < this->sectors_; s++) {
+      if (this->word(s, 0) == JOURNAL_MAGIC && this->word(s, 1) == ~this->word(s, 2) && this->word(s, 1) >= sequence)
+        this->sequence_ok_ = false;
+    }
+  }
+
+  uint32_t sectors_;
+  std::mt19937 *rng_;
+  std::vector<uint32_t> memory_;
+  long power_budget_{-1};
+  int fail_erases_{0};
+  bool sequence_ok_{true};
+};
+
+struct Preference {
+  uint32_t offset;
+  uint32_t words;
+};
+
+static bool matches(const std::vector<uint32_t> &image, const std::vector<uint32_t> &expected, const Preference &pref) {
+  return std::equal(image.begin() + pref.offset, image.begin() + pref.offset + pref.words,
+                    expected.begin() + pref.offset);
+}
+
+static int run_power_losses(uint32_t sectors) {
+  std::mt19937 rng(sectors);
+  std::vector<Preference> prefs;
+  for (uint32_t offset = 0; offset + 4 <= IMAGE_WORDS;) {
+    const uint32_t words = 1 + rng() % 4;
+    prefs.push_back({offset, words});
+    offset += words;
+  }
+
+  HostFlash flash(sectors, &rng);
+  std::vector<uint32_t> image(IMAGE_WORDS, 0), flushed(IMAGE_WORDS, 0);
+  auto *journal = new PreferenceJournal(&flash, image.data(), IMAGE_WORDS);
+  if (journal->load()) {
+    printf("%u sectors: loaded an empty flash\n", sectors);
+    return 1;
+  }
+  long flushes = 0, losses = 0, failed = 0, reboots = 0;
+  for (int step = 0; step < 100000; step++) {
+    // mostly the same few preferences change, like a light state
+    const int changes = 1 + rng() % 3;
+    for (int i = 0; i < changes; i++) {
+      const Preference &pref = prefs[rng() % 8];
+      std::vector<uint32_t> data(pref.words);
+      for (auto &word : data)
+        word = rng();
+      journal->write(pref.offset, data.data(), pref.words);
+    }
+    const std::vector<uint32_t> written = image;
+
+    if (rng() % 300 == 0)
+      flash.set_fail_erases(1 + rng() % 3);
+    const bool lose_power = rng() % 50 == 0;
+    flash.set_power_budget(lose_power ? rng() % 140 : -1);
+    bool lost = false;
+    try {
+      if (journal->flush()) {
+        flushes++;
+        flushed = written;
+      } else {
+        failed++;
+      }
+    } catch (PowerLoss &) {
+      lost = true;
+      losses++;
+    }
+    flash.set_power_budget(-1);
+    flash.set_fail_erases(0);
+    if (!lost && rng() % 1000 != 0)
+      continue;
+
+    reboots++;
+    delete journal;
+    image.assign(IMAGE_WORDS, 0xDEADBEEF);
+    journal = new PreferenceJournal(&flash, image.data(), IMAGE_WORDS);
+    if (!journal->load()) {
+      if (flushes > 0) {
+        printf("%u sectors: load failed after a power loss in step %d\n", sectors, step);
+        return 1;
+      }
+      image.assign(IMAGE_WORDS, 0);
+    }
+    for (const Preference &pref : prefs) {
+      if (!matches(image, flushed, pref) && !matches(image, written, pref)) {
+        printf("%u sectors: torn preference at offset %u after step %d\n", sectors, pref.offset, step);
+        return 1;
+      }
+    }
+    flushed = image;
+  }
+  delete journal;
+  if (!flash.sequence_ok()) {
+    printf("%u sectors: a sector header did not get the highest sequence number\n", sectors);
+    return 1;
+  }
+  printf("%u sectors: %ld flushes, %ld failed, %ld power losses, %ld reboots\n", sectors, flushes, failed, losses,
+         reboots);
+  return 0;
+}
+
+static int run_fallback() {
+  std::mt19937 rng(1);
+  HostFlash flash(3, &rng);
+  std::vector<uint32_t> image(IMAGE_WORDS, 0);
+  PreferenceJournal journal(&flash, image.data(), IMAGE_WORDS);
+  journal.load();
+  // two compactions, the second snapshot goes to sector 1
+  for (uint32_t value = 1; value <= 2; value++) {
+    std::vector<uint32_t> data(IMAGE_WORDS, value);
+    journal.write(0, data.data(), IMAGE_WORDS);
+    if (!journal.flush() || journal.get_active_sector() != int32_t(value - 1)) {
+      printf("fallback: flush %u failed\n", value);
+      return 1;
+    }
+    // fill the rest of the sector, so that the next flush compacts
+    if (value == 1) {
+      while (journal.get_free_words() >= 2 + IMAGE_WORDS) {
+        data[0] = value;
+        journal.write(0, data.data(), 1);
+        data[0] = ~value;
+        journal.write(0, data.data(), 1);
+        data[0] = value;
+        journal.write(0, data.data(), 1);
+        journal.flush();
+      }
+    }
+  }
+  const uint32_t sequence = journal.get_sequence();
+
+  // damage the snapshot of the newest sector, its header stays valid
+  flash.word(1, 3 + 2 + 5) ^= 1;
+  std::vector<uint32_t> loaded(IMAGE_WORDS, 0);
+  PreferenceJournal reloaded(&flash, loaded.data(), IMAGE_WORDS);
+  if (!reloaded.load() || reloaded.get_active_sector() != 0 || loaded[5] != 1) {
+    printf("fallback: did not fall back to the older sector\n");
+    return 1;
+  }
+  if (reloaded.get_sequence() != sequence) {
+    printf("fallback: sequence %u, expected %u\n", reloaded.get_sequence(), sequence);
+    return 1;
+  }
+  return 0;
+}
+
+static int run_tail_clean() {
+  std::mt19937 rng(1);
+  HostFlash flash(2, &rng);
+  std::vector<uint32_t> image(IMAGE_WORDS, 0);
+  PreferenceJournal journal(&flash, image.data(), IMAGE_WORDS);
+  journal.load();
+  uint32_t value = 7;
+  journal.write(0, &value, 1);
+  journal.flush();
+  const uint32_t end = SECTOR_WORDS - journal.get_free_words();
+
+  // a record torn before its header was written leaves data after the end of the log
+  flash.word(0, end + 10) = 0x12345678;
+  std::vector<uint32_t> loaded(IMAGE_WORDS, 0);
+  PreferenceJournal reloaded(&flash, loaded.data(), IMAGE_WORDS);
+  if (!reloaded.load() || loaded[0] != 7 || reloaded.get_free_words() != 0) {
+    printf("tail_clean: appending to a sector with garbage after the log\n");
+    return 1;
+  }
+  value = 8;
+  reloaded.write(0, &value, 1);
+  if (!reloaded.flush() || reloaded.get_active_sector() != 1 || reloaded.get_free_words() == 0) {
+    printf("tail_clean: flush did not compact into the next sector\n");
+    return 1;
+  }
+  std::vector<uint32_t> check(IMAGE_WORDS, 0);
+  PreferenceJournal again(&flash, check.data(), IMAGE_WORDS);
+  if (!again.load() || check[0] != 8) {
+    printf("tail_clean: the compacted sector lost the change\n");
+    return 1;
+  }
+  return 0;
+}
+
+int main() {
+  for (uint32_t sectors : {2, 4}) {
+    if (run_power_losses(sectors) != 0)
+      return 1;
+  }
+  if (run_fallback() != 0 || run_tail_clean() != 0)
+    return 1;
+  printf("fallback and tail checks passed\n");
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Host benchmark of the scheduler, built once per backend by script/host-test.
+//
+// Runs with a fake millis() clock: "set/cancel" re-arms named timeouts like binary sensor filters and
+// status_momentary_warning() do, "tick" runs call() for every ms with intervals and timeouts pending.
+
+#include "esphome/core/scheduler.h"
+#include "esphome/core/helpers.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static uint32_t g_millis = 0;
+uint32_t millis() { return g_millis; }
+uint32_t micros() { return g_millis * 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+int esp_log_printf_(int level, const char *tag, int line, const char *format, ...) { return 0; }
+uint32_t random_uint32() { return rand(); }
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= c;
+  }
+  return hash;
+}
+}  // namespace esphome
+
+using namespace esphome;
+
+static const int COMPONENTS = 16;
+static const int SET_CANCEL_ROUNDS = 200000;
+static const uint32_t TICK_MS = 1000000;
+
+template<typename F> static double measure_ns(int ops, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+int main() {
+  Scheduler scheduler;
+  Component components[COMPONENTS];
+  uint32_t runs = 0;
+
+  // Items that were not yet moved into the wheel by call() must still wake up the loop in time
+  scheduler.set_timeout(&components[0], fnv1_hash_static("first"), 100000, []() {});
+  scheduler.call();
+  scheduler.set_timeout(&components[0], fnv1_hash_static("pending"), 5, []() {});
+  auto next = scheduler.next_schedule_in();
+  if (!next.has_value() || *next > 5) {
+    printf("next_schedule_in() ignores the pending timeout\n");
+    return 1;
+  }
+  scheduler.cancel_timeout(&components[0], fnv1_hash_static("first"));
+  scheduler.cancel_timeout(&components[0], fnv1_hash_static("pending"));
+
+  double by_string = measure_ns(SET_CANCEL_ROUNDS * 2, [&]() {
+    for (int i = 0; i < SET_CANCEL_ROUNDS; i++) {
+      Component *c = &components[i % COMPONENTS];
+      scheduler.set_timeout(c, "ON_OFF", 100, [&runs]() { runs++; });
+      scheduler.cancel_timeout(c, "ON_OFF");
+      // Like the main loop, cancelled items of the heap scheduler are only cleaned up in call()
+      if (i % COMPONENTS == 0)
+        scheduler.call();
+    }
+  });
+  double by_hash = measure_ns(SET_CANCEL_ROUNDS * 2, [&]() {
+    for (int i = 0; i < SET_CANCEL_ROUNDS; i++) {
+      Component *c = &components[i % COMPONENTS];
+      scheduler.set_timeout(c, fnv1_hash_static("ON_OFF"), 100, [&runs]() { runs++; });
+      scheduler.cancel_timeout(c, fnv1_hash_static("ON_OFF"));
+      // Like the main loop, cancelled items of the heap scheduler are only cleaned up in call()
+      if (i % COMPONENTS == 0)
+        scheduler.call();
+    }
+  });
+
+  // A typical node: one update interval per component plus a debounce timeout that is re-armed all the time
+  for (int i = 0; i < COMPONENTS; i++)
+    scheduler.set_interval(&components[i], fnv1_hash_static("update"), 1000 + i * 250, [&runs]() { runs++; });
+  double tick = measure_ns(TICK_MS, [&]() {
+    for (uint32_t i = 0; i < TICK_MS; i++) {
+      g_millis++;
+      if (i % 7 == 0)
+        scheduler.set_timeout(&components[i % COMPONENTS], fnv1_hash_static("ON_OFF"), 50, [&runs]() { runs++; });
+      scheduler.call();
+    }
+  });
+
+  printf("set/cancel by name: %8.1f ns/op\n", by_string);
+  printf("set/cancel by hash: %8.1f ns/op\n", by_hash);
+  printf("call() per ms:      %8.1f ns (%u callbacks)\n", tick, runs);
+  return runs == 0;
+}
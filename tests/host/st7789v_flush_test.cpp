@@ -0,0 +1,301 @@
+// Host test of the ST7789V frame flush, built by script/host-test.
+//
+// The driver sends its frames through the real SPIDevice to a mocked hardware SPI bus, which emulates the panel's
+// memory. After every complete frame the panel must show the same as a reference display drawn without the driver,
+// for blocking, asynchronous and double buffered flushes. Only the changed window must be sent, but tiles must
+// be sent even if their contents differ in a way that gives the same 32-bit hash.
+
+#include "esphome/components/st7789v/st7789v.h"
+#include "esphome/core/application.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+EspClass ESP;
+
+namespace esphome {
+Application App;
+void Application::feed_wdt() {}
+int esp_log_printf_(int level, const char *tag, int line, const char *format, ...) { return 0; }
+
+// the pins only keep their level, the D/C pin tells the panel whether it receives a command or data
+GPIOPin::GPIOPin(uint8_t pin, uint8_t mode, bool inverted)
+    : pin_(pin), mode_(mode), inverted_(inverted), gpio_read_(nullptr), gpio_mask_(0) {}
+static bool g_dc = false;
+void GPIOPin::setup() {}
+bool GPIOPin::digital_read() { return g_dc; }
+void GPIOPin::digital_write(bool value) { g_dc = value; }
+void GPIOPin::pin_mode(uint8_t mode) {}
+uint8_t GPIOPin::get_pin() const { return this->pin_; }
+const char *GPIOPin::get_pin_mode_name() const { return ""; }
+bool GPIOPin::is_inverted() const { return this->inverted_; }
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::display;
+
+static const int WIDTH = 135;
+static const int HEIGHT = 240;
+/// The panel memory is 240x320, the visible part starts at [52,40].
+static const int PANEL_WIDTH = 240;
+static const int PANEL_HEIGHT = 320;
+static const int PANEL_X_OFFSET = 52;
+static const int PANEL_Y_OFFSET = 40;
+static const uint8_t CASET = 0x2A;
+static const uint8_t RASET = 0x2B;
+static const uint8_t RAMWR = 0x2C;
+
+/// The panel, written through the mocked hardware SPI bus.
+struct Panel {
+  std::vector<uint8_t> memory = std::vector<uint8_t>(PANEL_WIDTH * PANEL_HEIGHT * 2, 0xA5);
+  bool selected = false;
+  bool unbalanced = false;
+  uint8_t command = 0;
+  uint8_t args[4];
+  int arg_count = 0;
+  int column_start = 0, column_end = 0, row_start = 0, row_end = 0;
+  int column = 0, row = 0, byte = 0;
+  long pixel_bytes = 0;
+
+  void receive(uint8_t value) {
+    if (!this->selected)
+      return;  // for another device on the bus
+    if (!g_dc) {
+      this->command = value;
+      this->arg_count = 0;
+      return;
+    }
+    if (this->command == CASET || this->command == RASET) {
+      if (this->arg_count < 4)
+        this->args[this->arg_count++] = value;
+      if (this->arg_count == 4) {
+        const int start = this->args[0] << 8 | this->args[1], end = this->args[2] << 8 | this->args[3];
+        if (this->command == CASET) {
+          this->column_start = this->column = start;
+          this->column_end = end;
+        } else {
+          this->row_start = this->row = start;
+          this->row_end = end;
+        }
+        this->byte = 0;
+      }
+      return;
+    }
+    if (this->command != RAMWR)
+      return;
+    this->memory[(this->row * PANEL_WIDTH + this->column) * 2 + this->byte] = value;
+    this->pixel_bytes++;
+    if (++this->byte < 2)
+      return;
+    this->byte = 0;
+    if (++this->column <= this->column_end)
+      return;
+    this->column = this->column_start;
+    if (++this->row > this->row_end)
+      this->row = this->row_start;
+  }
+};
+static Panel g_panel;
+static long g_bus_bytes = 0;
+
+SPIClass SPI;
+void SPIClass::beginTransaction(SPISettings settings) {
+  g_panel.unbalanced |= g_panel.selected;
+  g_panel.selected = true;
+}
+void SPIClass::endTransaction() {
+  g_panel.unbalanced |= !g_panel.selected;
+  g_panel.selected = false;
+}
+uint8_t SPIClass::transfer(uint8_t data) {
+  this->write(data);
+  return 0;
+}
+void SPIClass::transfer(uint8_t *data, uint32_t size) { this->writeBytes(data, size); }
+void SPIClass::write(uint8_t data) {
+  g_bus_bytes++;
+  g_panel.receive(data);
+}
+void SPIClass::writeBytes(uint8_t *data, uint32_t size) {
+  for (uint32_t i = 0; i < size; i++)
+    this->write(data[i]);
+}
+
+class HostSPI : public spi::SPIComponent {
+ public:
+  HostSPI() { this->hw_spi_ = &SPI; }
+};
+
+class TestST7789V : public st7789v::ST7789V {
+ public:
+  void init() { this->init_internal_(this->get_buffer_length_()); }
+  bool is_frame_pending() const { return this->frame_pending_; }
+};
+
+/// Draws like the driver, into an RGB565 buffer of the same layout.
+class ReferenceDisplay : public DisplayBuffer {
+ public:
+  ReferenceDisplay() { this->buffer_ = new uint8_t[WIDTH * HEIGHT * 2](); }
+  ~ReferenceDisplay() { delete[] this->buffer_; }
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+  const uint8_t *get_buffer() const { return this->buffer_; }
+  using DisplayBuffer::do_update_;
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x >= WIDTH || x < 0 || y >= HEIGHT || y < 0)
+      return;
+    const uint16_t color565 = color.to_rgb_565();
+    this->buffer_[(x + y * WIDTH) * 2] = color565 >> 8;
+    this->buffer_[(x + y * WIDTH) * 2 + 1] = color565;
+  }
+};
+
+/// Two sets of the first three pixels of a tile, the rest of the tile the same, with the same 32-bit FNV-1a hash.
+static const uint16_t COLLIDING_PIXELS[2][3] = {{0xC0CA, 0x086B, 0x07B8}, {0x7F4F, 0x269B, 0x97BE}};
+/// Which set of COLLIDING_PIXELS the scene draws at [0,0], none if negative.
+static int g_colliding = -1;
+
+/// A dashboard like frame: mostly the same as the previous one, sometimes with larger changes.
+static void draw_scene(DisplayBuffer &it, int frame, uint32_t seed) {
+  const int width = it.get_width(), height = it.get_height();
+  it.filled_rectangle(0, 0, width, height / 4, Color(0, 0, 255));
+  it.rectangle(2, 2, width - 4, height - 4);
+  it.filled_rectangle(width / 2, height / 2, 3 + frame % 10, 5, Color(255, 255, 0));
+  if (g_colliding >= 0) {
+    for (int x = 0; x < 3; x++) {
+      const uint16_t color565 = COLLIDING_PIXELS[g_colliding][x];
+      it.draw_pixel_at(x, 0, Color((color565 & 0xF800) << 8 | (color565 & 0x07E0) << 5 | (color565 & 0x1F) << 3));
+    }
+  }
+  if (seed % 3 != 0)
+    return;
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> x(-10, width + 10), y(-10, height + 10), size(0, 60);
+  for (int i = 0; i < 10; i++)
+    it.filled_rectangle(x(rng), y(rng), size(rng), size(rng), Color(rng() & 255, rng() & 255, rng() & 255));
+}
+
+static bool panel_matches(const ReferenceDisplay &reference) {
+  for (int y = 0; y < HEIGHT; y++) {
+    const uint8_t *panel = &g_panel.memory[((y + PANEL_Y_OFFSET) * PANEL_WIDTH + PANEL_X_OFFSET) * 2];
+    if (memcmp(panel, reference.get_buffer() + y * WIDTH * 2, WIDTH * 2) != 0)
+      return false;
+  }
+  return true;
+}
+
+static int run(bool async_flush, bool double_buffer, const char *name) {
+  g_panel = Panel();
+  HostSPI bus;
+  GPIOPin dc_pin(0, 0);
+  TestST7789V display;
+  display.set_spi_parent(&bus);
+  display.set_dc_pin(&dc_pin);
+  display.set_async_flush(async_flush);
+  display.set_double_buffer(double_buffer);
+  display.init();
+  ReferenceDisplay reference;
+  int frame = 0;
+  uint32_t seed = 0;
+  display.set_writer([&](DisplayBuffer &it) { draw_scene(it, frame, seed); });
+  reference.set_writer([&](DisplayBuffer &it) { draw_scene(it, frame, seed); });
+
+  std::mt19937 rng(7);
+  long max_update = 0, max_loop = 0, idle_checks = 0, overlapped = 0;
+  for (frame = 0; frame < 400; frame++) {
+    seed = rng();
+    overlapped += display.is_flushing();
+    long before = g_bus_bytes;
+    display.update();
+    reference.do_update_();
+    max_update = std::max(max_update, g_bus_bytes - before);
+    const int loops = rng() % 50;
+    for (int i = 0; i < loops; i++) {
+      // another device uses the bus between the loop() iterations
+      g_dc = rng() & 1;
+      SPI.write(rng());
+      before = g_bus_bytes;
+      display.loop();
+      max_loop = std::max(max_loop, g_bus_bytes - before);
+      if (g_panel.selected || g_panel.unbalanced) {
+        printf("%s: unbalanced enable()/disable() in frame %d\n", name, frame);
+        return 1;
+      }
+      if (display.is_flushing())
+        continue;
+      if (display.is_frame_pending()) {
+        printf("%s: frame pending while idle in frame %d\n", name, frame);
+        return 1;
+      }
+      if (HighFrequencyLoopRequester::is_high_frequency()) {
+        printf("%s: high frequency loop still requested in frame %d\n", name, frame);
+        return 1;
+      }
+      if (!panel_matches(reference)) {
+        printf("%s: panel differs after frame %d\n", name, frame);
+        return 1;
+      }
+      idle_checks++;
+    }
+  }
+  display.finish_flush();
+  if (!panel_matches(reference)) {
+    printf("%s: panel differs after the last frame\n", name);
+    return 1;
+  }
+
+  // without changes nothing is sent, a small change only sends its window
+  seed = 1;
+  frame = 0;
+  display.update();
+  display.finish_flush();
+  reference.do_update_();
+  const long before = g_panel.pixel_bytes;
+  display.update();
+  display.finish_flush();
+  if (g_panel.pixel_bytes != before) {
+    printf("%s: unchanged frame sent %ld bytes\n", name, g_panel.pixel_bytes - before);
+    return 1;
+  }
+  frame = 1;
+  display.update();
+  display.finish_flush();
+  reference.do_update_();
+  if (g_panel.pixel_bytes - before > 16 * 16 * 2 || !panel_matches(reference)) {
+    printf("%s: small change sent %ld bytes\n", name, g_panel.pixel_bytes - before);
+    return 1;
+  }
+
+  // tiles whose contents only differ in a way that a weaker hash misses are still sent
+  for (g_colliding = 0; g_colliding < 2; g_colliding++) {
+    display.update();
+    display.finish_flush();
+    reference.do_update_();
+    if (!panel_matches(reference)) {
+      printf("%s: tile with colliding contents %d not sent\n", name, g_colliding);
+      return 1;
+    }
+  }
+  g_colliding = -1;
+
+  printf("%-13s %ld idle checks, %ld updates during a flush, max bytes per update() %ld, per loop() %ld\n", name,
+         idle_checks, overlapped, max_update, max_loop);
+  return 0;
+}
+
+int main() {
+  if (run(false, false, "blocking") != 0)
+    return 1;
+  if (run(true, false, "async") != 0)
+    return 1;
+  if (run(true, true, "async+double") != 0)
+    return 1;
+  return 0;
+}
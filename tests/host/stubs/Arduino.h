@@ -0,0 +1,39 @@
+#pragma once
+
+// Minimal host replacement of the Arduino core, just enough to compile the esphome core sources
+// used by the host tests in tests/host with the system compiler.
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using std::isinf;
+using std::isnan;
+
+#define ICACHE_RAM_ATTR
+#define ICACHE_RODATA_ATTR
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t *>(addr))
+
+#define F_CPU 80000000L
+
+typedef uint8_t byte;
+
+/// A newlib extension the sensor filters use.
+inline float pow10f(float x) { return powf(10.0f, x); }
+
+/// Implemented by each test, usually as a fake clock the test advances itself.
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void yield();
+
+/// The cycle counter follows the fake micros() of the test, ESP is defined by the tests that use it.
+class EspClass {
+ public:
+  uint32_t getCycleCount() { return micros() * (F_CPU / 1000000L); }
+};
+extern EspClass ESP;
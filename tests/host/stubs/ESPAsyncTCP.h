@@ -0,0 +1,70 @@
+#pragma once
+
+// Host replacement of ESPAsyncTCP. The test delivers the received data with AsyncClient::receive() and finds the
+// sent data in AsyncClient::sent.
+
+#include "IPAddress.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AsyncClient {
+ public:
+  typedef void (*AcErrorHandler)(void *arg, AsyncClient *client, int8_t error);
+  typedef void (*AcConnectHandler)(void *arg, AsyncClient *client);
+  typedef void (*AcTimeoutHandler)(void *arg, AsyncClient *client, uint32_t time);
+  typedef void (*AcDataHandler)(void *arg, AsyncClient *client, void *data, size_t len);
+
+  void onError(AcErrorHandler cb, void *arg) {}
+  void onDisconnect(AcConnectHandler cb, void *arg) {}
+  void onTimeout(AcTimeoutHandler cb, void *arg) {}
+  void onData(AcDataHandler cb, void *arg) {
+    this->data_cb_ = cb;
+    this->data_arg_ = arg;
+  }
+  /// Deliver received data like the TCP stack.
+  void receive(const uint8_t *data, size_t len) {
+    this->ack_later = false;
+    this->data_cb_(this->data_arg_, this, const_cast<uint8_t *>(data), len);
+    // without ackLater() the stack acknowledges the data once the callback returns
+    if (!this->ack_later)
+      this->acked += len;
+  }
+
+  IPAddress remoteIP() const { return {}; }
+  size_t space() const { return 1 << 16; }
+  size_t add(const char *data, size_t size) {
+    this->sent.insert(this->sent.end(), data, data + size);
+    return size;
+  }
+  bool send() { return true; }
+  void ackLater() { this->ack_later = true; }
+  size_t ack(size_t len) {
+    this->acked += len;
+    this->late_acks++;
+    return len;
+  }
+  void close(bool now = false) { this->closed = true; }
+  bool disconnected() const { return this->closed; }
+
+  std::vector<uint8_t> sent;
+  size_t acked = 0;
+  /// The number of ack() calls, for data that went through the backlog.
+  size_t late_acks = 0;
+  bool ack_later = false;
+  bool closed = false;
+
+ protected:
+  AcDataHandler data_cb_{nullptr};
+  void *data_arg_{nullptr};
+};
+
+class AsyncServer {
+ public:
+  typedef void (*AcConnectHandler)(void *arg, AsyncClient *client);
+
+  explicit AsyncServer(uint16_t port) {}
+  void setNoDelay(bool nodelay) {}
+  void begin() {}
+  void onClient(AcConnectHandler cb, void *arg) {}
+};
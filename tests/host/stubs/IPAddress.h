@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class IPAddress {
+ public:
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address_(a | b << 8 | c << 16 | uint32_t(d) << 24) {}
+  operator uint32_t() const { return this->address_; }
+  std::string toString() const { return "127.0.0.1"; }
+
+ protected:
+  uint32_t address_{0};
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+// Host replacement of the Arduino SPI library, the transfers are implemented by each test that uses it.
+
+#include <cstdint>
+
+class SPISettings {
+ public:
+  SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode) {}
+};
+
+class SPIClass {
+ public:
+  void pins(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) {}
+  void begin() {}
+  void beginTransaction(SPISettings settings);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+  void transfer(uint8_t *data, uint32_t size);
+  void write(uint8_t data);
+  void writeBytes(uint8_t *data, uint32_t size);
+};
+
+extern SPIClass SPI;
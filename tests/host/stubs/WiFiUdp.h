@@ -0,0 +1,49 @@
+#pragma once
+
+// UDP sockets that receive the datagrams a test queued with host_udp_receive().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+struct HostUDPQueue {
+  const std::vector<std::vector<uint8_t>> *datagrams{nullptr};
+  size_t next{0};
+};
+inline HostUDPQueue &host_udp_queue() {
+  static HostUDPQueue queue;
+  return queue;
+}
+/// Every socket receives these datagrams in order, they must outlive the reads.
+inline void host_udp_receive(const std::vector<std::vector<uint8_t>> *datagrams) {
+  host_udp_queue().datagrams = datagrams;
+  host_udp_queue().next = 0;
+}
+
+class UDP {
+ public:
+  virtual ~UDP() = default;
+  uint8_t begin(uint16_t port) { return 1; }
+  void stop() {}
+  int parsePacket() {
+    HostUDPQueue &queue = host_udp_queue();
+    if (queue.datagrams == nullptr || queue.next >= queue.datagrams->size())
+      return 0;
+    this->current_ = &(*queue.datagrams)[queue.next++];
+    return this->current_->size();
+  }
+  int read(uint8_t *buffer, size_t len) {
+    if (this->current_ == nullptr)
+      return 0;
+    if (len > this->current_->size())
+      len = this->current_->size();
+    memcpy(buffer, this->current_->data(), len);
+    return len;
+  }
+
+ protected:
+  const std::vector<uint8_t> *current_{nullptr};
+};
+
+class WiFiUDP : public UDP {};
@@ -0,0 +1,68 @@
+// Host versions of the Component and HighFrequencyLoopRequester methods the tests in tests/host link against,
+// without pulling in esphome/core/component.cpp, esphome/core/helpers.cpp and the whole Application they depend on.
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+namespace setup_priority {
+
+const float BUS = 1000.0f;
+const float IO = 900.0f;
+const float HARDWARE = 800.0f;
+const float DATA = 600.0f;
+const float PROCESSOR = 400.0;
+const float WIFI = 250.0f;
+const float AFTER_WIFI = 200.0f;
+const float AFTER_CONNECTION = 100.0f;
+const float LATE = -100.0f;
+
+}  // namespace setup_priority
+
+void Component::setup() {}
+void Component::loop() {}
+void Component::dump_config() {}
+float Component::get_setup_priority() const { return 0.0f; }
+float Component::get_loop_priority() const { return 0.0f; }
+void Component::call_loop() { this->loop(); }
+void Component::call_setup() { this->setup(); }
+void Component::mark_failed() {}
+bool Component::is_failed() { return false; }
+bool Component::can_proceed() { return true; }
+void Component::enable_loop() { this->loop_disabled_ = false; }
+void Component::status_set_warning() {}
+void Component::status_clear_warning() {}
+// the tests that need the scheduler link esphome/core/scheduler.cpp and drive it themselves
+void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {}  // NOLINT
+void Component::set_timeout(uint32_t name_hash, uint32_t timeout, std::function<void()> &&f) {}  // NOLINT
+bool Component::cancel_timeout(uint32_t name_hash) { return false; }  // NOLINT
+void Component::set_interval(uint32_t name_hash, uint32_t interval, std::function<void()> &&f) {}  // NOLINT
+
+PollingComponent::PollingComponent(uint32_t update_interval) : Component(), update_interval_(update_interval) {}
+// the tests call update() themselves instead of registering the interval
+void PollingComponent::call_setup() { this->setup(); }
+uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
+void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+
+// the object id would need esphome/core/helpers.cpp, no test uses it
+Nameable::Nameable(const std::string &name) : name_(name) {}
+const std::string &Nameable::get_object_id() { return this->object_id_; }
+
+static int high_freq_num_requests = 0;
+
+void HighFrequencyLoopRequester::start() {
+  if (this->started_)
+    return;
+  high_freq_num_requests++;
+  this->started_ = true;
+}
+void HighFrequencyLoopRequester::stop() {
+  if (!this->started_)
+    return;
+  high_freq_num_requests--;
+  this->started_ = false;
+}
+bool HighFrequencyLoopRequester::is_high_frequency() { return high_freq_num_requests > 0; }
+
+}  // namespace esphome
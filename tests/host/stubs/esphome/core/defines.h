@@ -0,0 +1,4 @@
+#pragma once
+// Host replacement of the generated defines, the host tests are built without the optional integrations.
+
+#define USE_COMPONENT_PROFILER
@@ -0,0 +1,23 @@
+#pragma once
+
+// IGMP that only counts the joins of every multicast group, like lwIP does.
+
+#include <map>
+#include "lwip/ip_addr.h"
+
+inline std::map<uint32_t, int> &host_igmp_groups() {
+  static std::map<uint32_t, int> groups;
+  return groups;
+}
+inline int igmp_joingroup(const ip4_addr_t *interface, const ip4_addr_t *group) {
+  host_igmp_groups()[group->addr]++;
+  return 0;
+}
+inline int igmp_leavegroup(const ip4_addr_t *interface, const ip4_addr_t *group) {
+  int &joins = host_igmp_groups()[group->addr];
+  if (joins == 0)
+    return -1;
+  if (--joins == 0)
+    host_igmp_groups().erase(group->addr);
+  return 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// like lwIP, this also declares htons() and htonl()
+#include <arpa/inet.h>
+#include <cstdint>
+
+typedef struct {
+  uint32_t addr;
+} ip4_addr_t;
+
+static const ip4_addr_t HOST_IP4_ANY = {0};
+#define IP4_ADDR_ANY4 (&HOST_IP4_ANY)
@@ -0,0 +1,133 @@
+// Host benchmark of text rendering, built by script/host-test.
+//
+// Draws and measures a few dashboard strings with an ASCII font, like a display redrawing its text on every
+// update. Also checks Font::measure() against an uncached reference, including two strings of the same length
+// with the same hash.
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/application.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+
+namespace esphome {
+Application App;
+void Application::feed_wdt() {}
+int esp_log_printf_(int level, const char *tag, int line, const char *format, ...) { return 0; }
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::display;
+
+static const int ITERATIONS = 20000;
+static const int FONT_HEIGHT = 14;
+
+/// A display with an RGB565 buffer in RAM.
+class HostDisplay : public DisplayBuffer {
+ public:
+  HostDisplay(int width, int height) : width_(width), height_(height) {
+    this->buffer_ = new uint8_t[width * height * 2]();
+  }
+  ~HostDisplay() { delete[] this->buffer_; }
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x >= this->width_ || x < 0 || y >= this->height_ || y < 0)
+      return;
+    const uint16_t color565 = color.to_rgb_565();
+    this->buffer_[(x + y * this->width_) * 2] = color565 >> 8;
+    this->buffer_[(x + y * this->width_) * 2 + 1] = color565;
+  }
+
+  int width_;
+  int height_;
+};
+
+/// The glyph widths differ, so that strings of the same length usually have different widths.
+static int glyph_width(char c) { return 3 + c % 7; }
+
+/// Font::measure() without the cache, all glyphs have offset_x 0.
+static int reference_width(const char *str) {
+  int width = 0;
+  for (; *str != '\0'; str++)
+    width += glyph_width(*str);
+  return width;
+}
+
+template<typename F> static double measure_us(int ops, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / ops;
+}
+
+int main() {
+  // all printable ASCII characters, with a glyph table like the font codegen emits
+  static std::string chars[95];
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> offsets;
+  std::mt19937 rng(1);
+  for (int i = 0; i < 95; i++) {
+    chars[i] = std::string(1, char(' ' + i));
+    offsets.push_back(data.size());
+    for (int j = 0; j < FONT_HEIGHT * ((glyph_width(chars[i][0]) + 7) / 8); j++)
+      data.push_back(rng());
+  }
+  std::vector<Glyph> glyphs;
+  std::vector<uint16_t> table;
+  for (int i = 0; i < 95; i++) {
+    glyphs.emplace_back(chars[i].c_str(), data.data(), offsets[i], 0, 2, glyph_width(chars[i][0]), FONT_HEIGHT);
+    table.push_back(i + 1);
+  }
+  Font font(std::move(glyphs), FONT_HEIGHT, FONT_HEIGHT + 4);
+  font.set_glyph_table(' ', table.data(), table.size());
+
+  // "HChGb1jg" and "UdSXZZBv" have the same FNV-1a hash
+  const char *checks[] = {"HChGb1jg", "UdSXZZBv", "HChGb1jg", "12:34", "12:35", "", "UdSXZZBv"};
+  if (reference_width(checks[0]) == reference_width(checks[1])) {
+    printf("the colliding strings must have different widths\n");
+    return 1;
+  }
+  for (const char *str : checks) {
+    int width, x_offset, baseline, height;
+    font.measure(str, &width, &x_offset, &baseline, &height);
+    if (width != reference_width(str) || x_offset != 0) {
+      printf("measure(\"%s\") = %d, expected %d\n", str, width, reference_width(str));
+      return 1;
+    }
+  }
+
+  HostDisplay display(240, 135);
+  const char *strs[] = {"Temperature: 21.5 C", "12:34:56", "Humidity 45 %", "Living room", "Power 1234.5 W"};
+  const double print_us = measure_us(ITERATIONS * 10, [&]() {
+    for (int i = 0; i < ITERATIONS; i++) {
+      for (int s = 0; s < 5; s++) {
+        display.print(2, 5 + s * 25, &font, Color(0xFFFFFF), TextAlign::TOP_LEFT, strs[s]);
+        display.print(120, 5 + s * 25, &font, Color(0x00FF00), TextAlign::CENTER, strs[s]);
+      }
+    }
+  });
+  long sum = 0;
+  const double bounds_us = measure_us(ITERATIONS * 5, [&]() {
+    for (int i = 0; i < ITERATIONS; i++) {
+      for (int s = 0; s < 5; s++) {
+        int x1, y1, width, height;
+        display.get_text_bounds(120, 20, strs[s], &font, TextAlign::CENTER, &x1, &y1, &width, &height);
+        sum += x1 + width;
+      }
+    }
+  });
+
+  printf("print():           %.3f us/string\n", print_us);
+  printf("get_text_bounds(): %.3f us/string (%ld)\n", bounds_us, sum);
+  return 0;
+}
@@ -0,0 +1,99 @@
+import struct
+
+import pytest
+
+from esphome.api import log_format
+
+
+@pytest.mark.parametrize("text, expected", (
+    ('ESP_LOGD(TAG, "Hello");', {"Hello"}),
+    ('ESP_LOGCONFIG(TAG, "  Pin: %u", this->pin_);', {"  Pin: %u"}),
+    ('ESP_LOGW(TAG, "Part 1 "\n         "part 2: %d", x);', {"Part 1 part 2: %d"}),
+    ('ESP_LOGVV(TAG, "Tab\\t\\"quoted\\"\\x41");', {'Tab\t"quoted"A'}),
+    ('ESP_LOGD(TAG, "One"); ESP_LOGI(TAG, "Two %s", s);', {"One", "Two %s"}),
+    # Formats that are not plain string literals can't be collected
+    ('ESP_LOGD(TAG, format, x);', set()),
+    ('ESP_LOGD(TAG, "Prefix" SUFFIX_MACRO, x);', set()),
+    ('ESP_LOGD(TAG, "%s", "not a format");', {"%s"}),
+))
+def test_extract_log_formats(text, expected):
+    actual = log_format.extract_log_formats(text)
+
+    assert actual == expected
+
+
+@pytest.mark.parametrize("data, expected", (
+    (b"", 0x811C9DC5),
+    (b"a", 0x050C5D7E),
+    (b"foobar", 0x31F0B262),
+))
+def test_fnv1_hash(data, expected):
+    actual = log_format.fnv1_hash(data)
+
+    assert actual == expected
+
+
+def _int(value):
+    return struct.pack('<i', value)
+
+
+@pytest.mark.parametrize("format_, args, expected", (
+    ("No arguments", b"", "No arguments"),
+    ("100%%", b"", "100%"),
+    ("Value: %d", _int(-42), "Value: -42"),
+    ("Value: %u", _int(-1), "Value: 4294967295"),
+    ("Hex: %02X %08x", _int(10) + _int(255), "Hex: 0A 000000ff"),
+    ("Width: %*d|", _int(5) + _int(42), "Width:    42|"),
+    ("Short: %hhd %hu", _int(511) + _int(-1), "Short: -1 65535"),
+    ("Long long: %lld", struct.pack('<q', -(1 << 40)), "Long long: -1099511627776"),
+    ("Float: %.2f", struct.pack('<d', 3.14159), "Float: 3.14"),
+    ("String: '%s' '%5s'", b"abc\0de\0", "String: 'abc' '   de'"),
+    ("Char: %c", _int(ord('x')), "Char: x"),
+    ("Pointer: %p", _int(0x3FFB0000), "Pointer: 0x3ffb0000"),
+    ("Truncated: %d %d", _int(1), "Truncated: 1 <truncated>"),
+    ("Unsupported: %Lf %d", b"", "Unsupported: %Lf %d"),
+))
+def test_format_packed(format_, args, expected):
+    actual = log_format.format_packed(format_, args)
+
+    assert actual == expected
+
+
+def test_log_format_table():
+    table = log_format.LogFormatTable({"b %d", "a", "c %s"})
+
+    assert table.hashes == sorted(table.hashes)
+    assert sorted(table.formats) == ["a", "b %d", "c %s"]
+    assert table.table_hash == log_format.fnv1_hash(b"\0".join(f.encode() for f in table.formats))
+
+    format_id = table.formats.index("b %d")
+    assert table.decode(format_id, _int(7)) == "b 7"
+    assert table.decode(len(table.formats), b"") == f"<unknown log format {len(table.formats)}>"
+
+
+def test_log_format_table__collision():
+    # Both formats hash to 0xDA35C702, the device could not tell them apart
+    assert log_format.fnv1_hash(b"Value 15359: %d") == log_format.fnv1_hash(b"Value 1036762: %d")
+
+    table = log_format.LogFormatTable({"Value 15359: %d", "Value 1036762: %d", "Other"})
+
+    assert table.formats == ["Other"]
+
+
+def test_log_format_table__save_load(tmp_path):
+    path = tmp_path / log_format.TABLE_FILENAME
+    table = log_format.LogFormatTable({"Temperature: %.1f\xc2\xb0C", "Hello"})
+
+    table.save(str(path))
+    actual = log_format.LogFormatTable.load(str(path))
+
+    assert actual.formats == table.formats
+    assert actual.table_hash == table.table_hash
+    assert actual.decode(actual.formats.index("Temperature: %.1f\xc2\xb0C"), struct.pack('<d', 21.5)) == \
+        "Temperature: 21.5°C"
+
+
+def test_log_format_table__load_missing(tmp_path):
+    actual = log_format.LogFormatTable.load(str(tmp_path / "missing.json"))
+
+    assert actual is None
@@ -0,0 +1,19 @@
+import pytest
+
+from esphome.components import font
+
+
+@pytest.mark.parametrize("glyphs, expected", (
+    ([], (0, [])),
+    (["A", "C"], (65, [1, 0, 2])),
+    # Several glyphs start with "e", which one matches depends on the following code points
+    (["e", "e\u0301", "f"], (101, [font.GLYPH_TABLE_SEARCH, 3])),
+    (["e\u0301", "f"], (101, [font.GLYPH_TABLE_SEARCH, 2])),
+    (["0", "°"], (48, [1] + [0] * 127 + [2])),
+    # Code points too far above the first one are found by binary search
+    (["A", "€"], (65, [1] + [0] * (font.GLYPH_TABLE_MAX_SIZE - 1))),
+))
+def test_build_glyph_table(glyphs, expected):
+    actual = font.build_glyph_table(font.validate_glyphs(glyphs))
+
+    assert actual == expected